@@ -0,0 +1,131 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "dsp/chore/fast_db.hpp"
+
+namespace {
+    namespace hn = hwy::HWY_NAMESPACE;
+    using zldsp::chore::fast_db::Precision;
+
+    // the same points as the error-bound tests, i.e., -160 dB to +60 dB
+    constexpr double kMinDecibels = -160.0;
+    constexpr double kMaxDecibels = 60.0;
+    constexpr size_t kPointNum = 1 << 16;
+
+    std::vector<float> getDecibels() {
+        std::vector<float> db(kPointNum);
+        for (size_t i = 0; i < kPointNum; ++i) {
+            db[i] = static_cast<float>(kMinDecibels + (kMaxDecibels - kMinDecibels) *
+                                       static_cast<double>(i) / static_cast<double>(kPointNum - 1));
+        }
+        return db;
+    }
+
+    std::vector<float> getGains() {
+        auto gains = getDecibels();
+        for (auto& x : gains) {
+            x = static_cast<float>(std::pow(10.0, static_cast<double>(x) / 20.0));
+        }
+        return gains;
+    }
+}
+
+TEST_CASE("fast_db benchmarks", "[benchmark]") {
+    static constexpr hn::ScalableTag<float> d;
+    static constexpr size_t lanes = hn::MaxLanes(d);
+    const auto gains = getGains();
+    const auto decibels = getDecibels();
+    std::vector<float> out(kPointNum);
+
+    BENCHMARK("gain to dB, std::log10") {
+        for (size_t i = 0; i < kPointNum; ++i) {
+            out[i] = 20.f * std::log10(std::max(gains[i], 1e-12f));
+        }
+        return out[kPointNum / 2];
+    };
+    BENCHMARK("gain to dB, milli-decibel scalar") {
+        for (size_t i = 0; i < kPointNum; ++i) {
+            out[i] = zldsp::chore::fast_db::gainToDecibels<Precision::kMilliDecibel>(gains[i]);
+        }
+        return out[kPointNum / 2];
+    };
+    BENCHMARK("gain to dB, centi-decibel scalar") {
+        for (size_t i = 0; i < kPointNum; ++i) {
+            out[i] = zldsp::chore::fast_db::gainToDecibels<Precision::kCentiDecibel>(gains[i]);
+        }
+        return out[kPointNum / 2];
+    };
+    BENCHMARK("gain to dB, exact SIMD") {
+        for (size_t i = 0; i < kPointNum; i += lanes) {
+            hn::StoreU(zldsp::chore::fast_db::gainToDecibels<Precision::kExact>(d, hn::LoadU(d, gains.data() + i)),
+                       d, out.data() + i);
+        }
+        return out[kPointNum / 2];
+    };
+    BENCHMARK("gain to dB, milli-decibel SIMD") {
+        for (size_t i = 0; i < kPointNum; i += lanes) {
+            hn::StoreU(zldsp::chore::fast_db::gainToDecibels<Precision::kMilliDecibel>(
+                           d, hn::LoadU(d, gains.data() + i)), d, out.data() + i);
+        }
+        return out[kPointNum / 2];
+    };
+    BENCHMARK("gain to dB, centi-decibel SIMD") {
+        for (size_t i = 0; i < kPointNum; i += lanes) {
+            hn::StoreU(zldsp::chore::fast_db::gainToDecibels<Precision::kCentiDecibel>(
+                           d, hn::LoadU(d, gains.data() + i)), d, out.data() + i);
+        }
+        return out[kPointNum / 2];
+    };
+
+    BENCHMARK("dB to gain, std::pow") {
+        for (size_t i = 0; i < kPointNum; ++i) {
+            out[i] = std::pow(10.f, decibels[i] * 0.05f);
+        }
+        return out[kPointNum / 2];
+    };
+    BENCHMARK("dB to gain, milli-decibel scalar") {
+        for (size_t i = 0; i < kPointNum; ++i) {
+            out[i] = zldsp::chore::fast_db::decibelsToGain<Precision::kMilliDecibel>(decibels[i]);
+        }
+        return out[kPointNum / 2];
+    };
+    BENCHMARK("dB to gain, centi-decibel scalar") {
+        for (size_t i = 0; i < kPointNum; ++i) {
+            out[i] = zldsp::chore::fast_db::decibelsToGain<Precision::kCentiDecibel>(decibels[i]);
+        }
+        return out[kPointNum / 2];
+    };
+    BENCHMARK("dB to gain, exact SIMD") {
+        for (size_t i = 0; i < kPointNum; i += lanes) {
+            hn::StoreU(zldsp::chore::fast_db::decibelsToGain<Precision::kExact>(
+                           d, hn::LoadU(d, decibels.data() + i)), d, out.data() + i);
+        }
+        return out[kPointNum / 2];
+    };
+    BENCHMARK("dB to gain, milli-decibel SIMD") {
+        for (size_t i = 0; i < kPointNum; i += lanes) {
+            hn::StoreU(zldsp::chore::fast_db::decibelsToGain<Precision::kMilliDecibel>(
+                           d, hn::LoadU(d, decibels.data() + i)), d, out.data() + i);
+        }
+        return out[kPointNum / 2];
+    };
+    BENCHMARK("dB to gain, centi-decibel SIMD") {
+        for (size_t i = 0; i < kPointNum; i += lanes) {
+            hn::StoreU(zldsp::chore::fast_db::decibelsToGain<Precision::kCentiDecibel>(
+                           d, hn::LoadU(d, decibels.data() + i)), d, out.data() + i);
+        }
+        return out[kPointNum / 2];
+    };
+}
@@ -0,0 +1,37 @@
+# Prints the code size of the fully specialised compressor kernels in a linked binary
+# usage: cmake -DNM=<nm> -DLIBRARY=<binary> [-DPATTERN=<regex>] -P KernelSizeReport.cmake
+
+if (NOT PATTERN)
+    set(PATTERN "processDetectorKernel<|processStyle<|processStereo<")
+endif ()
+
+execute_process(COMMAND "${NM}" --demangle --print-size --size-sort "${LIBRARY}"
+        OUTPUT_VARIABLE NM_OUTPUT
+        ERROR_QUIET
+        RESULT_VARIABLE NM_RESULT)
+if (NOT NM_RESULT EQUAL 0)
+    message(WARNING "cannot read the symbols of ${LIBRARY}")
+    return()
+endif ()
+
+# escape list separators before splitting the output into lines
+string(REPLACE ";" "\;" NM_OUTPUT "${NM_OUTPUT}")
+string(REPLACE "\n" ";" NM_LINES "${NM_OUTPUT}")
+set(TOTAL_SIZE 0)
+set(SYMBOL_NUM 0)
+foreach (LINE IN LISTS NM_LINES)
+    if (LINE MATCHES "^[0-9a-fA-F]+ ([0-9a-fA-F]+) [tTwW] (.*)$")
+        set(SIZE_HEX "${CMAKE_MATCH_1}")
+        set(NAME "${CMAKE_MATCH_2}")
+        if (NAME MATCHES "${PATTERN}")
+            math(EXPR SIZE "0x${SIZE_HEX}")
+            math(EXPR TOTAL_SIZE "${TOTAL_SIZE} + ${SIZE}")
+            math(EXPR SYMBOL_NUM "${SYMBOL_NUM} + 1")
+            message(STATUS "${SIZE}\t${NAME}")
+        endif ()
+    endif ()
+endforeach ()
+message(STATUS "${SYMBOL_NUM} kernel symbols, ${TOTAL_SIZE} bytes in total")
+if (SYMBOL_NUM EQUAL 0)
+    message(WARNING "no kernel symbols in ${LIBRARY}, it may be stripped or hold LTO bitcode only")
+endif ()
@@ -34,8 +34,8 @@ target_include_directories(Tests PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/source)
 # Copy over compile definitions from our plugin target so it has all the JUCEy goodness
 target_compile_definitions(Tests PRIVATE $<TARGET_PROPERTY:${PROJECT_NAME},COMPILE_DEFINITIONS>)
 
-# And give tests access to our shared code
-target_link_libraries(Tests PRIVATE SharedCode Catch2::Catch2WithMain)
+# And give tests access to our shared DSP code, the editor and the GUI are left out
+target_link_libraries(Tests PRIVATE SharedDSPCode Catch2::Catch2WithMain)
 
 # Make an Xcode Scheme for the test executable so we can run tests in the IDE
 set_target_properties(Tests PROPERTIES XCODE_GENERATE_SCHEME ON)
@@ -44,6 +44,7 @@ set_target_properties(Tests PROPERTIES XCODE_GENERATE_SCHEME ON)
 target_compile_definitions(Tests PUBLIC
     JUCE_MODAL_LOOPS_PERMITTED=1 # let us run Message Manager in tests
     RUN_PAMPLEJUCE_TESTS=1 # also run tests in other module .cpp files guarded by RUN_PAMPLEJUCE_TESTS
+    ZL_HEADLESS=1 # build the processor without the editor
 )
 
 # Load and use the .cmake file provided by Catch2
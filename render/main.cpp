@@ -0,0 +1,214 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include "../source/PluginProcessor.hpp"
+
+namespace {
+    constexpr int kDefaultBlockSize = 8192;
+
+    void printUsage() {
+        std::cout << "usage: ZLCompressorRender --state=<state file> --output=<directory> "
+            "[--block=<block size>] [--threads=<number of threads>] [--profile] <input files...>\n"
+            "  the state file is either a saved plugin state or an XML state\n"
+            "  input files are rendered in parallel, each to a file with the same name in the output directory\n"
+            "  --profile prints the per-block cost of each DSP stage, which requires a build with ZL_DSP_PROFILE\n";
+    }
+
+    template <typename Profiler, size_t N>
+    void printProfile(const juce::String& title, Profiler& profiler, const std::array<const char*, N>& names) {
+        std::cout << "  " << title << " (" << profiler.getBlockCount() << " blocks, p50 / p99 in us)\n";
+        for (size_t i = 0; i < N; ++i) {
+            std::cout << "    " << juce::String(names[i]).paddedRight(' ', 16)
+                << juce::String(profiler.getStagePercentile(i, .5) * 1e-3, 2) << " / "
+                << juce::String(profiler.getStagePercentile(i, .99) * 1e-3, 2) << "\n";
+        }
+        std::cout << "    " << juce::String("total").paddedRight(' ', 16)
+            << juce::String(profiler.getTotalPercentile(.5) * 1e-3, 2) << " / "
+            << juce::String(profiler.getTotalPercentile(.99) * 1e-3, 2) << "\n";
+        profiler.requestReset();
+    }
+
+    /**
+     * render one audio file with a processor, the latency is removed from the output
+     * @return an empty string if successful, otherwise the error message
+     */
+    juce::String renderFile(PluginProcessor& processor, const juce::MemoryBlock& state,
+                            juce::AudioFormatManager& format_manager,
+                            const juce::File& input, const juce::File& output, const int block_size) {
+        const std::unique_ptr<juce::AudioFormatReader> reader(format_manager.createReaderFor(input));
+        if (reader == nullptr) {
+            return "cannot read " + input.getFullPathName();
+        }
+        const auto num_channels = static_cast<int>(reader->numChannels);
+        if (num_channels < 1 || num_channels > 2) {
+            return "only mono and stereo files are supported: " + input.getFullPathName();
+        }
+        // set the channel layout, the aux input is not used
+        juce::AudioProcessor::BusesLayout layout;
+        const auto channel_set = num_channels == 1
+                                     ? juce::AudioChannelSet::mono()
+                                     : juce::AudioChannelSet::stereo();
+        layout.inputBuses.add(channel_set);
+        layout.inputBuses.add(juce::AudioChannelSet::disabled());
+        layout.outputBuses.add(channel_set);
+        if (!processor.setBusesLayout(layout)) {
+            return "unsupported channel layout: " + input.getFullPathName();
+        }
+        // prepare the output writer with the same format as the input
+        auto* format = format_manager.findFormatForFileExtension(output.getFileExtension());
+        if (format == nullptr) {
+            return "unsupported output format: " + output.getFullPathName();
+        }
+        output.deleteFile();
+        auto file_stream = std::make_unique<juce::FileOutputStream>(output);
+        if (file_stream->failedToOpen()) {
+            return "cannot write " + output.getFullPathName();
+        }
+        std::unique_ptr<juce::OutputStream> stream = std::move(file_stream);
+        const auto bit_depths = format->getPossibleBitDepths();
+        const auto bit_depth = bit_depths.contains(static_cast<int>(reader->bitsPerSample))
+                                   ? static_cast<int>(reader->bitsPerSample)
+                                   : bit_depths.getLast();
+        const auto options = juce::AudioFormatWriterOptions{}
+                             .withSampleRate(reader->sampleRate)
+                             .withNumChannels(num_channels)
+                             .withBitsPerSample(bit_depth)
+                             .withMetadataValues(reader->metadataValues);
+        const auto writer = format->createWriterFor(stream, options);
+        if (writer == nullptr) {
+            return "cannot create a writer for " + output.getFullPathName();
+        }
+        // load the state and prepare the processor
+        processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        processor.setNonRealtime(true);
+        processor.prepareToPlay(reader->sampleRate, block_size);
+
+        juce::AudioBuffer<float> buffer(num_channels, block_size);
+        juce::MidiBuffer midi_buffer;
+        const auto num_total = static_cast<juce::int64>(reader->lengthInSamples);
+        // the latency of the offline quality mode is reported during preparation
+        juce::int64 read_pos = 0, num_written = 0, num_to_skip = processor.getLatencySamples();
+        while (num_written < num_total) {
+            // read the next block, the input is padded with zeros to flush the latency
+            buffer.clear();
+            const auto num_to_read = static_cast<int>(std::clamp(num_total - read_pos,
+                                                                 juce::int64(0), juce::int64(block_size)));
+            if (num_to_read > 0) {
+                reader->read(&buffer, 0, num_to_read, read_pos, true, num_channels > 1);
+                read_pos += num_to_read;
+            }
+            processor.processBlock(buffer, midi_buffer);
+            auto start_idx = 0;
+            if (num_to_skip > 0) {
+                start_idx = static_cast<int>(std::min(num_to_skip, juce::int64(block_size)));
+                num_to_skip -= start_idx;
+            }
+            const auto num_to_write = static_cast<int>(std::min(static_cast<juce::int64>(block_size - start_idx),
+                                                                num_total - num_written));
+            if (num_to_write > 0) {
+                if (!writer->writeFromAudioSampleBuffer(buffer, start_idx, num_to_write)) {
+                    return "failed to write " + output.getFullPathName();
+                }
+                num_written += num_to_write;
+            }
+        }
+        processor.releaseResources();
+        return {};
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    const juce::ScopedJuceInitialiser_GUI juce_initialiser;
+    const juce::ArgumentList args(argc, argv);
+    if (args.size() == 0 || args.containsOption("--help|-h")) {
+        printUsage();
+        return 0;
+    }
+    // parse options
+    const auto state_file = juce::File::getCurrentWorkingDirectory().getChildFile(
+        args.getValueForOption("--state"));
+    const auto output_dir = juce::File::getCurrentWorkingDirectory().getChildFile(
+        args.getValueForOption("--output"));
+    const auto block_size_arg = args.getValueForOption("--block").getIntValue();
+    const auto block_size = block_size_arg > 0 ? block_size_arg : kDefaultBlockSize;
+    const auto num_threads_arg = args.getValueForOption("--threads").getIntValue();
+    const auto num_threads = num_threads_arg > 0 ? num_threads_arg : juce::SystemStats::getNumCpus();
+    const auto to_profile = args.containsOption("--profile");
+    if (to_profile && !zlchore::profile::kEnabled) {
+        std::cerr << "the timing probes are not compiled in, rebuild with -DZL_DSP_PROFILE=ON\n";
+    }
+    juce::Array<juce::File> inputs;
+    for (const auto& arg : args.arguments) {
+        if (!arg.isOption()) {
+            inputs.add(arg.resolveAsFile());
+        }
+    }
+    if (!state_file.existsAsFile() || inputs.isEmpty()) {
+        printUsage();
+        return 1;
+    }
+    if (!output_dir.createDirectory()) {
+        std::cerr << "cannot create " << output_dir.getFullPathName() << "\n";
+        return 1;
+    }
+    // load the state, an XML state is converted to a plugin state blob
+    juce::MemoryBlock state;
+    if (state_file.hasFileExtension("xml")) {
+        const auto xml = juce::XmlDocument::parse(state_file);
+        if (xml == nullptr) {
+            std::cerr << "cannot parse " << state_file.getFullPathName() << "\n";
+            return 1;
+        }
+        juce::AudioProcessor::copyXmlToBinary(*xml, state);
+    } else if (!state_file.loadFileAsData(state)) {
+        std::cerr << "cannot read " << state_file.getFullPathName() << "\n";
+        return 1;
+    }
+    // create one processor per thread on the message thread, each thread renders files one by one
+    const auto num_workers = std::min(num_threads, inputs.size());
+    std::vector<std::unique_ptr<PluginProcessor>> processors;
+    for (int i = 0; i < num_workers; ++i) {
+        processors.emplace_back(std::make_unique<PluginProcessor>());
+    }
+    std::atomic<int> next_idx{0}, num_failed{0};
+    std::mutex print_mutex;
+    juce::ThreadPool pool(juce::ThreadPoolOptions{}.withNumberOfThreads(num_workers));
+    for (int i = 0; i < num_workers; ++i) {
+        pool.addJob([&, i] {
+            juce::AudioFormatManager format_manager;
+            format_manager.registerBasicFormats();
+            for (auto idx = next_idx.fetch_add(1); idx < inputs.size(); idx = next_idx.fetch_add(1)) {
+                const auto& input = inputs.getReference(idx);
+                const auto output = output_dir.getChildFile(input.getFileName());
+                const auto error = renderFile(*processors[static_cast<size_t>(i)], state, format_manager,
+                                              input, output, block_size);
+                std::lock_guard<std::mutex> lock{print_mutex};
+                if (error.isEmpty()) {
+                    std::cout << "rendered " << output.getFullPathName() << "\n";
+                    if (to_profile && zlchore::profile::kEnabled) {
+                        auto& processor = *processors[static_cast<size_t>(i)];
+                        printProfile("compressor", processor.getCompressController().getProfiler(),
+                                     zlp::CompressController::kStageNames);
+                        printProfile("side-chain equalizer", processor.getEqualizeController().getProfiler(),
+                                     zlp::EqualizeController::kStageNames);
+                    }
+                } else {
+                    std::cerr << error << "\n";
+                    num_failed.fetch_add(1);
+                }
+            }
+        });
+    }
+    while (pool.getNumJobs() > 0) {
+        juce::Thread::sleep(10);
+    }
+    return num_failed.load() == 0 ? 0 : 1;
+}
@@ -8,7 +8,9 @@
 // You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
 
 #include "PluginProcessor.hpp"
+#if !ZL_HEADLESS
 #include "PluginEditor.hpp"
+#endif
 
 //==============================================================================
 PluginProcessor::PluginProcessor() :
@@ -33,7 +35,30 @@ PluginProcessor::PluginProcessor() :
     equalize_controller_(),
     equalize_attach_(*this, parameters_, equalize_controller_),
     ext_side_(*parameters_.getRawParameterValue(zlp::PExtSide::kID)),
-    side_out_(*parameters_.getRawParameterValue(zlp::PSideOut::kID)) {
+    side_out_(*parameters_.getRawParameterValue(zlp::PSideOut::kID)),
+    bypass_mode_(*state_.getRawParameterValue(zlstate::PBypassMode::kID)),
+    offline_oversample_(*state_.getRawParameterValue(zlstate::POfflineOversample::kID)) {
+    // collect the parameters written to the binary state, plugin parameters first and then NA parameters
+    const auto add_state_paras = [this](const juce::Array<juce::AudioProcessorParameter*>& paras,
+                                        juce::AudioProcessorValueTreeState& apvts) {
+        for (auto* para : paras) {
+            if (auto* ranged_para = dynamic_cast<juce::RangedAudioParameter*>(para)) {
+                const auto& ID = ranged_para->getParameterID();
+                if (apvts.getParameter(ID) == ranged_para) {
+                    state_paras_.emplace_back(ranged_para);
+                    state_para_hashes_.emplace_back(static_cast<uint32_t>(ID.hashCode()));
+                }
+            }
+        }
+    };
+    add_state_paras(getParameters(), parameters_);
+    add_state_paras(dummy_processor_.getParameters(), na_parameters_);
+    // the binary state finds the parameters by the hashes, so they must not collide
+    jassert([this] {
+        auto hashes = state_para_hashes_;
+        std::sort(hashes.begin(), hashes.end());
+        return std::adjacent_find(hashes.begin(), hashes.end()) == hashes.end();
+    }());
 }
 
 PluginProcessor::~PluginProcessor() = default;
@@ -68,7 +93,7 @@ bool PluginProcessor::isMidiEffect() const {
 }
 
 double PluginProcessor::getTailLengthSeconds() const {
-    return 0.0;
+    return compress_controller_.getTailLengthSeconds();
 }
 
 int PluginProcessor::getNumPrograms() {
@@ -102,9 +127,16 @@ void PluginProcessor::prepareToPlay(const double sample_rate, const int samples_
     double_side_pointers_[0] = double_buffer_.getWritePointer(0);
     double_side_pointers_[1] = double_buffer_.getWritePointer(1);
     double_buffer_.clear();
-    compress_controller_.prepare(sample_rate, static_cast<size_t>(samples_per_block));
+    // the offline quality mode is picked up here, hosts prepare the processor again before an offline render
+    compress_controller_.setOfflineOversampleIdx(
+        static_cast<int>(std::round(offline_oversample_.load(std::memory_order::relaxed))));
+    // the side-chain latency is known after preparing the equalizer, the compressor reports the total latency
     equalize_controller_.prepare(sample_rate, static_cast<size_t>(samples_per_block));
+    compress_controller_.setSideLatency(equalize_controller_.getLatency());
+    compress_controller_.prepare(sample_rate, static_cast<size_t>(samples_per_block));
     sample_rate_.store(sample_rate, std::memory_order::relaxed);
+    c_sample_rate_ = sample_rate;
+    silent_count_ = 0;
     // determine current channel layout
     const auto* main_bus = getBus(true, 0);
     const auto* aux_bus = getBus(true, 1);
@@ -161,11 +193,101 @@ void PluginProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::Midi
 }
 
 void PluginProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) {
-    processBlockInternal<true>(buffer);
+    if (bypass_mode_.load(std::memory_order::relaxed) > .5f) {
+        processBlockInternal<true>(buffer);
+    } else {
+        processBlockLightBypass(buffer);
+    }
 }
 
 void PluginProcessor::processBlockBypassed(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&) {
-    processBlockInternal<true>(buffer);
+    if (bypass_mode_.load(std::memory_order::relaxed) > .5f) {
+        processBlockInternal<true>(buffer);
+    } else {
+        processBlockLightBypass(buffer);
+    }
+}
+
+void PluginProcessor::processBlockLightBypass(juce::AudioBuffer<float>& buffer) {
+    juce::ScopedNoDenormals no_denormals;
+    if (buffer.getNumSamples() == 0)
+        return; // ignore empty blocks
+    if (checkIdle(buffer))
+        return; // all internal states have settled, skip processing
+    const auto buffer_size = static_cast<size_t>(buffer.getNumSamples());
+    compress_controller_.setSideLatency(equalize_controller_.getLatency());
+    switch (channel_layout_) {
+    case ChannelLayout::kMain1Aux0:
+    case ChannelLayout::kMain1Aux1:
+    case ChannelLayout::kMain1Aux2: {
+        main_pointers_[0] = buffer.getWritePointer(0);
+        zldsp::vector::copy(main_pointers_[1], main_pointers_[0], buffer_size);
+        compress_controller_.processBypass(main_pointers_, buffer_size);
+        break;
+    }
+    case ChannelLayout::kMain2Aux0:
+    case ChannelLayout::kMain2Aux1:
+    case ChannelLayout::kMain2Aux2: {
+        main_pointers_[0] = buffer.getWritePointer(0);
+        main_pointers_[1] = buffer.getWritePointer(1);
+        compress_controller_.processBypass(main_pointers_, buffer_size);
+        break;
+    }
+    case ChannelLayout::kInvalid: {
+    }
+    }
+}
+
+void PluginProcessor::processBlockLightBypass(juce::AudioBuffer<double>& buffer) {
+    juce::ScopedNoDenormals no_denormals;
+    if (buffer.getNumSamples() == 0)
+        return; // ignore empty blocks
+    if (checkIdle(buffer))
+        return; // all internal states have settled, skip processing
+    const auto buffer_size = static_cast<size_t>(buffer.getNumSamples());
+    compress_controller_.setSideLatency(equalize_controller_.getLatency());
+    switch (channel_layout_) {
+    case ChannelLayout::kMain1Aux0:
+    case ChannelLayout::kMain1Aux1:
+    case ChannelLayout::kMain1Aux2: {
+        zldsp::vector::copy(main_pointers_[0], buffer.getWritePointer(0), buffer_size);
+        zldsp::vector::copy(main_pointers_[1], main_pointers_[0], buffer_size);
+        compress_controller_.processBypass(main_pointers_, buffer_size);
+        zldsp::vector::copy(buffer.getWritePointer(0), main_pointers_[0], buffer_size);
+        break;
+    }
+    case ChannelLayout::kMain2Aux0:
+    case ChannelLayout::kMain2Aux1:
+    case ChannelLayout::kMain2Aux2: {
+        zldsp::vector::copy(main_pointers_[0], buffer.getWritePointer(0), buffer_size);
+        zldsp::vector::copy(main_pointers_[1], buffer.getWritePointer(1), buffer_size);
+        compress_controller_.processBypass(main_pointers_, buffer_size);
+        zldsp::vector::copy(buffer.getWritePointer(0), main_pointers_[0], buffer_size);
+        zldsp::vector::copy(buffer.getWritePointer(1), main_pointers_[1], buffer_size);
+        break;
+    }
+    case ChannelLayout::kInvalid: {
+    }
+    }
+}
+
+template <typename FloatType>
+bool PluginProcessor::checkIdle(const juce::AudioBuffer<FloatType>& buffer) {
+    const auto buffer_size = static_cast<size_t>(buffer.getNumSamples());
+    const auto num_channels = std::min(buffer.getNumChannels(), getTotalNumInputChannels());
+    for (int chan = 0; chan < num_channels; ++chan) {
+        if (zldsp::vector::max_abs_of(buffer.getReadPointer(chan), buffer_size) > FloatType(kSilenceThreshold)) {
+            silent_count_ = 0;
+            return false;
+        }
+    }
+    // the input is silent, wait until the output tail and all detector states have decayed
+    const auto idle_count = static_cast<size_t>(compress_controller_.getTailLengthSeconds() * c_sample_rate_);
+    if (silent_count_ < idle_count) {
+        silent_count_ += buffer_size;
+        return false;
+    }
+    return true;
 }
 
 template <bool IsBypassed>
@@ -173,9 +295,12 @@ void PluginProcessor::processBlockInternal(juce::AudioBuffer<float>& buffer) {
     juce::ScopedNoDenormals no_denormals;
     if (buffer.getNumSamples() == 0)
         return; // ignore empty blocks
+    if (checkIdle(buffer))
+        return; // all internal states have settled, skip processing
     const auto c_ext_side = ext_side_.load(std::memory_order::relaxed) > .5f;
     const auto c_side_out = side_out_.load(std::memory_order::relaxed) > .5f;
     const auto buffer_size = static_cast<size_t>(buffer.getNumSamples());
+    compress_controller_.setSideLatency(equalize_controller_.getLatency());
 
     switch (channel_layout_) {
     case ChannelLayout::kMain1Aux0: {
@@ -314,9 +439,12 @@ void PluginProcessor::processBlockInternal(juce::AudioBuffer<double>& buffer) {
     juce::ScopedNoDenormals no_denormals;
     if (buffer.getNumSamples() == 0)
         return; // ignore empty blocks
+    if (checkIdle(buffer))
+        return; // all internal states have settled, skip processing
     const auto c_ext_side = ext_side_.load(std::memory_order::relaxed) > .5f;
     const auto c_side_out = side_out_.load(std::memory_order::relaxed) > .5f;
     const auto buffer_size = static_cast<size_t>(buffer.getNumSamples());
+    compress_controller_.setSideLatency(equalize_controller_.getLatency());
 
     switch (channel_layout_) {
     case ChannelLayout::kMain1Aux0: {
@@ -481,22 +609,39 @@ void PluginProcessor::processBlockInternal(juce::AudioBuffer<double>& buffer) {
 }
 
 bool PluginProcessor::hasEditor() const {
-    return true;
+    return !ZL_HEADLESS;
 }
 
 juce::AudioProcessorEditor* PluginProcessor::createEditor() {
+#if ZL_HEADLESS
+    // the headless builds, e.g., the render tool, compile neither the editor nor the GUI
+    return nullptr;
+#else
     return new PluginEditor(*this);
+#endif
 }
 
 void PluginProcessor::getStateInformation(juce::MemoryBlock& dest_data) {
-    auto temp_tree = juce::ValueTree("ZLCompressorParaState");
-    temp_tree.appendChild(parameters_.copyState(), nullptr);
-    temp_tree.appendChild(na_parameters_.copyState(), nullptr);
-    const std::unique_ptr<juce::XmlElement> xml(temp_tree.createXml());
-    copyXmlToBinary(*xml, dest_data);
+    // header: magic, version, number of entries; entry: hash of the parameter ID, real value
+    const auto num_entries = static_cast<uint32_t>(state_paras_.size());
+    dest_data.setSize(kStateHeaderSize + kStateEntrySize * state_paras_.size());
+    auto* dest = static_cast<char*>(dest_data.getData());
+    const std::array<uint32_t, 3> header{kStateMagic, kStateVersion, num_entries};
+    std::memcpy(dest, header.data(), kStateHeaderSize);
+    dest += kStateHeaderSize;
+    for (size_t i = 0; i < state_paras_.size(); ++i) {
+        const auto value = state_paras_[i]->convertFrom0to1(state_paras_[i]->getValue());
+        std::memcpy(dest, &state_para_hashes_[i], sizeof(uint32_t));
+        std::memcpy(dest + sizeof(uint32_t), &value, sizeof(float));
+        dest += kStateEntrySize;
+    }
 }
 
 void PluginProcessor::setStateInformation(const void* data, int size_in_bytes) {
+    if (setBinaryState(data, static_cast<size_t>(std::max(size_in_bytes, 0)))) {
+        return;
+    }
+    // fall back to the XML state of older sessions
     std::unique_ptr<juce::XmlElement> xml_state(getXmlFromBinary(data, size_in_bytes));
     if (xml_state != nullptr && xml_state->hasTagName("ZLCompressorParaState")) {
         const auto temp_tree = juce::ValueTree::fromXml(*xml_state);
@@ -505,6 +650,47 @@ void PluginProcessor::setStateInformation(const void* data, int size_in_bytes) {
     }
 }
 
+bool PluginProcessor::setBinaryState(const void* data, const size_t size_in_bytes) {
+    if (data == nullptr || size_in_bytes < kStateHeaderSize) {
+        return false;
+    }
+    const auto* src = static_cast<const char*>(data);
+    std::array<uint32_t, 3> header{};
+    std::memcpy(header.data(), src, kStateHeaderSize);
+    if (header[0] != kStateMagic || header[1] > kStateVersion) {
+        return false;
+    }
+    const auto num_entries = static_cast<size_t>(header[2]);
+    if (size_in_bytes < kStateHeaderSize + kStateEntrySize * num_entries) {
+        return false;
+    }
+    src += kStateHeaderSize;
+    // the parameters missing from the state get their defaults
+    for (auto* para : state_paras_) {
+        para->setValueNotifyingHost(para->getDefaultValue());
+    }
+    const auto is_normalized = header[1] < 2;
+    for (size_t i = 0; i < num_entries; ++i) {
+        uint32_t hash;
+        float value;
+        std::memcpy(&hash, src, sizeof(uint32_t));
+        std::memcpy(&value, src + sizeof(uint32_t), sizeof(float));
+        src += kStateEntrySize;
+        // entries are usually in the same order, search only if the parameter list has changed
+        auto idx = i;
+        if (idx >= state_para_hashes_.size() || state_para_hashes_[idx] != hash) {
+            const auto it = std::find(state_para_hashes_.begin(), state_para_hashes_.end(), hash);
+            if (it == state_para_hashes_.end()) {
+                continue;
+            }
+            idx = static_cast<size_t>(std::distance(state_para_hashes_.begin(), it));
+        }
+        auto* para = state_paras_[idx];
+        para->setValueNotifyingHost(is_normalized ? value : para->convertTo0to1(value));
+    }
+    return true;
+}
+
 juce::AudioProcessor* JUCE_CALLTYPE
 
 createPluginFilter() {
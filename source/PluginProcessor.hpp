@@ -103,9 +103,27 @@ private:
     };
 
     std::atomic<float> &ext_side_, &side_out_;
+    // 0: only keep the latency while bypassed, 1: keep running the side-chain and the detector
+    std::atomic<float>& bypass_mode_;
+    // the minimum oversampling idx while rendering offline
+    std::atomic<float>& offline_oversample_;
     std::atomic<double> sample_rate_{48000.0};
     ChannelLayout channel_layout_{kInvalid};
 
+    // binary plugin state, older sessions with XML state are still readable
+    static constexpr uint32_t kStateMagic = 0x5a4c4350;
+    // version 1 stores normalized values, version 2 stores real values
+    static constexpr uint32_t kStateVersion = 2;
+    static constexpr size_t kStateHeaderSize = 3 * sizeof(uint32_t);
+    static constexpr size_t kStateEntrySize = sizeof(uint32_t) + sizeof(float);
+    std::vector<juce::RangedAudioParameter*> state_paras_;
+    std::vector<uint32_t> state_para_hashes_;
+
+    // idle detection, about -120 dB
+    static constexpr float kSilenceThreshold = 1e-6f;
+    double c_sample_rate_{48000.0};
+    size_t silent_count_{0};
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginProcessor)
 
     template <bool IsBypassed = false>
@@ -113,4 +131,13 @@ private:
 
     template <bool IsBypassed = false>
     void processBlockInternal(juce::AudioBuffer<double>& buffer);
+
+    void processBlockLightBypass(juce::AudioBuffer<float>& buffer);
+
+    void processBlockLightBypass(juce::AudioBuffer<double>& buffer);
+
+    bool setBinaryState(const void* data, size_t size_in_bytes);
+
+    template <typename FloatType>
+    bool checkIdle(const juce::AudioBuffer<FloatType>& buffer);
 };
@@ -0,0 +1,280 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+#ifndef ZL_DSP_PROFILE
+#define ZL_DSP_PROFILE 0
+#endif
+
+#ifndef ZL_DSP_PROFILE_USE_TSC
+#define ZL_DSP_PROFILE_USE_TSC 0
+#endif
+
+#if ZL_DSP_PROFILE_USE_TSC && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define ZL_DSP_PROFILE_HAS_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define ZL_DSP_PROFILE_HAS_TSC 0
+#endif
+
+namespace zlchore::profile {
+    inline constexpr bool kEnabled = ZL_DSP_PROFILE != 0;
+
+    /**
+     * the timestamp source of the probes
+     * it reads the CPU timestamp counter if requested and available, otherwise std::chrono::steady_clock
+     */
+    class Clock {
+    public:
+        static uint64_t now() noexcept {
+#if ZL_DSP_PROFILE_HAS_TSC
+            return static_cast<uint64_t>(__rdtsc());
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        /**
+         * the timestamp counter is calibrated against the steady clock at the first call, which blocks for 20 ms
+         * do not call it on the audio thread
+         * @return the duration of one tick in nanoseconds
+         */
+        static double getNanosecondsPerTick() {
+#if ZL_DSP_PROFILE_HAS_TSC
+            static const double ns_per_tick = [] {
+                const auto start_time = std::chrono::steady_clock::now();
+                const auto start_tick = now();
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                const auto end_tick = now();
+                const auto end_time = std::chrono::steady_clock::now();
+                const auto ns = std::chrono::duration<double, std::nano>(end_time - start_time).count();
+                return ns / static_cast<double>(std::max(end_tick - start_tick, uint64_t(1)));
+            }();
+            return ns_per_tick;
+#else
+            return 1.0;
+#endif
+        }
+    };
+
+    /**
+     * a log-scaled histogram of durations in ticks, with four buckets per octave
+     * it has a single writer (the audio thread) and any number of readers, all without locks
+     */
+    class Histogram {
+    public:
+        static constexpr size_t kBucketNum = 252;
+
+        /**
+         * audio-thread method
+         * @param ticks the duration in ticks
+         */
+        void push(const uint64_t ticks) noexcept {
+            auto& count = counts_[getBucketIdx(ticks)];
+            count.store(count.load(std::memory_order::relaxed) + 1, std::memory_order::relaxed);
+        }
+
+        /**
+         * audio-thread method
+         */
+        void reset() noexcept {
+            for (auto& count : counts_) {
+                count.store(0, std::memory_order::relaxed);
+            }
+        }
+
+        /**
+         * thread-safe method
+         * @return the number of pushed durations
+         */
+        uint64_t getCount() const noexcept {
+            uint64_t total = 0;
+            for (const auto& count : counts_) {
+                total += count.load(std::memory_order::relaxed);
+            }
+            return total;
+        }
+
+        /**
+         * thread-safe method
+         * @param p the percentile between 0 and 1
+         * @return the centre of the bucket which holds the percentile, in ticks
+         */
+        double getPercentile(const double p) const noexcept {
+            std::array<uint64_t, kBucketNum> snapshot{};
+            uint64_t total = 0;
+            for (size_t i = 0; i < kBucketNum; ++i) {
+                snapshot[i] = counts_[i].load(std::memory_order::relaxed);
+                total += snapshot[i];
+            }
+            if (total == 0) {
+                return 0.0;
+            }
+            const auto rank = static_cast<uint64_t>(std::ceil(p * static_cast<double>(total)));
+            uint64_t acc = 0;
+            for (size_t i = 0; i < kBucketNum; ++i) {
+                acc += snapshot[i];
+                if (acc >= std::max(rank, uint64_t(1))) {
+                    return 0.5 * (getBucketLow(i) + getBucketLow(i + 1));
+                }
+            }
+            return getBucketLow(kBucketNum - 1);
+        }
+
+    private:
+        std::array<std::atomic<uint32_t>, kBucketNum> counts_{};
+
+        static size_t getBucketIdx(const uint64_t ticks) noexcept {
+            if (ticks < 8) {
+                return static_cast<size_t>(ticks);
+            }
+            // the exponent and the two bits below the leading one
+            const auto msb = static_cast<size_t>(std::bit_width(ticks)) - 1;
+            const auto sub = static_cast<size_t>(ticks >> (msb - 2)) & 3;
+            return 4 * (msb - 1) + sub;
+        }
+
+        static double getBucketLow(const size_t idx) noexcept {
+            if (idx < 8) {
+                return static_cast<double>(idx);
+            }
+            const auto msb = idx / 4 + 1;
+            const auto sub = idx % 4;
+            return std::ldexp(static_cast<double>(4 + sub), static_cast<int>(msb) - 2);
+        }
+    };
+
+    /**
+     * per-stage timing probes of a processing function
+     * call startBlock at the beginning, lap after each stage and finishBlock at the end
+     * the time since the previous lap is added to the stage, so a stage can be lapped several times per block
+     * the per-block cost of each stage and the total cost are pushed into histograms
+     * if profiling is disabled at compile time, all methods do nothing
+     * @tparam NumStages the number of stages
+     * @tparam Enabled whether the probes are compiled in
+     */
+    template <size_t NumStages, bool Enabled = kEnabled>
+    class StageProfiler {
+    public:
+        /**
+         * audio-thread method
+         */
+        void startBlock() noexcept {
+            block_ticks_.fill(0);
+            last_tick_ = Clock::now();
+        }
+
+        /**
+         * audio-thread method
+         * @param stage the stage which has just finished
+         */
+        void lap(const size_t stage) noexcept {
+            const auto tick = Clock::now();
+            block_ticks_[stage] += tick - last_tick_;
+            last_tick_ = tick;
+        }
+
+        /**
+         * audio-thread method
+         */
+        void finishBlock() noexcept {
+            if (to_reset_.load(std::memory_order::relaxed) && to_reset_.exchange(false, std::memory_order::relaxed)) {
+                for (auto& h : histograms_) {
+                    h.reset();
+                }
+                total_histogram_.reset();
+            }
+            uint64_t total = 0;
+            for (size_t i = 0; i < NumStages; ++i) {
+                histograms_[i].push(block_ticks_[i]);
+                total += block_ticks_[i];
+            }
+            total_histogram_.push(total);
+        }
+
+        /**
+         * thread-safe method
+         * the histograms are cleared at the end of the next block
+         */
+        void requestReset() noexcept {
+            to_reset_.store(true, std::memory_order::relaxed);
+        }
+
+        /**
+         * thread-safe method
+         * @param stage the stage
+         * @param p the percentile between 0 and 1
+         * @return the per-block cost of the stage in nanoseconds
+         */
+        double getStagePercentile(const size_t stage, const double p) const {
+            return histograms_[stage].getPercentile(p) * Clock::getNanosecondsPerTick();
+        }
+
+        /**
+         * thread-safe method
+         * @param p the percentile between 0 and 1
+         * @return the per-block cost of all stages in nanoseconds
+         */
+        double getTotalPercentile(const double p) const {
+            return total_histogram_.getPercentile(p) * Clock::getNanosecondsPerTick();
+        }
+
+        /**
+         * thread-safe method
+         * @return the number of profiled blocks
+         */
+        uint64_t getBlockCount() const noexcept {
+            return total_histogram_.getCount();
+        }
+
+    private:
+        std::array<uint64_t, NumStages> block_ticks_{};
+        uint64_t last_tick_{0};
+        std::atomic<bool> to_reset_{false};
+        std::array<Histogram, NumStages> histograms_{};
+        Histogram total_histogram_{};
+    };
+
+    template <size_t NumStages>
+    class StageProfiler<NumStages, false> {
+    public:
+        void startBlock() noexcept {
+        }
+
+        void lap(size_t) noexcept {
+        }
+
+        void finishBlock() noexcept {
+        }
+
+        void requestReset() noexcept {
+        }
+
+        double getStagePercentile(size_t, double) const { return 0.0; }
+
+        double getTotalPercentile(double) const { return 0.0; }
+
+        uint64_t getBlockCount() const noexcept { return 0; }
+    };
+}
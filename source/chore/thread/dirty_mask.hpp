@@ -0,0 +1,46 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace zlchore::thread {
+    /**
+     * a set of update flags packed into one atomic word
+     * any thread can raise flags, a single consumer takes all raised flags at once
+     */
+    class DirtyMask {
+    public:
+        DirtyMask() = default;
+
+        explicit DirtyMask(const uint32_t initial_bits) :
+            bits_(initial_bits) {
+        }
+
+        void signal(const uint32_t bits) {
+            bits_.fetch_or(bits, std::memory_order_release);
+        }
+
+        /**
+         * take all raised flags and clear them
+         * @return the raised flags
+         */
+        uint32_t take() {
+            if (bits_.load(std::memory_order_relaxed) == 0) {
+                return 0;
+            }
+            return bits_.exchange(0, std::memory_order_acquire);
+        }
+
+    private:
+        std::atomic<uint32_t> bits_{0};
+    };
+}
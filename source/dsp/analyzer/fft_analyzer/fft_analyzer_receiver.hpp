@@ -9,13 +9,15 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "fft_analyzer_processor.hpp"
 
 namespace zldsp::analyzer {
     namespace hn = hwy::HWY_NAMESPACE;
     /**
-     * a fft analyzer receiver which pulls input samples from FIFOs and runs forward FFT
-     * @tparam kNum the number of FFTs
+     * a hop-scheduled STFT receiver which pulls input samples from FIFOs into ring buffers
+     * and runs a forward FFT whenever a hop of new samples is ready
      */
     class FFTAnalyzerReceiver {
     public:
@@ -26,11 +28,17 @@ namespace zldsp::analyzer {
         /**
          *
          * @param num_channels number of channels
+         * @param hop_size number of new samples between two FFT frames, 0 means a quarter of the FFT size
          */
-        void prepare(const size_t num_channels) {
-            abs_sqr_fft_buffer_.resize(processor_.getFFTSize() / 2 + 1);
-            circular_buffer_.resize(num_channels);
-            states_.resize(num_channels);
+        void prepare(const size_t num_channels, const size_t hop_size = 0) {
+            const auto fft_size = processor_.getFFTSize();
+            abs_sqr_fft_buffer_.resize(fft_size / 2 + 1);
+            accu_fft_buffer_.resize(fft_size / 2 + 1);
+            ring_buffer_.resize(num_channels);
+            x_states_.resize(num_channels);
+            y_states_.resize(num_channels);
+            ring_mask_ = fft_size - 1;
+            setHopSize(hop_size == 0 ? fft_size / 4 : hop_size);
             reset();
         }
 
@@ -38,105 +46,75 @@ namespace zldsp::analyzer {
          * reset internal buffers
          */
         void reset() {
-            for (size_t chan = 0; chan < circular_buffer_.size(); ++chan) {
-                circular_buffer_[chan].resize(processor_.getFFTSize());
-                std::ranges::fill(circular_buffer_[chan], 0.f);
+            for (auto& ring_buffer : ring_buffer_) {
+                ring_buffer.resize(processor_.getFFTSize());
+                std::ranges::fill(ring_buffer, 0.f);
             }
-            std::ranges::fill(states_, 0.f);
+            std::ranges::fill(x_states_, 0.f);
+            std::ranges::fill(y_states_, 0.f);
+            std::ranges::fill(abs_sqr_fft_buffer_, 0.f);
+            write_pos_ = 0;
+            num_pending_ = 0;
+            num_frames_ = 0;
         }
 
         /**
-         * pull data from FIFO into circular buffer
+         * set the number of new samples between two FFT frames
+         * @param hop_size
+         */
+        void setHopSize(const size_t hop_size) {
+            hop_size_ = std::clamp(hop_size, static_cast<size_t>(1), processor_.getFFTSize());
+            num_pending_ = 0;
+        }
+
+        [[nodiscard]] size_t getHopSize() const {
+            return hop_size_;
+        }
+
+        void setStereoType(const StereoType stereo_type) {
+            stereo_type_ = stereo_type;
+        }
+
+        /**
+         * pull data from FIFO into ring buffers, run forward FFT for every completed hop
          * @param range
          * @param sample_fifo
          */
         void pull(const zldsp::container::FIFORange range,
                   const std::vector<std::vector<float>>& sample_fifo) {
-            const auto num_ready = range.block_size1 + range.block_size2;
-            const auto num_replace = static_cast<int>(processor_.getFFTSize()) - num_ready;
             if (!is_on_) { return; }
-            for (size_t chan = 0; chan < circular_buffer_.size(); ++chan) {
-                auto& circular_buffer{circular_buffer_[chan]};
-                auto y = circular_buffer.back();
-                auto x = states_[chan];
-                std::memmove(circular_buffer.data(),
-                             circular_buffer.data() + static_cast<size_t>(num_ready),
-                             sizeof(float) * static_cast<size_t>(num_replace));
-                if (range.block_size1 > 0) {
-                    copyWithHighPass(circular_buffer.data() + static_cast<size_t>(num_replace),
-                        sample_fifo[chan].data() + static_cast<size_t>(range.start_index1),
-                        static_cast<size_t>(range.block_size1), y, x);
-                }
-                if (range.block_size2 > 0) {
-                    copyWithHighPass(circular_buffer.data() + static_cast<size_t>(num_replace + range.block_size1),
-                        sample_fifo[chan].data() + static_cast<size_t>(range.start_index2),
-                        static_cast<size_t>(range.block_size2), y, x);
-                }
-                states_[chan] = x;
+            if (range.block_size1 > 0) {
+                const auto start_index = static_cast<size_t>(range.start_index1);
+                pullBlock([&](const size_t chan) { return sample_fifo[chan].data() + start_index; },
+                          static_cast<size_t>(range.block_size1));
+            }
+            if (range.block_size2 > 0) {
+                const auto start_index = static_cast<size_t>(range.start_index2);
+                pullBlock([&](const size_t chan) { return sample_fifo[chan].data() + start_index; },
+                          static_cast<size_t>(range.block_size2));
             }
         }
 
         /**
-         * run forward FFT to get the absolute square spectrum
-         * @param stereo_type
+         * pull data from contiguous buffers into ring buffers, run forward FFT for every completed hop
+         * @param samples
+         * @param num_samples
          */
-        void forward(const StereoType stereo_type) {
-            // run forward FFT & apply tilt
+        void pull(std::span<const float* const> samples, const size_t num_samples) {
             if (!is_on_) { return; }
-            auto& fft_in{processor_.getFFTIn()};
-            auto& fft_out{processor_.getFFTOut()};
-            const auto& window{processor_.getWindow()};
-            if (circular_buffer_.size() != 2 || stereo_type == StereoType::kStereo) {
-                for (size_t chan = 0; chan < circular_buffer_.size(); ++chan) {
-                    vector::multiply(fft_in.data(), circular_buffer_[chan].data(),
-                                     window.data(), window.size());
-                    if (chan == 0) {
-                        processor_.forwardSqrMag(fft_in.data(), abs_sqr_fft_buffer_.data());
-                    } else {
-                        processor_.forwardSqrMag(fft_in.data(), fft_out.data());
-                        vector::add(abs_sqr_fft_buffer_.data(), fft_out.data(), fft_out.size());
-                    }
-                }
-            } else {
-                if (stereo_type == StereoType::kLeft) {
-                    vector::multiply(fft_in.data(), circular_buffer_[0].data(),
-                                     window.data(), window.size());
-                } else if (stereo_type == StereoType::kRight) {
-                    vector::multiply(fft_in.data(), circular_buffer_[1].data(),
-                                     window.data(), window.size());
-                } else if (stereo_type == StereoType::kMid) {
-                    static constexpr hn::ScalableTag<float> d;
-                    static constexpr size_t lanes = hn::MaxLanes(d);
-                    float* __restrict fft_in_ptr = fft_in.data();
-                    const float* __restrict in0_ptr = circular_buffer_[0].data();
-                    const float* __restrict in1_ptr = circular_buffer_[1].data();
-                    const float* __restrict window_ptr = window.data();
-                    const auto v_sqrt_over_2 = hn::Set(d, kSqrt2Over2);
-                    for (size_t j = 0; j < processor_.getFFTSize(); j += lanes) {
-                        const auto v_in0 = hn::LoadU(d, in0_ptr + j);
-                        const auto v_in1 = hn::LoadU(d, in1_ptr + j);
-                        const auto v_window = hn::LoadU(d, window_ptr + j);
-                        const auto v_out = hn::Mul(hn::Add(v_in0, v_in1), v_sqrt_over_2);
-                        hn::StoreU(hn::Mul(v_out, v_window), d, fft_in_ptr + j);
-                    }
-                } else {
-                    static constexpr hn::ScalableTag<float> d;
-                    static constexpr size_t lanes = hn::MaxLanes(d);
-                    float* __restrict fft_in_ptr = fft_in.data();
-                    const float* __restrict in0_ptr = circular_buffer_[0].data();
-                    const float* __restrict in1_ptr = circular_buffer_[1].data();
-                    const float* __restrict window_ptr = window.data();
-                    const auto v_sqrt_over_2 = hn::Set(d, kSqrt2Over2);
-                    for (size_t j = 0; j < processor_.getFFTSize(); j += lanes) {
-                        const auto v_in0 = hn::LoadU(d, in0_ptr + j);
-                        const auto v_in1 = hn::LoadU(d, in1_ptr + j);
-                        const auto v_window = hn::LoadU(d, window_ptr + j);
-                        const auto v_out = hn::Mul(hn::Sub(v_in0, v_in1), v_sqrt_over_2);
-                        hn::StoreU(hn::Mul(v_out, v_window), d, fft_in_ptr + j);
-                    }
-                }
-                processor_.forwardSqrMag(fft_in.data(), abs_sqr_fft_buffer_.data());
-            }
+            pullBlock([&](const size_t chan) { return samples[chan]; }, num_samples);
+        }
+
+        /**
+         * average the frames computed since the last call into the absolute square spectrum
+         * @return whether at least one new frame is available
+         */
+        bool updateSpectrum() {
+            if (num_frames_ == 0) { return false; }
+            vector::multiply(abs_sqr_fft_buffer_.data(), accu_fft_buffer_.data(),
+                             1.f / static_cast<float>(num_frames_), abs_sqr_fft_buffer_.size());
+            num_frames_ = 0;
+            return true;
         }
 
         void setON(const bool is_on) {
@@ -154,13 +132,131 @@ namespace zldsp::analyzer {
     protected:
         FFTAnalyzerProcessor& processor_;
 
-        std::vector<vector::aligned_vector<float>> circular_buffer_;
+        std::vector<vector::aligned_vector<float>> ring_buffer_;
         vector::aligned_vector<float> abs_sqr_fft_buffer_;
+        vector::aligned_vector<float> accu_fft_buffer_;
 
-        std::vector<float> states_;
+        std::vector<float> x_states_, y_states_;
+
+        size_t ring_mask_{0}, write_pos_{0};
+        size_t hop_size_{1}, num_pending_{0}, num_frames_{0};
+        StereoType stereo_type_{StereoType::kStereo};
 
         bool is_on_{false};
 
+        template <typename GetPointer>
+        void pullBlock(GetPointer&& get_pointer, size_t num_samples) {
+            size_t start_index = 0;
+            while (num_samples > 0) {
+                const auto num_to_write = std::min({
+                    num_samples, hop_size_ - num_pending_, ring_mask_ + 1 - write_pos_
+                });
+                for (size_t chan = 0; chan < ring_buffer_.size(); ++chan) {
+                    copyWithHighPass(ring_buffer_[chan].data() + write_pos_,
+                                     get_pointer(chan) + start_index,
+                                     num_to_write, y_states_[chan], x_states_[chan]);
+                }
+                write_pos_ = (write_pos_ + num_to_write) & ring_mask_;
+                num_pending_ += num_to_write;
+                start_index += num_to_write;
+                num_samples -= num_to_write;
+                if (num_pending_ == hop_size_) {
+                    num_pending_ = 0;
+                    runFrame();
+                }
+            }
+        }
+
+        void runFrame() {
+            auto& fft_in{processor_.getFFTIn()};
+            if (ring_buffer_.size() != 2 || stereo_type_ == StereoType::kStereo) {
+                for (size_t chan = 0; chan < ring_buffer_.size(); ++chan) {
+                    windowRing(fft_in.data(), ring_buffer_[chan].data());
+                    forwardAccumulate(fft_in.data(), num_frames_ == 0 && chan == 0);
+                }
+            } else {
+                switch (stereo_type_) {
+                case StereoType::kLeft: {
+                    windowRing(fft_in.data(), ring_buffer_[0].data());
+                    break;
+                }
+                case StereoType::kRight: {
+                    windowRing(fft_in.data(), ring_buffer_[1].data());
+                    break;
+                }
+                case StereoType::kMid: {
+                    windowRingMS<true>(fft_in.data(), ring_buffer_[0].data(), ring_buffer_[1].data());
+                    break;
+                }
+                case StereoType::kSide:
+                case StereoType::kStereo: {
+                    windowRingMS<false>(fft_in.data(), ring_buffer_[0].data(), ring_buffer_[1].data());
+                    break;
+                }
+                }
+                forwardAccumulate(fft_in.data(), num_frames_ == 0);
+            }
+            num_frames_ += 1;
+        }
+
+        /**
+         * run forward FFT and add the absolute square spectrum to the accumulator
+         * @param fft_in
+         * @param overwrite whether to overwrite the accumulator instead
+         */
+        void forwardAccumulate(float* fft_in, const bool overwrite) {
+            if (overwrite) {
+                processor_.forwardSqrMag(fft_in, accu_fft_buffer_.data());
+            } else {
+                auto& fft_out{processor_.getFFTOut()};
+                processor_.forwardSqrMag(fft_in, fft_out.data());
+                vector::add(accu_fft_buffer_.data(), fft_out.data(), fft_out.size());
+            }
+        }
+
+        /**
+         * multiply the ring buffer with the window, the oldest sample sits at the write position
+         * @param out
+         * @param ring
+         */
+        void windowRing(float* __restrict out, const float* __restrict ring) const {
+            const auto& window{processor_.getWindow()};
+            const auto num_tail = window.size() - write_pos_;
+            vector::multiply(out, ring + write_pos_, window.data(), num_tail);
+            vector::multiply(out + num_tail, ring, window.data() + num_tail, write_pos_);
+        }
+
+        template <bool IsMid>
+        void windowRingMS(float* __restrict out, const float* __restrict ring0, const float* __restrict ring1) const {
+            const auto& window{processor_.getWindow()};
+            const auto num_tail = window.size() - write_pos_;
+            multiplyMS<IsMid>(out, ring0 + write_pos_, ring1 + write_pos_, window.data(), num_tail);
+            multiplyMS<IsMid>(out + num_tail, ring0, ring1, window.data() + num_tail, write_pos_);
+        }
+
+        template <bool IsMid>
+        static void multiplyMS(float* __restrict out,
+                               const float* __restrict in0, const float* __restrict in1,
+                               const float* __restrict window, const size_t num_samples) {
+            static constexpr hn::ScalableTag<float> d;
+            static constexpr size_t lanes = hn::MaxLanes(d);
+            const auto v_sqrt_over_2 = hn::Set(d, kSqrt2Over2);
+            size_t j = 0;
+            for (; j + lanes <= num_samples; j += lanes) {
+                const auto v_in0 = hn::LoadU(d, in0 + j);
+                const auto v_in1 = hn::LoadU(d, in1 + j);
+                const auto v_window = hn::LoadU(d, window + j);
+                const auto v_out = IsMid
+                                       ? hn::Mul(hn::Add(v_in0, v_in1), v_sqrt_over_2)
+                                       : hn::Mul(hn::Sub(v_in0, v_in1), v_sqrt_over_2);
+                hn::StoreU(hn::Mul(v_out, v_window), d, out + j);
+            }
+            for (; j < num_samples; ++j) {
+                const auto v = IsMid ? (in0[j] + in1[j]) : (in0[j] - in1[j]);
+                out[j] = v * kSqrt2Over2 * window[j];
+            }
+        }
+
         static void copyWithHighPass(float* __restrict output, const float* __restrict input,
                                      const size_t num_samples,
                                      float& y, float& x) {
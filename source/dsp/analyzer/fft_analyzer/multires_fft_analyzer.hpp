@@ -0,0 +1,190 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "fft_analyzer_receiver.hpp"
+#include "spectrum_smoother.hpp"
+#include "../../over_sample/halfband_decimator.hpp"
+
+namespace zldsp::analyzer {
+    /**
+     * a multi-resolution (constant-Q style) FFT analyzer
+     * it runs FFTs of the same size on a chain of halfband-decimated signals, so that lower frequencies
+     * get longer effective windows, and stitches the smoothed spectrums onto one frequency grid
+     * @tparam kNumLevels number of resolutions, level l runs at sample_rate / 2^l
+     */
+    template <size_t kNumLevels>
+    class MultiResFFTAnalyzer {
+    public:
+        static_assert(kNumLevels >= 2);
+        // maximum number of input samples processed by the decimation chain at once
+        static constexpr size_t kMaxBlockSize = 1024;
+        // a level is used up to this ratio of its sample rate, well below the halfband transition band
+        static constexpr double kPassbandRatio = 0.2;
+
+        explicit MultiResFFTAnalyzer() {
+            receivers_.reserve(kNumLevels);
+            for (auto& processor : processors_) {
+                receivers_.emplace_back(processor);
+            }
+        }
+
+        /**
+         *
+         * @param fft_order FFT order of every level
+         * @param num_channels number of channels
+         * @param sample_rate sample rate of the input
+         * @param overlap number of frames that overlap each other
+         */
+        void prepare(const int fft_order, const size_t num_channels, const double sample_rate, const size_t overlap) {
+            sample_rate_ = sample_rate;
+            for (size_t l = 0; l < kNumLevels; ++l) {
+                processors_[l].prepare(fft_order);
+                receivers_[l].prepare(num_channels, processors_[l].getFFTSize() / overlap);
+                receivers_[l].setON(true);
+                smoothers_[l].prepare(processors_[l].getFFTSize());
+            }
+            in_views_.resize(num_channels);
+            for (size_t l = 0; l + 1 < kNumLevels; ++l) {
+                const auto max_num_samples = kMaxBlockSize >> l;
+                decimators_[l].prepare(num_channels, max_num_samples);
+                level_buffers_[l].resize(num_channels);
+                level_pointers_[l].resize(num_channels);
+                level_views_[l].resize(num_channels);
+                for (size_t chan = 0; chan < num_channels; ++chan) {
+                    level_buffers_[l][chan].resize(max_num_samples / 2 + 1);
+                    level_pointers_[l][chan] = level_buffers_[l][chan].data();
+                    level_views_[l][chan] = level_buffers_[l][chan].data();
+                }
+            }
+        }
+
+        /**
+         * reset internal states
+         */
+        void reset() {
+            for (auto& receiver : receivers_) {
+                receiver.reset();
+            }
+            for (auto& decimator : decimators_) {
+                decimator.reset();
+            }
+        }
+
+        /**
+         * assign each grid point to the most decimated level whose passband covers it
+         * and precompute the smoothing tables. must be called after prepare
+         * @param smooth smooth width, in octaves or in ERBs
+         * @param method
+         * @param grid_freqs ascending frequencies of the grid points
+         */
+        void setGrid(const double smooth, const SpectrumSmoother::SmoothMethod method,
+                     const std::span<const float> grid_freqs) {
+            size_t grid_end = grid_freqs.size();
+            for (size_t l = 0; l < kNumLevels; ++l) {
+                const auto level_sample_rate = sample_rate_ / static_cast<double>(1 << l);
+                size_t grid_start = 0;
+                if (l + 1 < kNumLevels) {
+                    const auto next_max_freq = kPassbandRatio * level_sample_rate * 0.5;
+                    while (grid_start < grid_end && static_cast<double>(grid_freqs[grid_start]) <= next_max_freq) {
+                        ++grid_start;
+                    }
+                }
+                grid_starts_[l] = grid_start;
+                grid_ends_[l] = grid_end;
+                smoothers_[l].setGrid(smooth, level_sample_rate, method,
+                                      grid_freqs.subspan(grid_start, grid_end - grid_start));
+                grid_end = grid_start;
+            }
+        }
+
+        /**
+         * pull data from FIFO, feed the decimation chain and run forward FFTs for every completed hop
+         * @param range
+         * @param sample_fifo
+         */
+        void pull(const zldsp::container::FIFORange range,
+                  const std::vector<std::vector<float>>& sample_fifo) {
+            if (range.block_size1 > 0) {
+                pullBlock(sample_fifo, static_cast<size_t>(range.start_index1), static_cast<size_t>(range.block_size1));
+            }
+            if (range.block_size2 > 0) {
+                pullBlock(sample_fifo, static_cast<size_t>(range.start_index2), static_cast<size_t>(range.block_size2));
+            }
+        }
+
+        /**
+         * stitch the smoothed spectrums of all levels onto the grid
+         * @param grid_out
+         * @return whether any level has a new frame
+         */
+        bool updateSpectrum(const std::span<float> grid_out) {
+            bool is_updated = false;
+            for (auto& receiver : receivers_) {
+                is_updated = receiver.updateSpectrum() || is_updated;
+            }
+            if (!is_updated) {
+                return false;
+            }
+            for (size_t l = 0; l < kNumLevels; ++l) {
+                const auto num_points = grid_ends_[l] - grid_starts_[l];
+                if (num_points == 0) {
+                    continue;
+                }
+                const auto level_out = grid_out.subspan(grid_starts_[l], num_points);
+                smoothers_[l].smoothToGrid(receivers_[l].getAbsSqrFFTBuffer(), level_out);
+                // halving the sample rate doubles the number of bins within a smoothing kernel
+                if (l > 0) {
+                    vector::multiply(level_out.data(), static_cast<float>(1 << l), num_points);
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @return the hop size of the fastest level in input samples
+         */
+        [[nodiscard]] size_t getHopSize() const {
+            return receivers_[0].getHopSize();
+        }
+
+    private:
+        double sample_rate_{48000.0};
+        std::array<FFTAnalyzerProcessor, kNumLevels> processors_;
+        std::vector<FFTAnalyzerReceiver> receivers_;
+        std::array<SpectrumSmoother, kNumLevels> smoothers_;
+        std::array<size_t, kNumLevels> grid_starts_{}, grid_ends_{};
+
+        std::array<oversample::HalfbandDecimator<float>, kNumLevels - 1> decimators_;
+        std::array<std::vector<vector::aligned_vector<float>>, kNumLevels - 1> level_buffers_;
+        std::array<std::vector<float*>, kNumLevels - 1> level_pointers_;
+        std::array<std::vector<const float*>, kNumLevels - 1> level_views_;
+        std::vector<const float*> in_views_;
+
+        void pullBlock(const std::vector<std::vector<float>>& sample_fifo, size_t start_index, size_t num_samples) {
+            while (num_samples > 0) {
+                const auto num_block = std::min(num_samples, kMaxBlockSize);
+                for (size_t chan = 0; chan < in_views_.size(); ++chan) {
+                    in_views_[chan] = sample_fifo[chan].data() + start_index;
+                }
+                receivers_[0].pull(in_views_, num_block);
+                auto level_num = num_block;
+                for (size_t l = 1; l < kNumLevels; ++l) {
+                    const auto& in = l == 1 ? in_views_ : level_views_[l - 2];
+                    level_num = decimators_[l - 1].process(in, level_pointers_[l - 1], level_num);
+                    receivers_[l].pull(level_views_[l - 1], level_num);
+                }
+                start_index += num_block;
+                num_samples -= num_block;
+            }
+        }
+    };
+}
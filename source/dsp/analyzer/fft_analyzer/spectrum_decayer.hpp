@@ -24,6 +24,15 @@ namespace zldsp::analyzer {
             std::ranges::fill(state_.begin(), state_.end(), -240.f);
         }
 
+        /**
+         * prepare for a spectrum of arbitrary size, e.g., a smoothed display grid
+         * @param num_points
+         */
+        void prepareGrid(const size_t num_points) {
+            state_.resize(num_points);
+            std::ranges::fill(state_.begin(), state_.end(), -240.f);
+        }
+
         void setDecaySpeed(const float refresh_rate, const float min_db, const float decay_second) {
             constexpr float floor_db = -120.0f;
             constexpr float start_db = 0.0f;
@@ -14,6 +14,8 @@
 #include <cmath>
 #include <algorithm>
 
+#include "../../vector/vector.hpp"
+
 namespace zldsp::analyzer {
     class SpectrumSmoother {
     public:
@@ -89,11 +91,84 @@ namespace zldsp::analyzer {
             applyBoxcarAverage(spectrum_abs_sqr, 0, spectrum_abs_sqr.size(), 0, spectrum_abs_sqr.size());
         }
 
+        /**
+         * precompute the bin weights which smooth the spectrum directly onto a frequency grid
+         * the triangular kernel matches two boxcar passes, and falls back to linear interpolation
+         * when it is narrower than a bin. must be called after prepare
+         * @param smooth smooth width, in octaves or in ERBs
+         * @param sample_rate
+         * @param method
+         * @param grid_freqs frequencies of the grid points
+         */
+        void setGrid(const double smooth, const double sample_rate, const SmoothMethod method,
+                     const std::span<const float> grid_freqs) {
+            const auto num_bins = low_idx_.size();
+            const auto delta_f = sample_rate / static_cast<double>((num_bins - 1) * 2);
+            const auto max_idx_dbl = static_cast<double>(num_bins - 1);
+            grid_start_.resize(grid_freqs.size());
+            grid_offset_.resize(grid_freqs.size() + 1);
+            grid_weights_.clear();
+            grid_offset_[0] = 0;
+            for (size_t i = 0; i < grid_freqs.size(); ++i) {
+                const auto center = std::min(static_cast<double>(grid_freqs[i]) / delta_f, max_idx_dbl);
+                double lower_width{1.0}, upper_width{1.0};
+                switch (method) {
+                case SmoothMethod::kOCT: {
+                    const auto factor = std::pow(2.0, smooth);
+                    lower_width = center - center / factor;
+                    upper_width = center * factor - center;
+                    break;
+                }
+                case SmoothMethod::kERB: {
+                    const auto erb_bins = 0.107939 * center + 24.7 / delta_f;
+                    lower_width = erb_bins * smooth;
+                    upper_width = lower_width;
+                    break;
+                }
+                }
+                lower_width = std::max(lower_width, 1.0);
+                upper_width = std::max(upper_width, 1.0);
+
+                const auto start = static_cast<size_t>(std::max(0.0, std::floor(center - lower_width) + 1.0));
+                const auto end = std::min(num_bins, static_cast<size_t>(std::ceil(center + upper_width)));
+                const auto offset = grid_weights_.size();
+                double weight_sum = 0.0;
+                for (size_t k = start; k < end; ++k) {
+                    const auto dist = static_cast<double>(k) - center;
+                    const auto weight = dist < 0.0 ? 1.0 + dist / lower_width : 1.0 - dist / upper_width;
+                    grid_weights_.push_back(static_cast<float>(std::max(weight, 0.0)));
+                    weight_sum += std::max(weight, 0.0);
+                }
+                const auto weight_scale = static_cast<float>(1.0 / std::max(weight_sum, 1e-12));
+                for (size_t k = offset; k < grid_weights_.size(); ++k) {
+                    grid_weights_[k] *= weight_scale;
+                }
+                grid_start_[i] = start;
+                grid_offset_[i + 1] = grid_weights_.size();
+            }
+        }
+
+        /**
+         * smooth the spectrum onto the grid set by setGrid
+         * @param spectrum_abs_sqr
+         * @param grid_out
+         */
+        void smoothToGrid(const std::span<const float> spectrum_abs_sqr, const std::span<float> grid_out) const {
+            for (size_t i = 0; i < grid_start_.size(); ++i) {
+                grid_out[i] = vector::dot_product(spectrum_abs_sqr.data() + grid_start_[i],
+                                                  grid_weights_.data() + grid_offset_[i],
+                                                  grid_offset_[i + 1] - grid_offset_[i]);
+            }
+        }
+
     protected:
         std::vector<size_t> low_idx_, high_idx_;
         std::vector<float> count_req_;
         std::vector<double> temp_cum_sum_;
 
+        std::vector<size_t> grid_start_, grid_offset_;
+        vector::aligned_vector<float> grid_weights_;
+
         void applyBoxcarAverage(const std::span<float> data,
                                 const size_t source_start, const size_t source_end,
                                 const size_t target_start, const size_t target_end) {
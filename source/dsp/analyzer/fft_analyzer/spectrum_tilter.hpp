@@ -22,6 +22,11 @@ namespace zldsp::analyzer {
             tilt_shift_.resize(fft_size / 2 + 1);
         }
 
+        /**
+         * set the tilt slope on the linear FFT bins
+         * @param sample_rate
+         * @param slope_per_oct
+         */
         void setTiltSlope(const double sample_rate, const double slope_per_oct) {
             const auto delta = sample_rate * 0.5 / static_cast<double>(tilt_shift_.size() - 1);
             for (size_t i = 1; i < tilt_shift_.size(); ++i) {
@@ -31,6 +36,18 @@ namespace zldsp::analyzer {
             tilt_shift_[0] = tilt_shift_[1];
         }
 
+        /**
+         * set the tilt slope on arbitrary frequency points, e.g., a smoothed display grid
+         * @param freqs
+         * @param slope_per_oct
+         */
+        void setTiltSlope(const std::span<const float> freqs, const double slope_per_oct) {
+            tilt_shift_.resize(freqs.size());
+            for (size_t i = 0; i < freqs.size(); ++i) {
+                tilt_shift_[i] = static_cast<float>(std::log2(static_cast<double>(freqs[i]) / 1000.0) * slope_per_oct);
+            }
+        }
+
         void tilt(std::span<float> spectrum_db) {
             vector::add(spectrum_db.data(), tilt_shift_.data(), spectrum_db.size());
         }
@@ -0,0 +1,225 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+#include "decibels.hpp"
+#include "../vector/vector.hpp"
+
+/**
+ * decibel/gain conversions based on log2/exp2 polynomials with selectable error bounds
+ * the exponent is taken from the float bits, the mantissa goes through a polynomial fitted at Chebyshev nodes
+ * the fast paths are float only, double values and Precision::kExact fall back to the accurate functions
+ */
+namespace zldsp::chore::fast_db {
+    namespace hn = hwy::HWY_NAMESPACE;
+
+    enum class Precision {
+        kExact, // libm/Highway math
+        kMilliDecibel, // the error is below 0.001 dB
+        kCentiDecibel // the error is below 0.01 dB
+    };
+
+    namespace internal {
+        inline constexpr float kLog2ToDecibels = 6.0205999132796239f;
+        inline constexpr float kLog2ToSquareDecibels = 3.0102999566398120f;
+        inline constexpr float kDecibelsToLog2 = 0.16609640474436813f;
+
+        // log2(1 + t) = t * p(t) on [0, 1), the error is 2.2e-5 (1.3e-4 dB) / 1.1e-3 (6.5e-3 dB)
+        inline constexpr std::array kLog2Milli{
+            1.44171213f, -0.707462216f, 0.411385787f, -0.189207475f, 0.0435811869f
+        };
+        inline constexpr std::array kLog2Centi{
+            1.42037967f, -0.576593828f, 0.1567217f
+        };
+        // 2^t = 1 + t * p(t) on [0, 1), the relative error is 4.6e-6 (4.0e-5 dB) / 1.3e-4 (1.1e-3 dB)
+        inline constexpr std::array kExp2Milli{
+            0.693004835f, 0.241511274f, 0.051853338f, 0.013626545f
+        };
+        inline constexpr std::array kExp2Centi{
+            0.695753835f, 0.225646202f, 0.0784814899f
+        };
+
+        template <Precision P>
+        constexpr const auto& getLog2Coeffs() {
+            if constexpr (P == Precision::kMilliDecibel) {
+                return kLog2Milli;
+            } else {
+                return kLog2Centi;
+            }
+        }
+
+        template <Precision P>
+        constexpr const auto& getExp2Coeffs() {
+            if constexpr (P == Precision::kMilliDecibel) {
+                return kExp2Milli;
+            } else {
+                return kExp2Centi;
+            }
+        }
+
+        template <size_t N>
+        inline float evalPoly(const std::array<float, N>& coeffs, const float t) {
+            auto p = coeffs[N - 1];
+            for (size_t k = N - 1; k > 0; --k) {
+                p = p * t + coeffs[k - 1];
+            }
+            return p;
+        }
+
+        template <size_t N, class D, class V = hn::VFromD<D>>
+        HWY_INLINE V evalPoly(D d, const std::array<float, N>& coeffs, const V t) {
+            auto p = hn::Set(d, coeffs[N - 1]);
+            for (size_t k = N - 1; k > 0; --k) {
+                p = hn::MulAdd(p, t, hn::Set(d, coeffs[k - 1]));
+            }
+            return p;
+        }
+
+        /**
+         * @param x a positive normal float
+         */
+        template <Precision P>
+        inline float log2(const float x) {
+            const auto bits = std::bit_cast<uint32_t>(x);
+            const auto e = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+            const auto t = std::bit_cast<float>((bits & 0x007fffffu) | 0x3f800000u) - 1.f;
+            return t * evalPoly(getLog2Coeffs<P>(), t) + e;
+        }
+
+        template <Precision P>
+        inline float exp2(float x) {
+            x = std::clamp(x, -126.f, 126.f);
+            const auto i = std::floor(x);
+            const auto t = x - i;
+            const auto p = t * evalPoly(getExp2Coeffs<P>(), t) + 1.f;
+            // add the integer part to the exponent bits
+            return std::bit_cast<float>(std::bit_cast<uint32_t>(p)
+                + (static_cast<uint32_t>(static_cast<int32_t>(i)) << 23));
+        }
+
+        template <Precision P, class D, class V = hn::VFromD<D>>
+        HWY_INLINE V log2(D d, const V x) {
+            const hn::RebindToSigned<D> di;
+            const auto bits = hn::BitCast(di, x);
+            const auto e = hn::ConvertTo(d, hn::Sub(hn::ShiftRight<23>(bits), hn::Set(di, 127)));
+            const auto m = hn::Or(hn::And(bits, hn::Set(di, 0x007fffff)), hn::Set(di, 0x3f800000));
+            const auto t = hn::Sub(hn::BitCast(d, m), hn::Set(d, 1.f));
+            return hn::MulAdd(t, evalPoly(d, getLog2Coeffs<P>(), t), e);
+        }
+
+        template <Precision P, class D, class V = hn::VFromD<D>>
+        HWY_INLINE V exp2(D d, V x) {
+            const hn::RebindToSigned<D> di;
+            x = hn::Clamp(x, hn::Set(d, -126.f), hn::Set(d, 126.f));
+            const auto i = hn::Floor(x);
+            const auto t = hn::Sub(x, i);
+            const auto p = hn::MulAdd(t, evalPoly(d, getExp2Coeffs<P>(), t), hn::Set(d, 1.f));
+            const auto exponent = hn::ShiftLeft<23>(hn::ConvertTo(di, i));
+            return hn::BitCast(d, hn::Add(hn::BitCast(di, p), exponent));
+        }
+    }
+
+    template <Precision P, typename FloatType>
+    FloatType gainToDecibels(const FloatType value) {
+        if constexpr (P == Precision::kExact || !std::is_same_v<FloatType, float>) {
+            return chore::gainToDecibels(value);
+        } else {
+            return internal::kLog2ToDecibels * internal::log2<P>(std::max(value, 1e-12f));
+        }
+    }
+
+    template <Precision P, typename FloatType>
+    FloatType squareGainToDecibels(const FloatType value) {
+        if constexpr (P == Precision::kExact || !std::is_same_v<FloatType, float>) {
+            return chore::squareGainToDecibels(value);
+        } else {
+            return internal::kLog2ToSquareDecibels * internal::log2<P>(std::max(value, 1e-24f));
+        }
+    }
+
+    template <Precision P, typename FloatType>
+    FloatType decibelsToGain(const FloatType value) {
+        if constexpr (P == Precision::kExact || !std::is_same_v<FloatType, float>) {
+            return chore::decibelsToGain(value);
+        } else {
+            return internal::exp2<P>(value * internal::kDecibelsToLog2);
+        }
+    }
+
+    /**
+     * SIMD variant of gainToDecibels
+     */
+    template <Precision P, class D, class V = hn::VFromD<D>>
+    HWY_INLINE V gainToDecibels(D d, const V value) {
+        using T = hn::TFromD<D>;
+        const auto x = hn::Max(value, hn::Set(d, static_cast<T>(kLogMin)));
+        if constexpr (P == Precision::kExact || !std::is_same_v<T, float>) {
+            return hn::Mul(hn::Log(d, x), hn::Set(d, static_cast<T>(kLogMul)));
+        } else {
+            return hn::Mul(internal::log2<P>(d, x), hn::Set(d, internal::kLog2ToDecibels));
+        }
+    }
+
+    /**
+     * SIMD variant of squareGainToDecibels
+     */
+    template <Precision P, class D, class V = hn::VFromD<D>>
+    HWY_INLINE V squareGainToDecibels(D d, const V value) {
+        using T = hn::TFromD<D>;
+        const auto x = hn::Max(value, hn::Set(d, static_cast<T>(kLogSqrMin)));
+        if constexpr (P == Precision::kExact || !std::is_same_v<T, float>) {
+            return hn::Mul(hn::Log(d, x), hn::Set(d, static_cast<T>(kLogSqrMul)));
+        } else {
+            return hn::Mul(internal::log2<P>(d, x), hn::Set(d, internal::kLog2ToSquareDecibels));
+        }
+    }
+
+    /**
+     * SIMD variant of decibelsToGain
+     */
+    template <Precision P, class D, class V = hn::VFromD<D>>
+    HWY_INLINE V decibelsToGain(D d, const V value) {
+        using T = hn::TFromD<D>;
+        if constexpr (P == Precision::kExact || !std::is_same_v<T, float>) {
+            return hn::Exp(d, hn::Mul(value, hn::Set(d, static_cast<T>(0.11512925464970229))));
+        } else {
+            return internal::exp2<P>(d, hn::Mul(value, hn::Set(d, internal::kDecibelsToLog2)));
+        }
+    }
+
+    /**
+     * convert a buffer of magnitudes to decibels in place
+     * @param buffer the magnitudes
+     * @param num_samples the number of samples
+     */
+    template <Precision P, typename FloatType>
+    void magToDecibels(FloatType* __restrict buffer, const size_t num_samples) {
+        if constexpr (P == Precision::kExact || !std::is_same_v<FloatType, float>) {
+            vector::mag_to_db(buffer, num_samples);
+        } else {
+            static constexpr hn::ScalableTag<float> d;
+            static constexpr size_t lanes = hn::MaxLanes(d);
+            size_t i = 0;
+            for (; i + lanes <= num_samples; i += lanes) {
+                hn::StoreU(gainToDecibels<P>(d, hn::LoadU(d, buffer + i)), d, buffer + i);
+            }
+            for (; i < num_samples; ++i) {
+                buffer[i] = gainToDecibels<P>(buffer[i]);
+            }
+        }
+    }
+}
@@ -74,6 +74,45 @@ namespace zldsp::chore {
 
         [[nodiscard]] bool isSmoothing() const { return count_ > 0; }
 
+        /**
+         * get the step of the next sample, which is an increment for linear types and a ratio for multiplicative types
+         * @return
+         */
+        FloatType getStep() const {
+            if constexpr (kSmoothedType == kLin || kSmoothedType == kMul) {
+                return inc_;
+            } else {
+                return is_increasing_ ? increase_inc_ : decrease_inc_;
+            }
+        }
+
+        /**
+         * advance the smoothed value by several samples at once
+         * @param num_samples
+         */
+        void skip(const size_t num_samples) {
+            if (count_ == 0) { return; }
+            if constexpr (kSmoothedType == kLin) {
+                const auto num_steps = std::min(static_cast<int>(num_samples), count_);
+                current_ += inc_ * static_cast<FloatType>(num_steps);
+                count_ -= num_steps;
+            } else if constexpr (kSmoothedType == kMul) {
+                const auto num_steps = std::min(static_cast<int>(num_samples), count_);
+                current_ *= std::pow(inc_, static_cast<FloatType>(num_steps));
+                count_ -= num_steps;
+            } else {
+                if constexpr (kSmoothedType == kFixLin) {
+                    current_ += getStep() * static_cast<FloatType>(num_samples);
+                } else {
+                    current_ *= std::pow(getStep(), static_cast<FloatType>(num_samples));
+                }
+                if (is_increasing_ ? current_ > target_ : current_ < target_) {
+                    current_ = target_;
+                    count_ = 0;
+                }
+            }
+        }
+
         FloatType getNext() {
             if (count_ == 0) { return current_; }
             if constexpr (kSmoothedType == kLin) {
@@ -63,6 +63,25 @@ namespace zldsp::compressor {
             }
         }
 
+        /**
+         * SIMD variant of eval, each lane is evaluated independently
+         */
+        template <class D, class V = hn::VFromD<D>>
+        HWY_INLINE V eval(D d, const V x) const {
+            const auto mid = hn::MulAdd(hn::MulAdd(hn::Set(d, para_mid_g0_[0]), x, hn::Set(d, para_mid_g0_[1])),
+                                        x, hn::Set(d, para_mid_g0_[2]));
+            const auto high = hn::MulAdd(hn::MulAdd(hn::Set(d, para_high_g0_[0]), x, hn::Set(d, para_high_g0_[1])),
+                                         x, hn::Set(d, para_high_g0_[2]));
+            const auto over = hn::MulAdd(hn::Set(d, para_over_g0_[0]), x, hn::Set(d, para_over_g0_[1]));
+            auto y = hn::IfThenElse(hn::Lt(x, hn::Zero(d)), high, over);
+            y = hn::IfThenElse(hn::Lt(x, hn::Set(d, high_th_)), mid, y);
+            if constexpr (OutputDiff) {
+                return hn::IfThenElse(hn::Le(x, hn::Set(d, low_th_)), hn::Zero(d), y);
+            } else {
+                return hn::IfThenElse(hn::Le(x, hn::Set(d, low_th_)), x, y);
+            }
+        }
+
         inline void setThreshold(FloatType v) {
             threshold_.store(v, std::memory_order::relaxed);
             to_interpolate_.store(true, std::memory_order::release);
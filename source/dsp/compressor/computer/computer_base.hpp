@@ -9,7 +9,11 @@
 
 #pragma once
 
+#include "../../vector/highway_import.hpp"
+
 namespace zldsp::compressor {
+    namespace hn = hwy::HWY_NAMESPACE;
+
     template <typename FloatType>
     class ComputerBase {
     public:
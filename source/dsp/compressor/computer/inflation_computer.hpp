@@ -67,6 +67,25 @@ namespace zldsp::compressor {
             }
         }
 
+        /**
+         * SIMD variant of eval, each lane is evaluated independently
+         */
+        template <class D, class V = hn::VFromD<D>>
+        HWY_INLINE V eval(D d, const V x) const {
+            const auto mid = hn::MulAdd(hn::MulAdd(hn::Set(d, para_mid_g0_[0]), x, hn::Set(d, para_mid_g0_[1])),
+                                        x, hn::Set(d, para_mid_g0_[2]));
+            const auto x_s = hn::Sub(x, hn::Set(d, c_floor_));
+            auto low = hn::Mul(hn::MulAdd(hn::Set(d, para_low_g0_[0]), x_s, hn::Set(d, para_low_g0_[1])),
+                               hn::Mul(x_s, x_s));
+            const auto pass = OutputDiff ? hn::Zero(d) : x;
+            if constexpr (!OutputDiff) {
+                low = hn::Add(low, x);
+            }
+            auto y = hn::IfThenElse(hn::Gt(x, hn::Set(d, c_floor_)), low, pass);
+            y = hn::IfThenElse(hn::Gt(x, hn::Set(d, low_th_)), mid, y);
+            return hn::IfThenElse(hn::Ge(x, hn::Set(d, high_th_)), pass, y);
+        }
+
         void setThreshold(const FloatType v) {
             threshold_.store(v, std::memory_order::relaxed);
             to_interpolate_.store(true, std::memory_order::release);
@@ -13,8 +13,14 @@
 #include <numbers>
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <span>
+
+#include "../../vector/highway_import.hpp"
 
 namespace zldsp::compressor {
+    namespace hn = hwy::HWY_NAMESPACE;
+
     enum class PPState { kOff, kPunch, kPump };
 
     enum class SState { kOff, kFull, kMix };
@@ -23,6 +29,9 @@ namespace zldsp::compressor {
      * a punch-smooth follower
      * @tparam FloatType
      */
+    template <class D>
+    class PSFollowerLanes;
+
     template <typename FloatType>
     class PSFollower final {
     public:
@@ -134,6 +143,9 @@ namespace zldsp::compressor {
         }
 
     private:
+        template <class D>
+        friend class PSFollowerLanes;
+
         FloatType y_{}, state_{}, slope_{};
         FloatType attack_{}, release_{};
 
@@ -188,4 +200,89 @@ namespace zldsp::compressor {
             }
         }
     };
+
+    /**
+     * several punch-smooth followers whose states live in the lanes of one SIMD register
+     * the states are loaded on construction and written back by store
+     * all lanes use the parameters of the first follower
+     * @tparam D the SIMD tag, one lane per follower
+     */
+    template <class D>
+    class PSFollowerLanes final {
+    public:
+        using FloatType = hn::TFromD<D>;
+        using V = hn::VFromD<D>;
+        static constexpr size_t kLanes = hn::MaxLanes(D{});
+
+        explicit PSFollowerLanes(std::span<PSFollower<FloatType>* const> followers) :
+            followers_(followers) {
+            static constexpr D d;
+            alignas(64) std::array<FloatType, kLanes> y{}, state{}, slope{};
+            for (size_t i = 0; i < followers.size(); ++i) {
+                y[i] = followers[i]->y_;
+                state[i] = followers[i]->state_;
+                slope[i] = followers[i]->slope_;
+            }
+            y_ = hn::Load(d, y.data());
+            state_ = hn::Load(d, state.data());
+            slope_ = hn::Load(d, slope.data());
+            const auto& f = *followers[0];
+            attack_ = hn::Set(d, f.attack_);
+            release_ = hn::Set(d, f.release_);
+            smooth_ = hn::Set(d, f.smooth_);
+            pp_ = hn::Set(d, f.pp_);
+        }
+
+        /**
+         * write the states back to the followers
+         */
+        void store() const {
+            static constexpr D d;
+            alignas(64) std::array<FloatType, kLanes> y{}, state{}, slope{};
+            hn::Store(y_, d, y.data());
+            hn::Store(state_, d, state.data());
+            hn::Store(slope_, d, slope.data());
+            for (size_t i = 0; i < followers_.size(); ++i) {
+                followers_[i]->y_ = y[i];
+                followers_[i]->state_ = state[i];
+                followers_[i]->slope_ = slope[i];
+            }
+        }
+
+        template <PPState pp_state = PPState::kOff, SState s_state = SState::kOff>
+        HWY_INLINE V processSample(const V x) {
+            static constexpr D d;
+            V y0;
+            if constexpr (s_state == SState::kOff) {
+                y0 = hn::MulAdd(hn::IfThenElse(hn::Ge(x, y_), attack_, release_), hn::Sub(y_, x), x);
+            } else if constexpr (s_state == SState::kFull) {
+                state_ = hn::Max(x, hn::MulAdd(release_, hn::Sub(state_, x), x));
+                y0 = hn::MulAdd(attack_, hn::Sub(y_, state_), state_);
+            } else {
+                state_ = hn::Max(x, hn::MulAdd(release_, hn::Sub(state_, x), x));
+                const auto y1 = hn::MulAdd(attack_, hn::Sub(y_, state_), state_);
+                const auto y2 = hn::MulAdd(hn::IfThenElse(hn::Ge(x, y_), attack_, release_), hn::Sub(y_, x), x);
+                y0 = hn::MulAdd(smooth_, hn::Sub(y1, y2), y2);
+            }
+            if constexpr (pp_state == PPState::kPump) {
+                const auto slope0 = hn::Sub(y0, y_);
+                slope_ = hn::IfThenElse(hn::Lt(slope0, slope_),
+                                        hn::MulAdd(pp_, hn::Sub(slope_, slope0), slope0), slope0);
+                y_ = hn::Add(y_, slope_);
+            } else if constexpr (pp_state == PPState::kPunch) {
+                const auto slope0 = hn::Sub(y0, y_);
+                const auto to_smooth = hn::And(hn::Gt(slope0, slope_), hn::Ge(slope_, hn::Zero(d)));
+                slope_ = hn::IfThenElse(to_smooth, hn::MulAdd(pp_, hn::Sub(slope_, slope0), slope0), slope0);
+                y_ = hn::Add(y_, slope_);
+            } else {
+                y_ = y0;
+            }
+            return y_;
+        }
+
+    private:
+        std::span<PSFollower<FloatType>* const> followers_;
+        V y_, state_, slope_;
+        V attack_, release_, smooth_, pp_;
+    };
 }
@@ -9,12 +9,19 @@
 
 #pragma once
 
-#include "../../chore/decibels.hpp"
+#include <algorithm>
+#include <array>
+
+#include "../../chore/fast_db.hpp"
 #include "../tracker/tracker.hpp"
 #include "../follower/follower.hpp"
 
 namespace zldsp::compressor {
-    template <typename FloatType>
+    /**
+     * @tparam FloatType the float type of input audio buffer
+     * @tparam P the precision of the dB/gain conversions inside the feedback loop
+     */
+    template <typename FloatType, chore::fast_db::Precision P = chore::fast_db::Precision::kExact>
     class ClassicCompressor final {
     public:
         ClassicCompressor() = default;
@@ -30,12 +37,12 @@ namespace zldsp::compressor {
                      FloatType* __restrict buffer, const size_t num_samples) {
             for (size_t i = 0; i < num_samples; ++i) {
                 FloatType input_db;
-                input_db = chore::gainToDecibels(std::abs(x0_));
+                input_db = chore::fast_db::gainToDecibels<P>(std::abs(x0_));
                 // pass through the computer and the follower
                 const auto smooth_reduction_db = -follower.template processSample<pp_state, s_state>(
                     -computer.eval(input_db));
                 // apply the gain on the current sample and save it as the feedback sample for the next
-                x0_ = buffer[i] * chore::decibelsToGain(smooth_reduction_db);
+                x0_ = buffer[i] * chore::fast_db::decibelsToGain<P>(smooth_reduction_db);
                 buffer[i] = smooth_reduction_db;
             }
         }
@@ -47,17 +54,77 @@ namespace zldsp::compressor {
                 FloatType input_db;
                 tracker.processSample(x0_);
                 // get the db from the tracker
-                input_db = tracker.getMomentaryDB();
+                input_db = tracker.template getMomentaryDB<P>();
                 // pass through the computer and the follower
                 const auto smooth_reduction_db = -follower.template processSample<pp_state, s_state>(
                     -computer.eval(input_db));
                 // apply the gain on the current sample and save it as the feedback sample for the next
-                x0_ = buffer[i] * chore::decibelsToGain(smooth_reduction_db);
+                x0_ = buffer[i] * chore::fast_db::decibelsToGain<P>(smooth_reduction_db);
                 buffer[i] = smooth_reduction_db;
             }
         }
 
+        /**
+         * process two channels at once, the feedback recursions of both channels run in the lanes of one register
+         * the computer is shared and both followers use the parameters of follower0
+         */
+        template <typename C, PPState pp_state = PPState::kOff, SState s_state = SState::kOff>
+        static void processStereo(C& computer, ClassicCompressor& comp0, ClassicCompressor& comp1,
+                                  PSFollower<FloatType>& follower0, PSFollower<FloatType>& follower1,
+                                  FloatType* __restrict buffer0, FloatType* __restrict buffer1,
+                                  const size_t num_samples) {
+            static constexpr LaneTag d;
+            const std::array followers{&follower0, &follower1};
+            PSFollowerLanes<LaneTag> lanes{followers};
+            alignas(64) std::array<FloatType, 2 * kChunkSize> interleaved{};
+            alignas(16) std::array<FloatType, 2> x0{comp0.x0_, comp1.x0_};
+            auto v_x0 = hn::Load(d, x0.data());
+            for (size_t start_idx = 0; start_idx < num_samples; start_idx += kChunkSize) {
+                const auto chunk = std::min(kChunkSize, num_samples - start_idx);
+                for (size_t i = 0; i < chunk; ++i) {
+                    interleaved[2 * i] = buffer0[start_idx + i];
+                    interleaved[2 * i + 1] = buffer1[start_idx + i];
+                }
+                processLanes<C, LaneTag, pp_state, s_state>(computer, lanes, v_x0, interleaved.data(), chunk);
+                for (size_t i = 0; i < chunk; ++i) {
+                    buffer0[start_idx + i] = interleaved[2 * i];
+                    buffer1[start_idx + i] = interleaved[2 * i + 1];
+                }
+            }
+            hn::Store(v_x0, d, x0.data());
+            comp0.x0_ = x0[0];
+            comp1.x0_ = x0[1];
+            lanes.store();
+        }
+
+        /**
+         * process several channels at once, e.g., the bands of a multiband compressor
+         * the samples of the channels are interleaved and their feedback recursions run in the lanes of one register
+         * @param x0 the feedback samples of the lanes
+         * @param buffer the interleaved samples, [sample][lane]
+         * @param num_samples the number of samples of each lane
+         */
+        template <typename C, class D, PPState pp_state = PPState::kOff, SState s_state = SState::kOff>
+        static void processLanes(C& computer, PSFollowerLanes<D>& followers, hn::VFromD<D>& x0,
+                                 FloatType* __restrict buffer, const size_t num_samples) {
+            static constexpr D d;
+            static constexpr size_t lanes = hn::MaxLanes(d);
+            for (size_t i = 0; i < num_samples; ++i) {
+                const auto input_db = chore::fast_db::gainToDecibels<P>(d, hn::Abs(x0));
+                // pass through the computer and the follower
+                const auto smooth_reduction_db = hn::Neg(followers.template processSample<pp_state, s_state>(
+                    hn::Neg(computer.eval(d, input_db))));
+                // apply the gain on the current samples and save them as the feedback samples for the next
+                auto* samples = buffer + i * lanes;
+                x0 = hn::Mul(hn::Load(d, samples), chore::fast_db::decibelsToGain<P>(d, smooth_reduction_db));
+                hn::Store(smooth_reduction_db, d, samples);
+            }
+        }
+
     private:
+        using LaneTag = hn::CappedTag<FloatType, 2>;
+        static constexpr size_t kChunkSize = 64;
+
         FloatType x0_{FloatType(0)};
     };
 }
@@ -61,10 +61,7 @@ namespace zldsp::compressor {
         static void process(C& computer, F& follower, RMSTracker<FloatType>& tracker,
                             FloatType* __restrict buffer, const size_t num_samples) {
             // pass through the tracker
-            for (size_t i = 0; i < num_samples; ++i) {
-                tracker.processSample(buffer[i]);
-                buffer[i] = tracker.getMomentarySquare();
-            }
+            tracker.processBlock(buffer, num_samples);
             // transfer square sum to db
             {
                 static constexpr hn::ScalableTag<FloatType> d;
@@ -97,5 +94,27 @@ namespace zldsp::compressor {
                     -computer.eval(buffer[i]));
             }
         }
+
+        /**
+         * process several detectors at once, e.g., the bands of a multiband compressor
+         * the samples of the detectors are interleaved and their followers run in the lanes of one register
+         * @param buffer the interleaved samples, [sample][lane]
+         * @param num_samples the number of samples of each lane
+         */
+        template <typename C, class D, PPState pp_state = PPState::kOff, SState s_state = SState::kOff>
+        static void processLanes(C& computer, PSFollowerLanes<D>& followers,
+                                 FloatType* __restrict buffer, const size_t num_samples) {
+            static constexpr D d;
+            static constexpr size_t lanes = hn::MaxLanes(d);
+            const auto v_min = hn::Set(d, static_cast<FloatType>(chore::kLogMin));
+            const auto v_multiplier = hn::Set(d, static_cast<FloatType>(chore::kLogMul));
+            for (size_t i = 0; i < num_samples; ++i) {
+                auto v = hn::Max(hn::Abs(hn::Load(d, buffer + i * lanes)), v_min);
+                v = hn::Mul(hn::CallLog(d, v), v_multiplier);
+                // pass through the computer and the follower
+                v = hn::Neg(followers.template processSample<pp_state, s_state>(hn::Neg(computer.eval(d, v))));
+                hn::Store(v, d, buffer + i * lanes);
+            }
+        }
     };
 }
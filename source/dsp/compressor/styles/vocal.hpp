@@ -9,13 +9,19 @@
 
 #pragma once
 
-#include "../../chore/decibels.hpp"
+#include <algorithm>
+#include <array>
+
+#include "../../chore/fast_db.hpp"
 #include "../tracker/tracker.hpp"
 #include "../follower/follower.hpp"
-#include "../../vector/vector.hpp"
 
 namespace zldsp::compressor {
-    template <typename FloatType>
+    /**
+     * @tparam FloatType the float type of input audio buffer
+     * @tparam P the precision of the dB/gain conversions inside the feedback loop
+     */
+    template <typename FloatType, chore::fast_db::Precision P = chore::fast_db::Precision::kExact>
     class VocalCompressor final {
     public:
         VocalCompressor() = default;
@@ -30,15 +36,15 @@ namespace zldsp::compressor {
         void process(C& computer, F& follower,
                      FloatType* __restrict buffer, const size_t num_samples) {
             for (size_t i = 0; i < num_samples; ++i) {
-                const FloatType input_db = chore::gainToDecibels(std::abs(x0_));
+                const FloatType input_db = chore::fast_db::gainToDecibels<P>(std::abs(x0_));
                 // pass through the computer and the follower
                 const auto smooth_reduction_gain = -follower.template processSample<pp_state, s_state>(
-                    -chore::decibelsToGain(computer.eval(input_db)));
+                    -chore::fast_db::decibelsToGain<P>(computer.eval(input_db)));
                 // apply the gain on the current sample and save it as the feedback sample for the next
                 x0_ = buffer[i] * smooth_reduction_gain;
                 buffer[i] = smooth_reduction_gain;
             }
-            vector::mag_to_db(buffer, num_samples);
+            chore::fast_db::magToDecibels<P>(buffer, num_samples);
         }
 
         template <typename C, typename F, PPState pp_state = PPState::kOff, SState s_state = SState::kOff>
@@ -47,18 +53,79 @@ namespace zldsp::compressor {
             for (size_t i = 0; i < num_samples; ++i) {
                 tracker.processSample(x0_);
                 // get the db from the tracker
-                const FloatType input_db = tracker.getMomentaryDB();
+                const FloatType input_db = tracker.template getMomentaryDB<P>();
                 // pass through the computer and the follower
                 const auto smooth_reduction_gain = -follower.template processSample<pp_state, s_state>(
-                    -chore::decibelsToGain(computer.eval(input_db)));
+                    -chore::fast_db::decibelsToGain<P>(computer.eval(input_db)));
                 // apply the gain on the current sample and save it as the feedback sample for the next
                 x0_ = buffer[i] * smooth_reduction_gain;
                 buffer[i] = smooth_reduction_gain;
             }
-            vector::mag_to_db(buffer, num_samples);
+            chore::fast_db::magToDecibels<P>(buffer, num_samples);
+        }
+
+        /**
+         * process two channels at once, the feedback recursions of both channels run in the lanes of one register
+         * the computer is shared and both followers use the parameters of follower0
+         */
+        template <typename C, PPState pp_state = PPState::kOff, SState s_state = SState::kOff>
+        static void processStereo(C& computer, VocalCompressor& comp0, VocalCompressor& comp1,
+                                  PSFollower<FloatType>& follower0, PSFollower<FloatType>& follower1,
+                                  FloatType* __restrict buffer0, FloatType* __restrict buffer1,
+                                  const size_t num_samples) {
+            static constexpr LaneTag d;
+            const std::array followers{&follower0, &follower1};
+            PSFollowerLanes<LaneTag> lanes{followers};
+            alignas(64) std::array<FloatType, 2 * kChunkSize> interleaved{};
+            alignas(16) std::array<FloatType, 2> x0{comp0.x0_, comp1.x0_};
+            auto v_x0 = hn::Load(d, x0.data());
+            for (size_t start_idx = 0; start_idx < num_samples; start_idx += kChunkSize) {
+                const auto chunk = std::min(kChunkSize, num_samples - start_idx);
+                for (size_t i = 0; i < chunk; ++i) {
+                    interleaved[2 * i] = buffer0[start_idx + i];
+                    interleaved[2 * i + 1] = buffer1[start_idx + i];
+                }
+                processLanes<C, LaneTag, pp_state, s_state>(computer, lanes, v_x0, interleaved.data(), chunk);
+                for (size_t i = 0; i < chunk; ++i) {
+                    buffer0[start_idx + i] = interleaved[2 * i];
+                    buffer1[start_idx + i] = interleaved[2 * i + 1];
+                }
+            }
+            hn::Store(v_x0, d, x0.data());
+            comp0.x0_ = x0[0];
+            comp1.x0_ = x0[1];
+            lanes.store();
+        }
+
+        /**
+         * process several channels at once, e.g., the bands of a multiband compressor
+         * the samples of the channels are interleaved and their feedback recursions run in the lanes of one register
+         * @param x0 the feedback samples of the lanes
+         * @param buffer the interleaved samples, [sample][lane]
+         * @param num_samples the number of samples of each lane
+         */
+        template <typename C, class D, PPState pp_state = PPState::kOff, SState s_state = SState::kOff>
+        static void processLanes(C& computer, PSFollowerLanes<D>& followers, hn::VFromD<D>& x0,
+                                 FloatType* __restrict buffer, const size_t num_samples) {
+            static constexpr D d;
+            static constexpr size_t lanes = hn::MaxLanes(d);
+            for (size_t i = 0; i < num_samples; ++i) {
+                const auto input_db = chore::fast_db::gainToDecibels<P>(d, hn::Abs(x0));
+                // pass through the computer and the follower
+                const auto smooth_reduction_gain = hn::Neg(followers.template processSample<pp_state, s_state>(
+                    hn::Neg(chore::fast_db::decibelsToGain<P>(d, computer.eval(d, input_db)))));
+                // apply the gain on the current samples and save them as the feedback samples for the next
+                auto* samples = buffer + i * lanes;
+                x0 = hn::Mul(hn::Load(d, samples), smooth_reduction_gain);
+                hn::Store(smooth_reduction_gain, d, samples);
+            }
+            chore::fast_db::magToDecibels<P>(buffer, num_samples * lanes);
         }
 
     private:
+        using LaneTag = hn::CappedTag<FloatType, 2>;
+        static constexpr size_t kChunkSize = 64;
+
         FloatType x0_{FloatType(0)};
     };
 }
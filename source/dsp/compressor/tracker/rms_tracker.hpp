@@ -12,14 +12,19 @@
 #include <atomic>
 #include <cmath>
 #include <algorithm>
-#include <iostream>
+#include <bit>
+#include <vector>
 
-#include "../../container/circular_buffer.hpp"
+#include "../../vector/vector.hpp"
 #include "../../chore/decibels.hpp"
+#include "../../chore/fast_db.hpp"
 
 namespace zldsp::compressor {
+    namespace hn = hwy::HWY_NAMESPACE;
+
     /**
      * a tracker that tracks the momentary RMS loudness of the audio signal
+     * the squares are kept in a ring buffer, which is large enough to slide the window by half of its length at once
      * @tparam FloatType
      */
     template <typename FloatType>
@@ -40,7 +45,9 @@ namespace zldsp::compressor {
 
         void reset() {
             square_sum_ = 0.0;
-            square_buffer_.clear();
+            pos_ = 0;
+            resum_count_ = 0;
+            std::fill(squares_.begin(), squares_.end(), FloatType(0));
         }
 
         /**
@@ -59,27 +66,85 @@ namespace zldsp::compressor {
          */
         void prepareBuffer() {
             if (to_update_.exchange(false, std::memory_order::acquire)) {
-                c_buffer_size_ = buffer_size_.load(std::memory_order::relaxed);
+                c_buffer_size_ = std::min(buffer_size_.load(std::memory_order::relaxed), max_buffer_size_);
                 c_buffer_size_r = FloatType(1) / static_cast<FloatType>(c_buffer_size_);
-                while (square_buffer_.size() > c_buffer_size_) {
-                    square_sum_ -= static_cast<double>(square_buffer_.popFront());
-                }
-                if (c_buffer_size_ == 1) {
-                    square_sum_ = square_buffer_.isEmpty()
-                                      ? 0.0
-                                      : static_cast<double>(square_buffer_.getFront());
-                }
+                // the window has changed, sum up the squares inside the new window
+                resum();
             }
         }
 
         void processSample(const FloatType x) {
             const FloatType square = x * x;
-            if (square_buffer_.size() == c_buffer_size_) {
-                square_sum_ -= static_cast<double>(square_buffer_.popFront());
-            }
+            square_sum_ += static_cast<double>(square)
+                - static_cast<double>(squares_[(pos_ - c_buffer_size_) & mask_]);
             square_sum_ = std::max(square_sum_, 0.0);
-            square_buffer_.template pushBack<false>(square);
-            square_sum_ += static_cast<double>(square);
+            squares_[pos_ & mask_] = square;
+            pos_ += 1;
+        }
+
+        /**
+         * process a block of samples, which is equivalent to calling processSample and getMomentarySquare per sample
+         * the squares and their differences are computed with SIMD, followed by a prefix sum of the differences
+         * the window is summed up again after each window length to bound the drift of the running sum
+         * @param buffer the input samples, which are replaced by the momentary square sums
+         * @param num_samples the number of samples
+         */
+        void processBlock(FloatType* __restrict buffer, const size_t num_samples) {
+            static constexpr hn::ScalableTag<FloatType> d;
+            static constexpr size_t lanes = hn::MaxLanes(d);
+            const auto ring_size = squares_.size();
+            size_t start_idx = 0;
+            while (start_idx < num_samples) {
+                // the squares leaving the window must not overlap with the squares entering it
+                const auto write_idx = pos_ & mask_;
+                const auto read_idx = (pos_ - c_buffer_size_) & mask_;
+                const auto chunk = std::min({num_samples - start_idx,
+                                             c_buffer_size_, ring_size - c_buffer_size_,
+                                             ring_size - write_idx, ring_size - read_idx});
+                FloatType* __restrict chunk_buffer = buffer + start_idx;
+                FloatType* __restrict new_squares = squares_.data() + write_idx;
+                const FloatType* __restrict old_squares = squares_.data() + read_idx;
+                // store the squares and replace the input with the differences
+                size_t i = 0;
+                for (; i + lanes <= chunk; i += lanes) {
+                    const auto v = hn::LoadU(d, chunk_buffer + i);
+                    const auto v_square = hn::Mul(v, v);
+                    hn::StoreU(v_square, d, new_squares + i);
+                    hn::StoreU(hn::Sub(v_square, hn::LoadU(d, old_squares + i)), d, chunk_buffer + i);
+                }
+                for (; i < chunk; ++i) {
+                    const auto square = chunk_buffer[i] * chunk_buffer[i];
+                    new_squares[i] = square;
+                    chunk_buffer[i] = square - old_squares[i];
+                }
+                // prefix sum of the differences, four at a time so that the running sum only waits for one add
+                auto sum = square_sum_;
+                i = 0;
+                for (; i + 4 <= chunk; i += 4) {
+                    const auto p0 = static_cast<double>(chunk_buffer[i]);
+                    const auto p1 = p0 + static_cast<double>(chunk_buffer[i + 1]);
+                    const auto p23 = static_cast<double>(chunk_buffer[i + 2])
+                        + static_cast<double>(chunk_buffer[i + 3]);
+                    const auto p2 = p1 + static_cast<double>(chunk_buffer[i + 2]);
+                    const auto p3 = p1 + p23;
+                    chunk_buffer[i] = static_cast<FloatType>(std::max(sum + p0, 0.0));
+                    chunk_buffer[i + 1] = static_cast<FloatType>(std::max(sum + p1, 0.0));
+                    chunk_buffer[i + 2] = static_cast<FloatType>(std::max(sum + p2, 0.0));
+                    chunk_buffer[i + 3] = static_cast<FloatType>(std::max(sum + p3, 0.0));
+                    sum += p3;
+                }
+                for (; i < chunk; ++i) {
+                    sum += static_cast<double>(chunk_buffer[i]);
+                    chunk_buffer[i] = static_cast<FloatType>(std::max(sum, 0.0));
+                }
+                square_sum_ = std::max(sum, 0.0);
+                pos_ += chunk;
+                start_idx += chunk;
+                resum_count_ += chunk;
+                if (resum_count_ >= c_buffer_size_) {
+                    resum();
+                }
+            }
         }
 
         /**
@@ -112,14 +177,18 @@ namespace zldsp::compressor {
             return static_cast<FloatType>(square_sum_);
         }
 
+        template <chore::fast_db::Precision P = chore::fast_db::Precision::kExact>
         FloatType getMomentaryDB() {
             FloatType mean_square = static_cast<FloatType>(square_sum_) * c_buffer_size_r;
-            return chore::squareGainToDecibels(mean_square);
+            return chore::fast_db::squareGainToDecibels<P>(mean_square);
         }
 
     private:
         double square_sum_{0};
-        container::CircularBuffer<FloatType> square_buffer_{1};
+        // ring buffer of squares, the samples older than the window are kept so that the window can grow
+        std::vector<FloatType> squares_ = std::vector<FloatType>(2, FloatType(0));
+        size_t mask_{1}, max_buffer_size_{1};
+        size_t pos_{0}, resum_count_{0};
 
         std::atomic<double> sample_rate_{48000.0};
         std::atomic<FloatType> time_length_{0};
@@ -136,7 +205,24 @@ namespace zldsp::compressor {
 
         void setMaximumMomentarySize(size_t size) {
             size = std::max(static_cast<size_t>(1), size);
-            square_buffer_.setCapacity(size);
+            // leave room for at least half of a window between the oldest and the newest square
+            const auto ring_size = std::bit_ceil(size + size / 2 + 1);
+            squares_.resize(ring_size);
+            mask_ = ring_size - 1;
+            max_buffer_size_ = size;
+            c_buffer_size_ = std::min(c_buffer_size_, max_buffer_size_);
+        }
+
+        /**
+         * sum up the squares inside the window
+         */
+        void resum() {
+            double sum = 0.0;
+            for (size_t i = pos_ - c_buffer_size_; i != pos_; ++i) {
+                sum += static_cast<double>(squares_[i & mask_]);
+            }
+            square_sum_ = sum;
+            resum_count_ = 0;
         }
     };
 }
@@ -0,0 +1,273 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <complex>
+#include <memory>
+#include <span>
+
+#include "../fft/zldsp_fft_include.hpp"
+#include "../vector/vector.hpp"
+
+namespace zldsp::convolution {
+    namespace hn = hwy::HWY_NAMESPACE;
+
+    /**
+     * a uniformly partitioned overlap-save convolver, the latency is one partition
+     * the IR is split into partitions of the same size, whose spectra multiply a frequency-domain delay line
+     * a new IR is loaded on a background thread and picked up by the audio thread without locks,
+     * the output crossfades from the old IR to the new IR across one partition
+     * @tparam FloatType the float type of the FFT
+     */
+    template <typename FloatType>
+    class PartitionedConvolver {
+    public:
+        PartitionedConvolver() = default;
+
+        /**
+         * prepare the convolver, it must not run concurrently with the other methods
+         * @param partition_size the partition size, a power of 2
+         * @param num_partitions the number of partitions
+         * @param num_channels the number of channels
+         */
+        void prepare(const size_t partition_size, const size_t num_partitions, const size_t num_channels) {
+            partition_size_ = partition_size;
+            num_partitions_ = num_partitions;
+            num_channels_ = num_channels;
+            bin_stride_ = (partition_size + 1 + kLanes - 1) / kLanes * kLanes;
+            const auto fft_order = static_cast<int>(std::round(std::log2(static_cast<double>(2 * partition_size))));
+            fft_ = std::make_unique<fft::RFFT<FloatType>>(fft_order);
+            design_fft_ = std::make_unique<fft::RFFT<FloatType>>(fft_order);
+            // the FFT is not normalized in the same way on every backend, take the round-trip gain of an impulse
+            fft_in_.resize(2 * partition_size);
+            fft_out_.resize(partition_size + 1);
+            std::fill(fft_in_.begin(), fft_in_.end(), FloatType(0));
+            fft_in_[0] = FloatType(1);
+            fft_->forward(fft_in_.data(), fft_out_.data());
+            fft_->backward(fft_out_.data(), fft_in_.data());
+            scale_ = FloatType(1) / fft_in_[0];
+            design_in_.resize(2 * partition_size);
+            design_out_.resize(partition_size + 1);
+
+            const auto spectrum_size = num_partitions * bin_stride_;
+            for (auto& kernel : kernels_) {
+                kernel.re.assign(spectrum_size, FloatType(0));
+                kernel.im.assign(spectrum_size, FloatType(0));
+            }
+            fdl_re_.resize(num_channels * spectrum_size);
+            fdl_im_.resize(num_channels * spectrum_size);
+            acc_re_.resize(bin_stride_);
+            acc_im_.resize(bin_stride_);
+            inputs_.resize(num_channels * 2 * partition_size);
+            outputs_.resize(num_channels * partition_size);
+            fade_.resize(partition_size);
+            for (size_t i = 0; i < partition_size; ++i) {
+                fade_[i] = static_cast<FloatType>(i + 1) / static_cast<FloatType>(partition_size);
+            }
+            c_kernel_idx_ = 0;
+            active_idx_.store(0, std::memory_order::relaxed);
+            ready_idx_.store(-1, std::memory_order::relaxed);
+            reset();
+        }
+
+        void reset() {
+            std::fill(fdl_re_.begin(), fdl_re_.end(), FloatType(0));
+            std::fill(fdl_im_.begin(), fdl_im_.end(), FloatType(0));
+            std::fill(inputs_.begin(), inputs_.end(), FloatType(0));
+            std::fill(outputs_.begin(), outputs_.end(), FloatType(0));
+            fdl_pos_ = 0;
+            input_pos_ = 0;
+        }
+
+        /**
+         * @return the latency in samples
+         */
+        [[nodiscard]] size_t getLatency() const {
+            return partition_size_;
+        }
+
+        [[nodiscard]] size_t getMaxIRSize() const {
+            return partition_size_ * num_partitions_;
+        }
+
+        /**
+         * background thread method
+         * @return true if the last loaded IR has not been picked up by the audio thread
+         */
+        [[nodiscard]] bool isIRPending() const {
+            return ready_idx_.load(std::memory_order::acquire) >= 0;
+        }
+
+        /**
+         * background thread method, it must not be called while the last IR is pending
+         * @param ir the IR, which is truncated to the maximum IR size
+         */
+        void loadIR(std::span<const FloatType> ir) {
+            const auto idx = 1 - active_idx_.load(std::memory_order::acquire);
+            setKernel(kernels_[static_cast<size_t>(idx)], ir);
+            ready_idx_.store(idx, std::memory_order::release);
+        }
+
+        /**
+         * load the IR without crossfading, it must not run concurrently with the audio thread
+         * @param ir the IR, which is truncated to the maximum IR size
+         */
+        void loadIRNow(std::span<const FloatType> ir) {
+            setKernel(kernels_[static_cast<size_t>(c_kernel_idx_)], ir);
+        }
+
+        /**
+         * process the incoming audio buffer, the output is delayed by one partition
+         * @tparam SampleType the float type of input audio buffer
+         * @param buffer
+         * @param num_samples
+         */
+        template <typename SampleType>
+        void process(std::span<SampleType*> buffer, const size_t num_samples) {
+            size_t start_idx = 0;
+            while (start_idx < num_samples) {
+                const auto num_to_process = std::min(partition_size_ - input_pos_, num_samples - start_idx);
+                for (size_t chan = 0; chan < buffer.size(); ++chan) {
+                    auto* input = inputs_.data() + chan * 2 * partition_size_ + partition_size_ + input_pos_;
+                    auto* output = outputs_.data() + chan * partition_size_ + input_pos_;
+                    vector::copy(input, buffer[chan] + start_idx, num_to_process);
+                    vector::copy(buffer[chan] + start_idx, output, num_to_process);
+                }
+                input_pos_ += num_to_process;
+                start_idx += num_to_process;
+                if (input_pos_ == partition_size_) {
+                    input_pos_ = 0;
+                    processPartition(buffer.size());
+                }
+            }
+        }
+
+    private:
+        static constexpr hn::ScalableTag<FloatType> kD{};
+        static constexpr size_t kLanes = hn::MaxLanes(kD);
+
+        struct Kernel {
+            // [partition][bin], the bins are padded to whole vectors
+            vector::aligned_vector<FloatType> re, im;
+        };
+
+        size_t partition_size_{0}, num_partitions_{0}, num_channels_{0}, bin_stride_{0};
+        FloatType scale_{1};
+        std::unique_ptr<fft::RFFT<FloatType>> fft_, design_fft_;
+        vector::aligned_vector<FloatType> fft_in_, design_in_;
+        std::vector<std::complex<FloatType>> fft_out_, design_out_;
+
+        std::array<Kernel, 2> kernels_;
+        // the kernel used by the audio thread, and the kernel loaded by the background thread
+        int c_kernel_idx_{0};
+        std::atomic<int> active_idx_{0}, ready_idx_{-1};
+
+        // the frequency-domain delay line, [channel][partition][bin]
+        vector::aligned_vector<FloatType> fdl_re_, fdl_im_;
+        size_t fdl_pos_{0};
+        vector::aligned_vector<FloatType> acc_re_, acc_im_;
+        // [channel][previous partition, current partition]
+        vector::aligned_vector<FloatType> inputs_;
+        // [channel][partition]
+        vector::aligned_vector<FloatType> outputs_;
+        size_t input_pos_{0};
+        vector::aligned_vector<FloatType> fade_;
+
+        void setKernel(Kernel& kernel, std::span<const FloatType> ir) {
+            const auto ir_size = std::min(ir.size(), getMaxIRSize());
+            for (size_t p = 0; p < num_partitions_; ++p) {
+                std::fill(design_in_.begin(), design_in_.end(), FloatType(0));
+                const auto start = p * partition_size_;
+                if (start < ir_size) {
+                    const auto size = std::min(partition_size_, ir_size - start);
+                    // the kernel carries the normalization of the round trip
+                    for (size_t i = 0; i < size; ++i) {
+                        design_in_[i] = ir[start + i] * scale_;
+                    }
+                }
+                design_fft_->forward(design_in_.data(), design_out_.data());
+                auto* re = kernel.re.data() + p * bin_stride_;
+                auto* im = kernel.im.data() + p * bin_stride_;
+                for (size_t k = 0; k <= partition_size_; ++k) {
+                    re[k] = design_out_[k].real();
+                    im[k] = design_out_[k].imag();
+                }
+            }
+        }
+
+        void processPartition(const size_t num_channels) {
+            const auto ready_idx = ready_idx_.load(std::memory_order::acquire);
+            const auto prev_idx = c_kernel_idx_;
+            const auto to_fade = ready_idx >= 0;
+            if (to_fade) {
+                c_kernel_idx_ = ready_idx;
+            }
+            const auto spectrum_size = num_partitions_ * bin_stride_;
+            for (size_t chan = 0; chan < num_channels; ++chan) {
+                auto* input = inputs_.data() + chan * 2 * partition_size_;
+                auto* output = outputs_.data() + chan * partition_size_;
+                auto* fdl_re = fdl_re_.data() + chan * spectrum_size;
+                auto* fdl_im = fdl_im_.data() + chan * spectrum_size;
+                // push the spectrum of the last two partitions into the delay line
+                fft_->forward(input, fft_out_.data());
+                vector::copy(input, input + partition_size_, partition_size_);
+                for (size_t k = 0; k <= partition_size_; ++k) {
+                    fdl_re[fdl_pos_ * bin_stride_ + k] = fft_out_[k].real();
+                    fdl_im[fdl_pos_ * bin_stride_ + k] = fft_out_[k].imag();
+                }
+                // the last partition of the circular convolution is the linear convolution
+                convolve(kernels_[static_cast<size_t>(c_kernel_idx_)], fdl_re, fdl_im);
+                vector::copy(output, fft_in_.data() + partition_size_, partition_size_);
+                if (to_fade) {
+                    convolve(kernels_[static_cast<size_t>(prev_idx)], fdl_re, fdl_im);
+                    const auto* prev_output = fft_in_.data() + partition_size_;
+                    for (size_t i = 0; i < partition_size_; ++i) {
+                        output[i] = prev_output[i] + (output[i] - prev_output[i]) * fade_[i];
+                    }
+                }
+            }
+            fdl_pos_ = (fdl_pos_ + 1) % num_partitions_;
+            if (to_fade) {
+                // the previous kernel is free to be overwritten from now on
+                active_idx_.store(c_kernel_idx_, std::memory_order::release);
+                ready_idx_.store(-1, std::memory_order::release);
+            }
+        }
+
+        /**
+         * multiply-accumulate the kernel spectra with the delay line, then transform the sum into fft_in_
+         */
+        void convolve(const Kernel& kernel, const FloatType* fdl_re, const FloatType* fdl_im) {
+            std::fill(acc_re_.begin(), acc_re_.end(), FloatType(0));
+            std::fill(acc_im_.begin(), acc_im_.end(), FloatType(0));
+            for (size_t p = 0; p < num_partitions_; ++p) {
+                const auto fdl_idx = (fdl_pos_ + num_partitions_ - p) % num_partitions_;
+                const auto* x_re = fdl_re + fdl_idx * bin_stride_;
+                const auto* x_im = fdl_im + fdl_idx * bin_stride_;
+                const auto* k_re = kernel.re.data() + p * bin_stride_;
+                const auto* k_im = kernel.im.data() + p * bin_stride_;
+                for (size_t k = 0; k < bin_stride_; k += kLanes) {
+                    const auto xr = hn::Load(kD, x_re + k), xi = hn::Load(kD, x_im + k);
+                    const auto kr = hn::Load(kD, k_re + k), ki = hn::Load(kD, k_im + k);
+                    auto ar = hn::Load(kD, acc_re_.data() + k), ai = hn::Load(kD, acc_im_.data() + k);
+                    ar = hn::NegMulAdd(ki, xi, hn::MulAdd(kr, xr, ar));
+                    ai = hn::MulAdd(ki, xr, hn::MulAdd(kr, xi, ai));
+                    hn::Store(ar, kD, acc_re_.data() + k);
+                    hn::Store(ai, kD, acc_im_.data() + k);
+                }
+            }
+            for (size_t k = 0; k <= partition_size_; ++k) {
+                fft_out_[k] = {acc_re_[k], acc_im_[k]};
+            }
+            fft_->backward(fft_out_.data(), fft_in_.data());
+        }
+    };
+}
@@ -10,5 +10,8 @@
 #pragma once
 
 #include "iir_filter/tdf/tdf.hpp"
+#include "iir_filter/svf/svf.hpp"
+#include "iir_filter/parallel/parallel.hpp"
+#include "fir_filter/linear_phase.hpp"
 #include "ideal_filter/ideal.hpp"
 #include "filter_design/filter_design.hpp"
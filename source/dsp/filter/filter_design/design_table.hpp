@@ -0,0 +1,130 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "../helpers.hpp"
+
+/**
+ * precomputed order tables of the cascade designs
+ * the section Q of a pass/shelf cascade is q_i = q_scale_i * (sqrt(2) * q0) ^ (first_exp + i * step_exp),
+ * so the Q skeleton of any order costs one log and two exps instead of several pow/log10/cos per section
+ * the tables hold exact constants, cascades longer than the tables fall back to the direct computation
+ */
+namespace zldsp::filter::DesignTable {
+    inline constexpr size_t kMaxSectionNum = 8;
+
+    struct SectionTable {
+        std::array<double, kMaxSectionNum> q_scales;
+        double first_exp, step_exp;
+        // the section Q of band-pass/notch cascades divided by q0
+        double band_pass_scale, notch_scale;
+    };
+
+    inline SectionTable makeSectionTable(const size_t number) {
+        SectionTable table{};
+        const auto n = static_cast<double>(2 * number);
+        const auto theta0 = pi / static_cast<double>(number) / 4;
+        for (size_t i = 0; i < number; ++i) {
+            table.q_scales[i] = 1.0 / 2.0 / std::cos(theta0 * static_cast<double>(2 * i + 1));
+        }
+        // 2 ^ (centered * log10(x) * 12 / n ^ 1.5) = x ^ (centered * log10(2) * 12 / n ^ 1.5)
+        table.step_exp = std::log10(2.0) * 12 / std::pow(n, 1.5);
+        table.first_exp = 1 / static_cast<double>(number)
+            + (0.5 - static_cast<double>(number) / 2) * table.step_exp;
+        // the band edges are w0 / s and w0 * s with s - 1 / s = 1 / q0
+        const auto g = dbToGain(-6 / n);
+        table.band_pass_scale = std::sqrt(1 - g * g) / g;
+        table.notch_scale = g / std::sqrt(1 - g * g);
+        return table;
+    }
+
+    inline const std::array<SectionTable, kMaxSectionNum + 1> kSectionTables = []() {
+        std::array<SectionTable, kMaxSectionNum + 1> tables{};
+        for (size_t number = 1; number <= kMaxSectionNum; ++number) {
+            tables[number] = makeSectionTable(number);
+        }
+        return tables;
+    }();
+
+    /**
+     * generate the section Q of a pass/shelf cascade one by one
+     */
+    class SectionQ {
+    public:
+        /**
+         * @param number the number of 2nd order sections
+         * @param q0 the Q of the cascade
+         */
+        SectionQ(const size_t number, const double q0) :
+            number_(number), log_q_(std::log(std::sqrt(2.0) * q0)) {
+            if (number_ <= kMaxSectionNum) {
+                const auto& table{kSectionTables[number_]};
+                scale_ = std::exp(table.first_exp * log_q_);
+                step_ = std::exp(table.step_exp * log_q_);
+            }
+        }
+
+        /**
+         * @return the Q of the next section
+         */
+        double next() {
+            const auto i = idx_++;
+            if (number_ <= kMaxSectionNum) {
+                const auto q = kSectionTables[number_].q_scales[i] * scale_;
+                scale_ *= step_;
+                return q;
+            }
+            const auto theta = pi / static_cast<double>(number_) / 4 * static_cast<double>(2 * i + 1);
+            const auto step_exp = std::log10(2.0) * 12 / std::pow(static_cast<double>(2 * number_), 1.5);
+            const auto centered = static_cast<double>(i) - static_cast<double>(number_) / 2 + 0.5;
+            const auto e = 1 / static_cast<double>(number_) + centered * step_exp;
+            return 1.0 / 2.0 / std::cos(theta) * std::exp(e * log_q_);
+        }
+
+    private:
+        size_t number_, idx_{0};
+        double log_q_, scale_{0.0}, step_{0.0};
+    };
+
+    /**
+     * @param q0 the Q of the band
+     * @return the ratio between the upper band edge and the center frequency, 2 ^ (asinh(0.5 / q0) / ln2)
+     */
+    inline double getBandScale(const double q0) {
+        const auto x = 0.5 / q0;
+        return x + std::sqrt(x * x + 1.0);
+    }
+
+    /**
+     * @param n the order of the band-pass cascade
+     * @param q0 the Q of the band
+     * @return the Q of each section
+     */
+    inline double getBandPassQ(const size_t n, const double q0) {
+        if (n / 2 <= kMaxSectionNum) {
+            return q0 * kSectionTables[n / 2].band_pass_scale;
+        }
+        const auto g = dbToGain(-6 / static_cast<double>(n));
+        return q0 * std::sqrt(1 - g * g) / g;
+    }
+
+    /**
+     * @param n the order of the notch cascade
+     * @param q0 the Q of the band
+     * @return the Q of each section
+     */
+    inline double getNotchQ(const size_t n, const double q0) {
+        if (n / 2 <= kMaxSectionNum) {
+            return q0 * kSectionTables[n / 2].notch_scale;
+        }
+        const auto g = dbToGain(-6 / static_cast<double>(n));
+        return q0 * g / std::sqrt(1 - g * g);
+    }
+}
@@ -11,6 +11,7 @@
 
 #include <span>
 #include "../helpers.hpp"
+#include "design_table.hpp"
 
 namespace zldsp::filter::FilterDesign {
     static constexpr std::array<double, 9> flat_freq = {
@@ -111,14 +112,9 @@ namespace zldsp::filter::FilterDesign {
             return 1;
         }
         const size_t number = n / 2;
-        const auto theta0 = pi / static_cast<double>(number) / 4;
-        const auto scale = std::pow(std::sqrt(2.0) * q0, 1 / static_cast<double>(number));
-        const auto rescale_base = std::log10(std::sqrt(2.0) * q0) / std::pow(static_cast<double>(n), 1.5) * 12;
+        DesignTable::SectionQ section_q{number, q0};
         for (size_t i = 0; i < number; i++) {
-            const auto centered = static_cast<double>(i) - static_cast<double>(number) / 2 + 0.5;
-            const auto rescale = centered * rescale_base;
-            const auto theta = theta0 * static_cast<double>(2 * i + 1);
-            const auto qs = 1.0 / 2.0 / std::cos(theta) * scale * std::pow(2, rescale);
+            const auto qs = section_q.next();
             if constexpr (filter_type == kLowPass) {
                 coeffs[i + start_idx] = Coeff::get2LowPass(w0, qs);
             }
@@ -164,14 +160,9 @@ namespace zldsp::filter::FilterDesign {
         }
         const size_t number = n / 2;
         const auto _g = g_dB / static_cast<double>(number);
-        const auto theta0 = pi / static_cast<double>(number) / 4;
-        const auto scale = std::pow(std::sqrt(2.0) * q0, 1 / static_cast<double>(number));
-        const auto rescale_base = std::log10(std::sqrt(2.0) * q0) / std::pow(static_cast<double>(n), 1.5) * 12;
+        DesignTable::SectionQ section_q{number, q0};
         for (size_t i = 0; i < number; i++) {
-            const auto centered = static_cast<double>(i) - static_cast<double>(number) / 2 + 0.5;
-            const auto rescale = centered * rescale_base;
-            const auto theta = theta0 * static_cast<double>(2 * i + 1);
-            const auto _q = 1.0 / 2.0 / std::cos(theta) * scale * std::pow(2, rescale);
+            const auto _q = section_q.next();
             if constexpr (filter_type == kLowShelf) {
                 coeffs[i + start_idx] = Coeff::get2LowShelf(w0, _g, _q);
             }
@@ -188,14 +179,9 @@ namespace zldsp::filter::FilterDesign {
     template <class Coeff>
     inline void updateShelfDynamicCache(const size_t n, const double w0, const double q0, double* cache) {
         const size_t number = n / 2;
-        const auto theta0 = pi / static_cast<double>(number) / 4;
-        const auto scale = std::pow(std::sqrt(2.0) * q0, 1 / static_cast<double>(number));
-        const auto rescale_base = std::log10(std::sqrt(2.0) * q0) / std::pow(static_cast<double>(n), 1.5) * 12;
+        DesignTable::SectionQ section_q{number, q0};
         for (size_t i = 0; i < number; i++) {
-            const auto centered = static_cast<double>(i) - static_cast<double>(number) / 2 + 0.5;
-            const auto rescale = centered * rescale_base;
-            const auto theta = theta0 * static_cast<double>(2 * i + 1);
-            const auto _q = 1.0 / 2.0 / std::cos(theta) * scale * std::pow(2, rescale);
+            const auto _q = section_q.next();
             Coeff::update2ShelfDynamicCache(w0, _q, cache + (i * 3));
         }
     }
@@ -206,10 +192,7 @@ namespace zldsp::filter::FilterDesign {
                                 std::span<std::array<double, 5>> coeffs) {
         if (n < 2) { return 0; }
         const size_t number = n / 2;
-        const auto halfbw = std::asinh(0.5 / q0) / std::log(2);
-        const auto w = w0 / std::pow(2, halfbw);
-        const auto g = dbToGain(-6 / static_cast<double>(n));
-        const auto _q = std::sqrt(1 - g * g) * w * w0 / g / (w0 * w0 - w * w);
+        const auto _q = DesignTable::getBandPassQ(n, q0);
 
         const auto single_coeff = Coeff::get2BandPass(w0, _q);
         for (size_t i = 0; i < n / 2; ++i) {
@@ -224,10 +207,7 @@ namespace zldsp::filter::FilterDesign {
                              std::span<std::array<double, 5>> coeffs) {
         if (n < 2) { return 0; }
         const size_t number = n / 2;
-        const auto halfbw = std::asinh(0.5 / q0) / std::log(2);
-        const auto w = w0 / std::pow(2, halfbw);
-        const auto g = dbToGain(-6 / static_cast<double>(n));
-        const auto _q = g * w * w0 / std::sqrt((1 - g * g)) / (w0 * w0 - w * w);
+        const auto _q = DesignTable::getNotchQ(n, q0);
 
         const auto single_coeff = Coeff::get2Notch(w0, _q);
         for (size_t i = 0; i < n / 2; ++i) {
@@ -241,8 +221,7 @@ namespace zldsp::filter::FilterDesign {
                                  const double w0, const double g_dB, const double q0,
                                  std::span<std::array<double, 5>> coeffs) {
         if (n < 2) { return 0; }
-        const auto halfbw = std::asinh(0.5 / q0) / std::log(2);
-        const auto scale = std::pow(2, halfbw);
+        const auto scale = DesignTable::getBandScale(q0);
         const auto w1 = w0 / scale;
         const auto w2 = w0 * scale;
         const auto f1 = w1 > (1.0 / 48000.0), f2 = w2 < 0.99;
@@ -267,8 +246,7 @@ namespace zldsp::filter::FilterDesign {
         if (n < 2) {
             return;
         }
-        const auto halfbw = std::asinh(0.5 / q0) / std::log(2);
-        const auto scale = std::pow(2, halfbw);
+        const auto scale = DesignTable::getBandScale(q0);
         const auto w1 = w0 / scale;
         const auto w2 = w0 * scale;
         const auto f1 = w1 > (1.0 / 48000.0), f2 = w2 < 0.99;
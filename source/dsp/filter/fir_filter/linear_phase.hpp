@@ -0,0 +1,152 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <span>
+
+#include "../ideal_filter/ideal.hpp"
+#include "../../convolution/partitioned_convolver.hpp"
+#include "../../fft/zldsp_fft_include.hpp"
+
+namespace zldsp::filter {
+    /**
+     * a linear-phase filter whose magnitude is the product of the ideal responses of several bands
+     * the IR is designed by frequency sampling with a Hann window and runs on a partitioned convolver
+     * the IR length is 80 ms to 90 ms at common sample rates, so the latency is about 50 ms
+     * @tparam kFilterSize the number of cascading filters of each band
+     */
+    template <size_t kFilterSize>
+    class LinearPhase {
+    public:
+        // the number of convolver partitions, which keeps the cost per sample independent of the sample rate
+        static constexpr size_t kPartitionNum = 16;
+
+        LinearPhase() = default;
+
+        /**
+         * prepare the filter and load a pure delay, it must not run concurrently with the other methods
+         * @param sample_rate
+         * @param num_channels
+         */
+        void prepare(const double sample_rate, const size_t num_channels) {
+            sample_rate_ = sample_rate;
+            ir_size_ = getIRSize(sample_rate);
+            ideal_.prepare(sample_rate);
+            convolver_.prepare(ir_size_ / kPartitionNum, kPartitionNum, num_channels);
+            fft_ = std::make_unique<fft::RFFT<float>>(
+                static_cast<int>(std::round(std::log2(static_cast<double>(ir_size_)))));
+            const auto num_bins = ir_size_ / 2 + 1;
+            ws_.resize(num_bins);
+            for (size_t k = 0; k < num_bins; ++k) {
+                ws_[k] = ppi * static_cast<double>(k) / static_cast<double>(ir_size_);
+            }
+            mags_.resize(num_bins);
+            band_mags_.resize(num_bins);
+            spectrum_.resize(num_bins);
+            ir_.resize(ir_size_);
+            window_.resize(ir_size_);
+            fft::createPeriodicHanning(std::span{window_.data(), window_.size()});
+            // take the round-trip gain of the FFT
+            std::fill(spectrum_.begin(), spectrum_.end(), std::complex<float>(1.f, 0.f));
+            fft_->backward(spectrum_.data(), ir_.data());
+            scale_ = 1.f / ir_[0];
+
+            designIR({});
+            convolver_.loadIRNow(ir_);
+        }
+
+        void reset() {
+            convolver_.reset();
+        }
+
+        /**
+         * @return the latency in samples
+         */
+        [[nodiscard]] size_t getLatency() const {
+            return convolver_.getLatency() + ir_size_ / 2;
+        }
+
+        /**
+         * @param sample_rate
+         * @return the latency in samples at the sample rate
+         */
+        static size_t getLatency(const double sample_rate) {
+            const auto ir_size = getIRSize(sample_rate);
+            return ir_size / kPartitionNum + ir_size / 2;
+        }
+
+        /**
+         * background thread method, design the IR of the bands and load it into the convolver
+         * @param paras the parameters of the bands
+         * @return false if the last IR has not been picked up by the audio thread, the design is skipped
+         */
+        bool updateIR(std::span<const FilterParameters> paras) {
+            if (convolver_.isIRPending()) {
+                return false;
+            }
+            designIR(paras);
+            convolver_.loadIR(ir_);
+            return true;
+        }
+
+        /**
+         * process the incoming audio buffer
+         * @param buffer
+         * @param num_samples
+         */
+        template <typename FloatType>
+        void process(std::span<FloatType*> buffer, const size_t num_samples) {
+            convolver_.process(buffer, num_samples);
+        }
+
+    private:
+        double sample_rate_{48000.0};
+        size_t ir_size_{4096};
+        Ideal<double, kFilterSize> ideal_;
+        convolution::PartitionedConvolver<float> convolver_;
+        std::unique_ptr<fft::RFFT<float>> fft_;
+        float scale_{1.f};
+        std::vector<double> ws_, mags_, band_mags_;
+        std::vector<std::complex<float>> spectrum_;
+        vector::aligned_vector<float> ir_, window_;
+
+        static size_t getIRSize(const double sample_rate) {
+            size_t ir_size = 4096;
+            while (static_cast<double>(ir_size) < sample_rate * 0.08) {
+                ir_size <<= 1;
+            }
+            return ir_size;
+        }
+
+        void designIR(std::span<const FilterParameters> paras) {
+            std::fill(mags_.begin(), mags_.end(), 1.0);
+            for (const auto& para : paras) {
+                ideal_.forceUpdate(para);
+                ideal_.updateMagnitudeSquare(ws_, band_mags_);
+                for (size_t k = 0; k < mags_.size(); ++k) {
+                    mags_[k] *= band_mags_[k];
+                }
+            }
+            // the zero-phase response is real
+            for (size_t k = 0; k < mags_.size(); ++k) {
+                spectrum_[k] = {static_cast<float>(std::sqrt(mags_[k])) * scale_, 0.f};
+            }
+            fft_->backward(spectrum_.data(), ir_.data());
+            // center the symmetric IR and window it
+            const auto half_size = ir_size_ / 2;
+            for (size_t i = 0; i < half_size; ++i) {
+                std::swap(ir_[i], ir_[i + half_size]);
+            }
+            for (size_t i = 0; i < ir_size_; ++i) {
+                ir_[i] *= window_[i];
+            }
+        }
+    };
+}
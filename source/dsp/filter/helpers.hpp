@@ -29,7 +29,7 @@ namespace zldsp::filter {
     };
 
     enum FilterStructure {
-        kIIR, kSVF, kParallel
+        kIIR, kSVF, kParallel, kLinearPhase
     };
 
     struct FilterParameters {
@@ -51,8 +51,9 @@ namespace zldsp::filter {
     }
 
     inline std::array<double, 2> getBandwidth(const double w0, const double q) {
-        const auto bw = 2 * std::asinh(0.5 / q) / std::log(2);
-        const auto scale = std::pow(2, bw / 2);
+        // 2 ^ (asinh(0.5 / q) / ln2) = exp(asinh(0.5 / q))
+        const auto x = 0.5 / q;
+        const auto scale = x + std::sqrt(x * x + 1.0);
         return {w0 / scale, w0 * scale};
     }
 }
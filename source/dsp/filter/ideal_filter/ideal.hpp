@@ -103,6 +103,19 @@ namespace zldsp::filter {
             }
         }
 
+        void updateResponse(std::span<const FloatType> ws,
+                            std::span<FloatType> res_real, std::span<FloatType> res_imag) const {
+            if (current_filter_num_ == 0) {
+                std::fill(res_real.begin(), res_real.end(), static_cast<FloatType>(1.0));
+                std::fill(res_imag.begin(), res_imag.end(), static_cast<FloatType>(0.0));
+                return;
+            }
+            IdealBase<FloatType>::template updateResponse<true>(coeffs_[0], ws, res_real, res_imag);
+            for (size_t i = 1; i < current_filter_num_; ++i) {
+                IdealBase<FloatType>::template updateResponse<false>(coeffs_[i], ws, res_real, res_imag);
+            }
+        }
+
         [[nodiscard]] size_t getFilterNum() const {
             return current_filter_num_;
         }
@@ -121,6 +121,20 @@ namespace zldsp::filter {
             return this->c_freq_.isSmoothing() || this->c_q_.isSmoothing();
         }
 
+        [[nodiscard]] bool isSmoothing() const {
+            return c_freq_.isSmoothing() || c_gain_.isSmoothing() || c_q_.isSmoothing();
+        }
+
+        /**
+         * advance the smoothed parameters by several samples, the coefficients are not updated
+         * @param num_samples
+         */
+        void advanceSmooth(const size_t num_samples) {
+            c_freq_.skip(num_samples);
+            c_gain_.skip(num_samples);
+            c_q_.skip(num_samples);
+        }
+
         void skipSmooth() {
             c_freq_.setCurrentAndTarget(c_freq_.getTarget());
             c_gain_.setCurrentAndTarget(c_gain_.getTarget());
@@ -0,0 +1,268 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <span>
+#include <vector>
+#include <algorithm>
+
+#include "../iir/iir.hpp"
+#include "../coeff/ivantsov_coeff.hpp"
+#include "../../../vector/vector.hpp"
+
+namespace zldsp::filter {
+    namespace hn = hwy::HWY_NAMESPACE;
+
+    /**
+     * the parameters and coefficients of one band of a parallel filter, it holds no audio state
+     * @tparam kFilterSize the number of cascading filters
+     */
+    template <size_t kFilterSize>
+    class ParallelBand final : public IIR<kFilterSize> {
+    public:
+        void reset() override {
+        }
+
+        void prepare(const double sample_rate, const size_t, const size_t) override {
+            IIR<kFilterSize>::prepareSampleRate(sample_rate);
+        }
+
+        void updateCoeffs() override {
+            this->current_filter_num_ = FilterDesign::updateCoeffs<IvantsovCoeff>(
+                this->c_filter_type_, this->c_order_,
+                this->c_freq_.getCurrent(), this->sample_rate_,
+                this->c_gain_.getCurrent(), this->c_q_.getCurrent(), this->coeffs_);
+        }
+    };
+
+    /**
+     * a parallel IIR filter, the output is the input plus the sum of (H_i - 1) applied to the input
+     * each band runs its TDF cascade in one SIMD lane, so all bands of a lane group share one pass over the audio
+     * the sum matches the cascade when the bands do not overlap, overlapping bands add in linear gain
+     * the caller picks the summed bands, e.g., peak boosts never cancel each other however they overlap
+     * parameters are smoothed and the coefficients are updated once per chunk
+     * @tparam FloatType the float type of input audio buffer
+     * @tparam kBandSize the maximum number of bands
+     * @tparam kFilterSize the number of cascading filters of each band
+     */
+    template <typename FloatType, size_t kBandSize, size_t kFilterSize>
+    class Parallel {
+        using DTag = hn::CappedTag<double, 4>;
+        static constexpr DTag kD{};
+
+    public:
+        static constexpr size_t kLanes = hn::MaxLanes(kD);
+        static constexpr size_t kGroupNum = (kBandSize + kLanes - 1) / kLanes;
+
+        Parallel() {
+            lane_bands_.fill(kBandSize);
+        }
+
+        void prepare(const double sample_rate, const size_t num_channels) {
+            for (auto& band : bands_) {
+                band.prepare(sample_rate, num_channels, 0);
+            }
+            num_channels_ = num_channels;
+            states_.resize(num_channels * kGroupNum * kFilterSize * 2 * kLanes);
+            interleaved_.resize(kChunkSize * kLanes);
+            for (size_t lane = 0; lane < kGroupNum * kLanes; ++lane) {
+                loadLane(lane);
+            }
+            reset();
+        }
+
+        void reset() {
+            std::fill(states_.begin(), states_.end(), 0.0);
+        }
+
+        /**
+         * clear the states of one band
+         * @param band_idx
+         */
+        void resetBand(const size_t band_idx) {
+            for (size_t lane = 0; lane < kGroupNum * kLanes; ++lane) {
+                if (lane_bands_[lane] == band_idx) {
+                    clearLane(lane);
+                }
+            }
+        }
+
+        void forceUpdate(const size_t band_idx, const FilterParameters& paras) {
+            bands_[band_idx].forceUpdate(paras);
+            resetBand(band_idx);
+            loadBand(band_idx);
+        }
+
+        void updateParas(const size_t band_idx, const FilterParameters& paras) {
+            auto& band{bands_[band_idx]};
+            if (paras.filter_type != band.getFilterType() || paras.order != band.getOrder()) {
+                band.updateParas(paras);
+                resetBand(band_idx);
+                loadBand(band_idx);
+            } else {
+                band.updateParas(paras);
+            }
+        }
+
+        /**
+         * set the bands which are summed, lanes which get a new band are cleared
+         * @param band_indices at most kBandSize band indices
+         */
+        void setBands(std::span<const size_t> band_indices) {
+            for (size_t lane = 0; lane < kGroupNum * kLanes; ++lane) {
+                const auto band_idx = lane < band_indices.size() ? band_indices[lane] : kBandSize;
+                if (lane_bands_[lane] != band_idx) {
+                    lane_bands_[lane] = band_idx;
+                    clearLane(lane);
+                    loadLane(lane);
+                }
+            }
+        }
+
+        /**
+         * a bypassed band keeps running but does not contribute to the output
+         * @param band_idx
+         * @param bypass
+         */
+        void setBypass(const size_t band_idx, const bool bypass) {
+            bypasses_[band_idx] = bypass;
+            loadBand(band_idx);
+        }
+
+        /**
+         * process the incoming audio buffer
+         * @param buffer
+         * @param num_samples
+         */
+        template <bool bypass = false>
+        void process(std::span<FloatType*> buffer, const size_t num_samples) {
+            if (std::ranges::all_of(group_filter_nums_, [](const size_t n) { return n == 0; })) {
+                return;
+            }
+            size_t start_idx = 0;
+            while (start_idx < num_samples) {
+                const auto num_to_process = std::min(kChunkSize, num_samples - start_idx);
+                for (size_t lane = 0; lane < kGroupNum * kLanes; ++lane) {
+                    const auto band_idx = lane_bands_[lane];
+                    if (band_idx < kBandSize && bands_[band_idx].isSmoothing()) {
+                        bands_[band_idx].advanceSmooth(num_to_process);
+                        bands_[band_idx].updateCoeffs();
+                        loadLane(lane);
+                    }
+                }
+                for (size_t channel = 0; channel < buffer.size(); ++channel) {
+                    processChunk<bypass>(channel, buffer[channel] + start_idx, num_to_process);
+                }
+                start_idx += num_to_process;
+            }
+        }
+
+    private:
+        static constexpr size_t kChunkSize = 32;
+
+        std::array<ParallelBand<kFilterSize>, kBandSize> bands_{};
+        std::array<bool, kBandSize> bypasses_{};
+        std::array<size_t, kGroupNum * kLanes> lane_bands_{};
+        // per group and filter: [a1, a2, b0, b1, b2][lane], unused filters are identities
+        alignas(64) std::array<std::array<std::array<double, kLanes>, 5>, kGroupNum * kFilterSize> coeffs_{};
+        // per group: 1 for lanes which contribute to the output, otherwise 0
+        alignas(64) std::array<std::array<double, kLanes>, kGroupNum> weights_{};
+        std::array<std::array<size_t, kLanes>, kGroupNum> lane_filter_nums_{};
+        std::array<size_t, kGroupNum> group_filter_nums_{};
+        size_t num_channels_{0};
+        // per channel and group: [filter][s1, s2][lane]
+        vector::aligned_vector<double> states_;
+        // the lane outputs of one group: [sample][lane]
+        vector::aligned_vector<double> interleaved_;
+
+        void loadBand(const size_t band_idx) {
+            for (size_t lane = 0; lane < kGroupNum * kLanes; ++lane) {
+                if (lane_bands_[lane] == band_idx) {
+                    loadLane(lane);
+                }
+            }
+        }
+
+        void loadLane(const size_t lane) {
+            const auto group = lane / kLanes, idx = lane % kLanes;
+            const auto band_idx = lane_bands_[lane];
+            const auto num_filters = band_idx < kBandSize ? bands_[band_idx].getFilterNum() : 0;
+            for (size_t f = 0; f < kFilterSize; ++f) {
+                auto& coeff{coeffs_[group * kFilterSize + f]};
+                const std::array<double, 5> c = f < num_filters
+                                                    ? bands_[band_idx].getCoeff()[f]
+                                                    : std::array<double, 5>{0.0, 0.0, 1.0, 0.0, 0.0};
+                for (size_t k = 0; k < 5; ++k) {
+                    coeff[k][idx] = c[k];
+                }
+            }
+            weights_[group][idx] = (band_idx < kBandSize && !bypasses_[band_idx]) ? 1.0 : 0.0;
+            lane_filter_nums_[group][idx] = num_filters;
+            group_filter_nums_[group] = std::ranges::max(lane_filter_nums_[group]);
+        }
+
+        void clearLane(const size_t lane) {
+            const auto group = lane / kLanes, idx = lane % kLanes;
+            for (size_t channel = 0; channel < num_channels_; ++channel) {
+                double* group_states = states_.data() + (channel * kGroupNum + group) * kFilterSize * 2 * kLanes;
+                for (size_t k = 0; k < kFilterSize * 2; ++k) {
+                    group_states[k * kLanes + idx] = 0.0;
+                }
+            }
+        }
+
+        template <bool bypass>
+        void processChunk(const size_t channel, FloatType* buffer, const size_t num_samples) {
+            using V = hn::VFromD<DTag>;
+            alignas(64) std::array<double, kChunkSize> deviations{};
+            for (size_t group = 0; group < kGroupNum; ++group) {
+                const auto num_filters = group_filter_nums_[group];
+                if (num_filters == 0) {
+                    continue;
+                }
+                for (size_t i = 0; i < num_samples; ++i) {
+                    hn::Store(hn::Set(kD, static_cast<double>(buffer[i])), kD, interleaved_.data() + i * kLanes);
+                }
+                // run the cascades filter by filter with the states kept in registers
+                double* group_states = states_.data() + (channel * kGroupNum + group) * kFilterSize * 2 * kLanes;
+                for (size_t f = 0; f < num_filters; ++f) {
+                    const auto& coeff{coeffs_[group * kFilterSize + f]};
+                    std::array<V, 5> c;
+                    for (size_t k = 0; k < 5; ++k) {
+                        c[k] = hn::Load(kD, coeff[k].data());
+                    }
+                    auto s1 = hn::Load(kD, group_states + (2 * f) * kLanes);
+                    auto s2 = hn::Load(kD, group_states + (2 * f + 1) * kLanes);
+                    for (size_t i = 0; i < num_samples; ++i) {
+                        const auto x = hn::Load(kD, interleaved_.data() + i * kLanes);
+                        const auto y = hn::MulAdd(x, c[2], s1);
+                        s1 = hn::Add(hn::NegMulAdd(y, c[0], hn::Mul(x, c[3])), s2);
+                        s2 = hn::NegMulAdd(y, c[1], hn::Mul(x, c[4]));
+                        hn::Store(y, kD, interleaved_.data() + i * kLanes);
+                    }
+                    hn::Store(s1, kD, group_states + (2 * f) * kLanes);
+                    hn::Store(s2, kD, group_states + (2 * f + 1) * kLanes);
+                }
+                // sum the weighted deviations of all lanes
+                const auto w = hn::Load(kD, weights_[group].data());
+                for (size_t i = 0; i < num_samples; ++i) {
+                    const auto y = hn::Load(kD, interleaved_.data() + i * kLanes);
+                    const auto d = hn::Sub(y, hn::Set(kD, static_cast<double>(buffer[i])));
+                    deviations[i] += hn::ReduceSum(kD, hn::Mul(d, w));
+                }
+            }
+            if constexpr (!bypass) {
+                for (size_t i = 0; i < num_samples; ++i) {
+                    buffer[i] = static_cast<FloatType>(static_cast<double>(buffer[i]) + deviations[i]);
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,205 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <span>
+#include <vector>
+#include <algorithm>
+
+#include "svf_base.hpp"
+#include "../iir/iir.hpp"
+#include "../coeff/ivantsov_coeff.hpp"
+
+namespace zldsp::filter {
+    /**
+     * a state-variable IIR filter which processes audio on the real-time thread
+     * the sections are designed like TDF and converted to trapezoidal SVF form
+     * while only the frequency is smoothing, the parameters are designed once per block
+     * and each sample only retunes the integrator gains, which costs one tan per sample and one division per section
+     * @tparam FloatType the float type of input audio buffer
+     * @tparam kFilterSize the number of cascading filters
+     */
+    template <typename FloatType, size_t kFilterSize>
+    class SVF final : public IIR<kFilterSize> {
+    public:
+        SVF() :
+            IIR<kFilterSize>() {
+        }
+
+        void reset() override {
+            std::ranges::fill(ic1s_, static_cast<FloatType>(0));
+            std::ranges::fill(ic2s_, static_cast<FloatType>(0));
+        }
+
+        void prepare(const double sample_rate, const size_t num_channels, const size_t) override {
+            IIR<kFilterSize>::prepareSampleRate(sample_rate);
+            ic1s_.assign(num_channels * kFilterSize, static_cast<FloatType>(0));
+            ic2s_.assign(num_channels * kFilterSize, static_cast<FloatType>(0));
+        }
+
+        /**
+         * process the incoming audio buffer
+         * @param buffer
+         * @param num_samples
+         */
+        template <bool bypass = false>
+        void process(std::span<FloatType*> buffer, const size_t num_samples) {
+            if (this->current_filter_num_ == 0) {
+                return;
+            }
+            if (isFirstOrder()) {
+                processSmooth<true, bypass>(buffer, num_samples);
+            } else {
+                processSmooth<false, bypass>(buffer, num_samples);
+            }
+        }
+
+        /**
+         * update filter coefficients
+         */
+        void updateCoeffs() override {
+            const auto next_freq = this->c_freq_.getCurrent();
+            const auto next_gain = this->c_gain_.getCurrent();
+            const auto next_q = this->c_q_.getCurrent();
+            this->current_filter_num_ = FilterDesign::updateCoeffs<IvantsovCoeff>(
+                this->c_filter_type_, this->c_order_,
+                next_freq, this->sample_rate_,
+                next_gain, next_q, this->coeffs_);
+            if (isFirstOrder()) {
+                for (size_t i = 0; i < this->current_filter_num_; ++i) {
+                    paras_[i] = SVFBase::get1stOrder(this->coeffs_[i]);
+                    updateKernel<true>(i);
+                }
+            } else {
+                for (size_t i = 0; i < this->current_filter_num_; ++i) {
+                    paras_[i] = SVFBase::get2ndOrder(this->coeffs_[i]);
+                    updateKernel<false>(i);
+                }
+            }
+        }
+
+    private:
+        enum SmoothMode {
+            kSmoothOff, kSmoothFreq, kSmoothFull
+        };
+
+        // keep tan(pi * w) finite
+        static constexpr double kMaxW = 0.4999;
+
+        // SVF parameters {g, k, m0, m1, m2}
+        std::array<std::array<double, 5>, kFilterSize> paras_{};
+        // {a1, a2, a3} of 2nd order sections, {g / (1 + g)} of 1st order sections
+        std::array<std::array<double, 3>, kFilterSize> kernels_{};
+        // g divided by tan(pi * w) at the frequency of the last design
+        std::array<double, kFilterSize> g_scales_{};
+        bool to_redesign_{false};
+
+        std::vector<FloatType> ic1s_{};
+        std::vector<FloatType> ic2s_{};
+
+        [[nodiscard]] bool isFirstOrder() const {
+            return this->c_filter_type_ == kFlatTilt || this->c_order_ == 1;
+        }
+
+        [[nodiscard]] double getTan(const double freq) const {
+            return std::tan(pi * std::min(freq / this->sample_rate_, kMaxW));
+        }
+
+        template <bool first_order, bool bypass>
+        void processSmooth(std::span<FloatType*> buffer, const size_t num_samples) {
+            // the frequency of flat tilts only changes the makeup gain, which needs a full design
+            if (this->c_gain_.isSmoothing() || this->c_q_.isSmoothing()
+                || (this->c_freq_.isSmoothing() && this->c_filter_type_ == kFlatTilt)) {
+                processSVF<first_order, bypass, kSmoothFull>(buffer, num_samples);
+            } else if (this->c_freq_.isSmoothing()) {
+                // design at the current frequency, the retuned gains drift from the design within the block
+                updateCoeffs();
+                const auto inv_t = 1.0 / getTan(this->c_freq_.getCurrent());
+                for (size_t i = 0; i < this->current_filter_num_; ++i) {
+                    g_scales_[i] = paras_[i][0] * inv_t;
+                }
+                processSVF<first_order, bypass, kSmoothFreq>(buffer, num_samples);
+                to_redesign_ = true;
+            } else {
+                if (to_redesign_) {
+                    to_redesign_ = false;
+                    updateCoeffs();
+                }
+                processSVF<first_order, bypass, kSmoothOff>(buffer, num_samples);
+            }
+        }
+
+        template <bool first_order, bool bypass, SmoothMode smooth>
+        void processSVF(std::span<FloatType*> buffer, const size_t num_samples) {
+            for (size_t i = 0; i < num_samples; ++i) {
+                if constexpr (smooth == kSmoothFull) {
+                    this->c_freq_.getNext();
+                    this->c_gain_.getNext();
+                    this->c_q_.getNext();
+                    updateCoeffs();
+                } else if constexpr (smooth == kSmoothFreq) {
+                    const auto t = getTan(this->c_freq_.getNext());
+                    for (size_t idx = 0; idx < this->current_filter_num_; ++idx) {
+                        paras_[idx][0] = t * g_scales_[idx];
+                        updateKernel<first_order>(idx);
+                    }
+                }
+                for (size_t channel = 0; channel < buffer.size(); ++channel) {
+                    if constexpr (bypass) {
+                        processSample<first_order>(channel, buffer[channel][i]);
+                    } else {
+                        buffer[channel][i] = processSample<first_order>(channel, buffer[channel][i]);
+                    }
+                }
+            }
+        }
+
+        template <bool first_order>
+        FloatType processSample(const size_t channel, const FloatType sample) {
+            const size_t channel_offset = channel * kFilterSize;
+            auto x = static_cast<double>(sample);
+            for (size_t filter_idx = 0; filter_idx < this->current_filter_num_; ++filter_idx) {
+                const auto& para{paras_[filter_idx]};
+                const auto& kernel{kernels_[filter_idx]};
+                auto& ic1{ic1s_[channel_offset + filter_idx]};
+                if constexpr (first_order) {
+                    const auto s = static_cast<double>(ic1);
+                    const auto v = (x - s) * kernel[0];
+                    const auto low = v + s;
+                    ic1 = static_cast<FloatType>(low + v);
+                    x = para[2] * x + para[3] * low;
+                } else {
+                    auto& ic2{ic2s_[channel_offset + filter_idx]};
+                    const auto s1 = static_cast<double>(ic1);
+                    const auto s2 = static_cast<double>(ic2);
+                    const auto v3 = x - s2;
+                    const auto v1 = kernel[0] * s1 + kernel[1] * v3;
+                    const auto v2 = s2 + kernel[1] * s1 + kernel[2] * v3;
+                    ic1 = static_cast<FloatType>(2.0 * v1 - s1);
+                    ic2 = static_cast<FloatType>(2.0 * v2 - s2);
+                    x = para[2] * x + para[3] * v1 + para[4] * v2;
+                }
+            }
+            return static_cast<FloatType>(x);
+        }
+
+        template <bool first_order>
+        void updateKernel(const size_t idx) {
+            const auto g = paras_[idx][0];
+            if constexpr (first_order) {
+                kernels_[idx][0] = g / (1.0 + g);
+            } else {
+                const auto a1 = 1.0 / (1.0 + g * (g + paras_[idx][1]));
+                const auto a2 = g * a1;
+                kernels_[idx] = {a1, a2, g * a2};
+            }
+        }
+    };
+}
@@ -0,0 +1,57 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+
+namespace zldsp::filter {
+    /**
+     * conversions from TDF coefficients {a1, a2, b0, b1, b2} to trapezoidal SVF parameters {g, k, m0, m1, m2}
+     * any stable section has an exact SVF form, so the SVF keeps the (decramped) response of the coefficient design
+     */
+    class SVFBase {
+    public:
+        /**
+         * convert a 2nd order section, the output is m0 * x + m1 * band + m2 * low
+         * @param coeff TDF coefficients
+         * @return SVF parameters
+         */
+        static std::array<double, 5> get2ndOrder(const std::array<double, 5>& coeff) {
+            const auto [a1, a2, b0, b1, b2] = coeff;
+            // the pass-through section of band shelves cancels its poles on the unit circle, turn it into a gain
+            if (1.0 - a2 < 1e-12) {
+                return {0.0, 0.0, b0, 0.0, 0.0};
+            }
+            // the denominator is (1 + gk + g^2) + 2(g^2 - 1) z^-1 + (1 - gk + g^2) z^-2
+            const auto d0 = 4.0 / (1.0 - a1 + a2);
+            const auto g = std::sqrt((1.0 + a1 + a2) / (1.0 - a1 + a2));
+            const auto k = 0.5 * d0 * (1.0 - a2) / g;
+            // match the numerator at z = -1, z = 1 and its odd part
+            const auto m0 = 0.25 * d0 * (b0 - b1 + b2);
+            const auto m2 = 0.25 * d0 * (b0 + b1 + b2) / (g * g) - m0;
+            const auto m1 = 0.5 * d0 * (b0 - b2) / g - m0 * k;
+            return {g, k, m0, m1, m2};
+        }
+
+        /**
+         * convert a 1st order section packed as {a1, 0, b0, b1, 0}, the output is m0 * x + m1 * low
+         * @param coeff TDF coefficients
+         * @return SVF parameters {g, 0, m0, m1, 0}
+         */
+        static std::array<double, 5> get1stOrder(const std::array<double, 5>& coeff) {
+            const auto a1 = coeff[0], b0 = coeff[2], b1 = coeff[3];
+            const auto g = (1.0 + a1) / (1.0 - a1);
+            const auto m0 = 0.5 * (1.0 + g) * (b0 - b1);
+            const auto m1 = (1.0 + g) * (b0 - m0) / g;
+            return {g, 0.0, m0, m1, 0.0};
+        }
+    };
+}
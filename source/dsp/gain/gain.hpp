@@ -16,6 +16,8 @@
 #include "../vector/vector.hpp"
 
 namespace zldsp::gain {
+    namespace hn = hwy::HWY_NAMESPACE;
+
     template <typename FloatType>
     class Gain {
     public:
@@ -58,6 +60,23 @@ namespace zldsp::gain {
             gain_.prepare(sample_rate, ramp_length_in_seconds);
         }
 
+        /**
+         * get the step of the linear gain ramp, the gain of the k-th next sample is
+         * current + step * (k + 1), bounded by the target
+         * @return
+         */
+        FloatType getRampStep() const noexcept {
+            return gain_.getStep();
+        }
+
+        /**
+         * advance the gain ramp by several samples
+         * @param num_samples
+         */
+        void skip(const size_t num_samples) noexcept {
+            gain_.skip(num_samples);
+        }
+
         template <bool bypass = false>
         void process(std::span<FloatType*> buffer, const size_t num_samples) {
             if (!gain_.isSmoothing()) {
@@ -68,18 +87,47 @@ namespace zldsp::gain {
                     vector::multiply(buffer[chan], gain_.getCurrent(), num_samples);
                 }
             } else {
-                for (size_t idx = 0; idx < num_samples; ++idx) {
-                    const auto gain = gain_.getNext();
-                    if constexpr (!bypass) {
-                        for (size_t chan = 0; chan < buffer.size(); ++chan) {
-                            buffer[chan][idx] *= gain;
-                        }
+                if constexpr (!bypass) {
+                    for (size_t chan = 0; chan < buffer.size(); ++chan) {
+                        processRamp(buffer[chan], num_samples);
                     }
                 }
+                gain_.skip(num_samples);
             }
         }
 
     private:
         zldsp::chore::SmoothedValue<FloatType, zldsp::chore::SmoothedTypes::kFixLin> gain_{FloatType(1)};
+
+        void processRamp(FloatType* __restrict buffer, const size_t num_samples) const {
+            static constexpr hn::ScalableTag<FloatType> d;
+            static constexpr size_t lanes = hn::MaxLanes(d);
+            const auto start = gain_.getCurrent();
+            const auto step = gain_.getStep();
+            const auto target = gain_.getTarget();
+            const auto v_start = hn::Set(d, start);
+            const auto v_step = hn::Set(d, step);
+            const auto v_target = hn::Set(d, target);
+            const auto v_lanes = hn::Set(d, static_cast<FloatType>(lanes));
+            auto v_idx = hn::Iota(d, FloatType(1));
+            size_t i = 0;
+            if (step > FloatType(0)) {
+                for (; i + lanes <= num_samples; i += lanes) {
+                    const auto v_gain = hn::Min(hn::MulAdd(v_idx, v_step, v_start), v_target);
+                    hn::StoreU(hn::Mul(hn::LoadU(d, buffer + i), v_gain), d, buffer + i);
+                    v_idx = hn::Add(v_idx, v_lanes);
+                }
+            } else {
+                for (; i + lanes <= num_samples; i += lanes) {
+                    const auto v_gain = hn::Max(hn::MulAdd(v_idx, v_step, v_start), v_target);
+                    hn::StoreU(hn::Mul(hn::LoadU(d, buffer + i), v_gain), d, buffer + i);
+                    v_idx = hn::Add(v_idx, v_lanes);
+                }
+            }
+            for (; i < num_samples; ++i) {
+                const auto gain = start + step * static_cast<FloatType>(i + 1);
+                buffer[i] *= step > FloatType(0) ? std::min(gain, target) : std::max(gain, target);
+            }
+        }
     };
 }
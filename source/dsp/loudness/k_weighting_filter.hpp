@@ -10,17 +10,29 @@
 #pragma once
 
 #include <algorithm>
-#include <numbers>
-#include "../filter/iir_filter/tdf/tdf.hpp"
+#include <array>
+#include <span>
+#include "../vector/vector.hpp"
+#include "../filter/filter_design/filter_design.hpp"
+#include "../filter/iir_filter/coeff/ivantsov_coeff.hpp"
 
 namespace zldsp::loudness {
+    namespace hn = hwy::HWY_NAMESPACE;
+
     /**
      * a K-weighting filter used for integrated loudness measurement
+     * channels are packed into SIMD lanes and filtered in double precision by a fused biquad cascade
+     * the filter does not write back the weighted signal, it only accumulates the sum of squares of each channel
      * @tparam FloatType the float type of input audio buffer
      */
     template <typename FloatType>
     class KWeightingFilter {
+        using DTag = hn::CappedTag<double, 4>;
+        static constexpr DTag kD{};
+
     public:
+        static constexpr size_t kLanes = hn::MaxLanes(kD);
+
         /**
          *
          * @param use_low_pass whether to use an extra lowpass filter at 22,000 Hz
@@ -30,57 +42,130 @@ namespace zldsp::loudness {
         }
 
         void prepare(const double sample_rate, const size_t num_channels) {
-            {
-                high_pass_.prepare(sample_rate, num_channels, 0);
-                high_pass_.setFilterType(filter::FilterType::kHighPass);
-                high_pass_.setOrder(2);
-                high_pass_.setFreq(38.13713296248405);
-                high_pass_.setQ(0.500242812458813);
-                high_pass_.updateCoeffs();
-            }
-            {
-                high_shelf_.prepare(sample_rate, num_channels, 0);
-                high_shelf_.setFilterType(filter::FilterType::kHighShelf);
-                high_shelf_.setOrder(2);
-                high_shelf_.setFreq(1500.6868667368922);
-                high_shelf_.setGain(3.9993623475151354);
-                high_shelf_.setQ(0.7096433028107384);
-                high_shelf_.updateCoeffs();
-            }
+            using filter::FilterType;
+            std::array<std::array<double, 5>, 1> coeff{};
+            filter::FilterDesign::updateCoeffs<filter::IvantsovCoeff>(
+                FilterType::kHighPass, 2, 38.13713296248405, sample_rate,
+                0.0, 0.500242812458813, coeff);
+            coeffs_[0] = coeff[0];
+            filter::FilterDesign::updateCoeffs<filter::IvantsovCoeff>(
+                FilterType::kHighShelf, 2, 1500.6868667368922, sample_rate,
+                3.9993623475151354, 0.7096433028107384, coeff);
+            coeffs_[1] = coeff[0];
             low_pass_enabled_ = use_low_pass_ && sample_rate > 40000.0;
             if (low_pass_enabled_) {
-                low_pass_.prepare(sample_rate, num_channels, 0);
-                low_pass_.setFilterType(filter::FilterType::kLowPass);
-                low_pass_.setOrder(2);
-                low_pass_.setFreq(std::min(22000.0, 0.49964 * sample_rate));
-                low_pass_.setQ(0.7071067811865476);
-                low_pass_.updateCoeffs();
+                filter::FilterDesign::updateCoeffs<filter::IvantsovCoeff>(
+                    FilterType::kLowPass, 2, std::min(22000.0, 0.49964 * sample_rate), sample_rate,
+                    0.0, 0.7071067811865476, coeff);
+                coeffs_[2] = coeff[0];
             }
+            // fold the bias into the numerator of the last stage
+            auto& last_coeff{coeffs_[low_pass_enabled_ ? 2 : 1]};
+            for (size_t i = 2; i < 5; ++i) {
+                last_coeff[i] *= kBias;
+            }
+
+            num_channels_ = num_channels;
+            num_groups_ = (num_channels + kLanes - 1) / kLanes;
+            states_.resize(num_groups_ * kMaxFilterNum * 2 * kLanes);
+            interleaved_.resize(kChunkSize * kLanes);
+            reset();
         }
 
         void reset() {
-            high_pass_.reset();
-            high_shelf_.reset();
-            if (low_pass_enabled_) {
-                low_pass_.reset();
-            }
+            std::fill(states_.begin(), states_.end(), 0.0);
+            std::fill(interleaved_.begin(), interleaved_.end(), 0.0);
         }
 
-        void process(std::span<FloatType*> buffer, const size_t num_samples) {
-            high_pass_.process(buffer, num_samples);
-            high_shelf_.process(buffer, num_samples);
+        /**
+         * filter the incoming audio buffer and accumulate the sum of squares of the weighted signal
+         * @param buffer the audio buffer, which is left untouched
+         * @param start_idx the index of the first sample to process
+         * @param num_samples the number of samples to process
+         * @param sum_squares the per-channel sum of squares, which is accumulated
+         */
+        void accumulate(std::span<FloatType* const> buffer, const size_t start_idx, const size_t num_samples,
+                        std::span<double> sum_squares) {
             if (low_pass_enabled_) {
-                low_pass_.process(buffer, num_samples);
-            }
-            for (size_t chan = 0; chan < buffer.size(); chan++) {
-                zldsp::vector::multiply(buffer[chan], kBias, num_samples);
+                accumulateCascade<true>(buffer, start_idx, num_samples, sum_squares);
+            } else {
+                accumulateCascade<false>(buffer, start_idx, num_samples, sum_squares);
             }
         }
 
+        size_t getNumChannels() const {
+            return num_channels_;
+        }
+
     private:
+        static constexpr size_t kMaxFilterNum = 3;
+        static constexpr size_t kChunkSize = 256;
+        static constexpr double kBias = 1.0051643348917434;
+
         bool use_low_pass_{false};
         bool low_pass_enabled_{false};
-        zldsp::filter::TDF<FloatType, 1> high_pass_, high_shelf_, low_pass_;
-        static constexpr FloatType kBias = static_cast<FloatType>(1.0051643348917434);
+        std::array<std::array<double, 5>, kMaxFilterNum> coeffs_{};
+        size_t num_channels_{0}, num_groups_{0};
+        // per group: [filter][s1, s2][lane]
+        vector::aligned_vector<double> states_;
+        // interleaved samples of one group: [sample][lane]
+        vector::aligned_vector<double> interleaved_;
+
+        template <bool kUseLowPass>
+        void accumulateCascade(std::span<FloatType* const> buffer, const size_t start_idx, const size_t num_samples,
+                               std::span<double> sum_squares) {
+            static constexpr size_t kFilterNum = kUseLowPass ? 3 : 2;
+            using V = hn::VFromD<DTag>;
+            std::array<std::array<V, 5>, kFilterNum> c;
+            for (size_t f = 0; f < kFilterNum; ++f) {
+                for (size_t k = 0; k < 5; ++k) {
+                    c[f][k] = hn::Set(kD, coeffs_[f][k]);
+                }
+            }
+            for (size_t group = 0; group < num_groups_; ++group) {
+                const auto chan_start = group * kLanes;
+                const auto chan_end = std::min(chan_start + kLanes, num_channels_);
+                double* group_states = states_.data() + group * kMaxFilterNum * 2 * kLanes;
+                std::array<V, kFilterNum> s1, s2;
+                for (size_t f = 0; f < kFilterNum; ++f) {
+                    s1[f] = hn::Load(kD, group_states + (2 * f) * kLanes);
+                    s2[f] = hn::Load(kD, group_states + (2 * f + 1) * kLanes);
+                }
+                auto acc = hn::Zero(kD);
+                size_t idx = 0;
+                while (idx < num_samples) {
+                    const auto chunk = std::min(kChunkSize, num_samples - idx);
+                    // interleave the channels of this group, unused lanes stay zero
+                    for (size_t chan = chan_start; chan < chan_end; ++chan) {
+                        const FloatType* src = buffer[chan] + start_idx + idx;
+                        double* dest = interleaved_.data() + (chan - chan_start);
+                        for (size_t i = 0; i < chunk; ++i) {
+                            dest[i * kLanes] = static_cast<double>(src[i]);
+                        }
+                    }
+                    // run the fused cascade with all states kept in registers
+                    for (size_t i = 0; i < chunk; ++i) {
+                        auto x = hn::Load(kD, interleaved_.data() + i * kLanes);
+                        for (size_t f = 0; f < kFilterNum; ++f) {
+                            const auto y = hn::MulAdd(x, c[f][2], s1[f]);
+                            s1[f] = hn::Add(hn::NegMulAdd(y, c[f][0], hn::Mul(x, c[f][3])), s2[f]);
+                            s2[f] = hn::NegMulAdd(y, c[f][1], hn::Mul(x, c[f][4]));
+                            x = y;
+                        }
+                        acc = hn::MulAdd(x, x, acc);
+                    }
+                    idx += chunk;
+                }
+                for (size_t f = 0; f < kFilterNum; ++f) {
+                    hn::Store(s1[f], kD, group_states + (2 * f) * kLanes);
+                    hn::Store(s2[f], kD, group_states + (2 * f + 1) * kLanes);
+                }
+                alignas(64) std::array<double, kLanes> acc_lanes{};
+                hn::Store(acc, kD, acc_lanes.data());
+                for (size_t chan = chan_start; chan < chan_end; ++chan) {
+                    sum_squares[chan] += acc_lanes[chan - chan_start];
+                }
+            }
+        }
     };
 }
@@ -10,5 +10,6 @@
 #pragma once
 
 #include "k_weighting_filter.hpp"
+#include "loudness_histogram.hpp"
 #include "lufs_meter.hpp"
 #include "lufs_matcher.hpp"
@@ -0,0 +1,118 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include "../vector/vector.hpp"
+
+namespace zldsp::loudness {
+    /**
+     * a 0.1 LU histogram of gated mean squares from -70 LKFS to 0 LKFS
+     * @tparam FloatType the float type of the loudness values
+     */
+    template <typename FloatType>
+    class LoudnessHistogram {
+    public:
+        static constexpr FloatType kMinLoudness = FloatType(-100);
+
+        static FloatType toLUFS(const double mean_square) {
+            return static_cast<FloatType>(-0.691 + 10.0 * std::log10(std::max(mean_square, 1e-11)));
+        }
+
+        LoudnessHistogram() {
+            counts_.resize(kHistogramSize);
+            sums_.resize(kHistogramSize);
+        }
+
+        void reset() {
+            std::fill(counts_.begin(), counts_.end(), FloatType(0));
+            std::fill(sums_.begin(), sums_.end(), FloatType(0));
+        }
+
+        /**
+         * add a mean square to the histogram if it passes the absolute gate
+         * @param mean_square
+         */
+        void push(const double mean_square) {
+            if (mean_square >= kAbsoluteGate) {
+                // if greater than -70 LKFS
+                const auto lkfs = std::min(toLUFS(mean_square), FloatType(0));
+                const auto hist_idx = static_cast<size_t>(std::round(-lkfs * FloatType(10)));
+                counts_[hist_idx] += FloatType(1);
+                sums_[hist_idx] += static_cast<FloatType>(mean_square);
+            }
+        }
+
+        /**
+         * calculate the integrated loudness with the -10 LU relative gate
+         * @return
+         */
+        FloatType getIntegratedLoudness() const {
+            const auto total_count = vector::sum(counts_.data(), counts_.size());
+            if (total_count < FloatType(0.5)) { return kMinLoudness; }
+            const auto total_sum = vector::sum(sums_.data(), sums_.size());
+            const auto total_mean_square = total_sum / total_count;
+            const auto total_lufs = FloatType(-0.691) + FloatType(10) * std::log10(total_mean_square);
+            if (total_lufs <= FloatType(-60)) {
+                return total_lufs;
+            } else {
+                const auto end_idx = static_cast<size_t>(std::round(-(total_lufs - FloatType(10)) * FloatType(10)));
+                const auto sub_count = vector::sum(counts_.data(), end_idx);
+                const auto sub_sum = vector::sum(sums_.data(), end_idx);
+                const auto sub_mean_square = sub_sum / sub_count;
+                const auto sub_lufs = FloatType(-0.691) + FloatType(10) * std::log10(sub_mean_square);
+                return sub_lufs;
+            }
+        }
+
+        /**
+         * calculate the loudness range (EBU Tech 3342) with the -20 LU relative gate
+         * @return the difference between the 95th and the 10th percentile
+         */
+        FloatType getLoudnessRange() const {
+            const auto total_count = vector::sum(counts_.data(), counts_.size());
+            if (total_count < FloatType(0.5)) { return FloatType(0); }
+            const auto total_sum = vector::sum(sums_.data(), sums_.size());
+            const auto relative_gate = FloatType(-0.691) + FloatType(10) * std::log10(total_sum / total_count)
+                - FloatType(20);
+            const auto end_idx = std::min(
+                static_cast<size_t>(std::max(-relative_gate * FloatType(10), FloatType(0))) + 1, kHistogramSize);
+            const auto gated_count = vector::sum(counts_.data(), end_idx);
+            if (gated_count < FloatType(0.5)) { return FloatType(0); }
+            // walk from the quietest bin to the loudest bin
+            const auto low_count = gated_count * FloatType(0.1);
+            const auto high_count = gated_count * FloatType(0.95);
+            FloatType cumulative_count{0};
+            size_t low_idx = end_idx - 1, high_idx = 0;
+            bool low_found = false;
+            for (size_t idx = end_idx; idx > 0; --idx) {
+                cumulative_count += counts_[idx - 1];
+                if (!low_found && cumulative_count >= low_count) {
+                    low_found = true;
+                    low_idx = idx - 1;
+                }
+                if (cumulative_count >= high_count) {
+                    high_idx = idx - 1;
+                    break;
+                }
+            }
+            return static_cast<FloatType>(low_idx - high_idx) * FloatType(0.1);
+        }
+
+    private:
+        static constexpr size_t kHistogramSize = 701;
+        static constexpr double kAbsoluteGate = 1.1724653045822963e-7;
+
+        vector::aligned_vector<FloatType> counts_{};
+        vector::aligned_vector<FloatType> sums_{};
+    };
+}
@@ -7,14 +7,17 @@
 //
 // You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
 
+
 #pragma once
 
 #include <atomic>
-#include "lufs_meter.hpp"
+#include "k_weighting_filter.hpp"
+#include "loudness_histogram.hpp"
 
 namespace zldsp::loudness {
     /**
      * an integrated matcher which matches the loudness of pre and post
+     * pre and post channels are K-weighted together in one SIMD pass and share the 100 ms block bookkeeping
      * @tparam FloatType the float type of input audio buffer
      */
     template <typename FloatType>
@@ -25,46 +28,71 @@ namespace zldsp::loudness {
          * @param use_low_pass whether to use an extra lowpass filter at 22,000 Hz
          */
         explicit LUFSMatcher(const bool use_low_pass = true) :
-            pre_loudness_meter_(use_low_pass),
-            post_loudness_meter_(use_low_pass) {
+            k_weighting_filter_(use_low_pass) {
         }
 
         void prepare(const double sample_rate, const size_t num_channels) {
-            pre_loudness_meter_.prepare(sample_rate, num_channels);
-            post_loudness_meter_.prepare(sample_rate, num_channels);
-            sample_rate_ = sample_rate;
+            k_weighting_filter_.prepare(sample_rate, num_channels * 2);
+            num_channels_ = num_channels;
+            pointers_.resize(num_channels * 2);
+            channel_sum_squares_.resize(num_channels * 2);
+            weights_.resize(num_channels);
+            for (size_t i = 0; i < num_channels; ++i) {
+                weights_[i] = (i == 4 || i == 5) ? 1.41 : 1.0;
+            }
+            max_idx_ = static_cast<size_t>(sample_rate * 0.1);
+            mean_mul_ = 1.0 / (static_cast<double>(max_idx_) * static_cast<double>(kMomentaryBlockNum));
             reset();
         }
 
         void reset() {
-            pre_loudness_meter_.reset();
-            post_loudness_meter_.reset();
+            k_weighting_filter_.reset();
+            current_idx_ = 0;
+            ready_count_ = 0;
+            block_pos_ = 0;
+            publish_count_ = 0;
+            std::fill(channel_sum_squares_.begin(), channel_sum_squares_.end(), 0.0);
+            for (auto& block_sums : block_sums_) {
+                std::fill(block_sums.begin(), block_sums.end(), 0.0);
+            }
+            for (auto& histogram : histograms_) {
+                histogram.reset();
+            }
             loudness_diff_.store(FloatType(0), std::memory_order::relaxed);
-            current_count_ = 0.0;
         }
 
         /**
-         * process the pre audio input
-         * @param pre
-         * @param num_samples
+         * thread-safe method
+         * set how often the loudness difference is published
+         * @param seconds the publish interval, rounded to multiples of 100 ms
          */
-        void processPre(std::span<FloatType*> pre, const size_t num_samples) {
-            pre_loudness_meter_.process(pre, num_samples);
+        void setPublishInterval(const double seconds) {
+            publish_block_num_.store(std::max(static_cast<size_t>(std::round(seconds * 10.0)), size_t(1)),
+                                     std::memory_order::relaxed);
         }
 
         /**
-         * process the post audio input
+         * process the pre and the post audio
+         * @param pre
          * @param post
          * @param num_samples
          */
-        void processPost(std::span<FloatType*> post, const size_t num_samples) {
-            post_loudness_meter_.process(post, num_samples);
-            current_count_ += static_cast<double>(num_samples);
-            while (current_count_ >= sample_rate_) {
-                current_count_ -= sample_rate_;
-                const auto pre_loudness = pre_loudness_meter_.getIntegratedLoudness();
-                const auto post_loudness = post_loudness_meter_.getIntegratedLoudness();
-                loudness_diff_.store(post_loudness - pre_loudness, std::memory_order::relaxed);
+        void process(std::span<FloatType* const> pre, std::span<FloatType* const> post, const size_t num_samples) {
+            for (size_t chan = 0; chan < num_channels_; ++chan) {
+                pointers_[chan] = pre[chan];
+                pointers_[chan + num_channels_] = post[chan];
+            }
+            size_t start_idx = 0;
+            while (start_idx < num_samples) {
+                const auto num_to_process = std::min(max_idx_ - current_idx_, num_samples - start_idx);
+                k_weighting_filter_.accumulate(pointers_, start_idx, num_to_process, channel_sum_squares_);
+                start_idx += num_to_process;
+                current_idx_ += num_to_process;
+                if (current_idx_ == max_idx_) {
+                    // now we get a full 100 ms small block
+                    current_idx_ = 0;
+                    update();
+                }
             }
         }
 
@@ -78,8 +106,55 @@ namespace zldsp::loudness {
         }
 
     private:
-        LUFSMeter<FloatType> pre_loudness_meter_, post_loudness_meter_;
+        static constexpr size_t kMomentaryBlockNum = 4;
+        // by default the loudness difference is published once per second, i.e., every ten 100 ms blocks
+        static constexpr size_t kPublishBlockNum = 10;
+
+        KWeightingFilter<FloatType> k_weighting_filter_;
+        size_t num_channels_{0};
+        // pre channels followed by post channels
+        std::vector<FloatType*> pointers_;
+        std::vector<double> channel_sum_squares_;
+        std::vector<double> weights_;
+        size_t current_idx_{0}, max_idx_{1};
+        size_t ready_count_{0}, block_pos_{0}, publish_count_{0};
+        double mean_mul_{1};
+        // circular 100 ms block sums of pre and post
+        std::array<std::array<double, kMomentaryBlockNum>, 2> block_sums_{};
+        std::array<LoudnessHistogram<FloatType>, 2> histograms_;
+
+        std::atomic<size_t> publish_block_num_{kPublishBlockNum};
         std::atomic<FloatType> loudness_diff_{FloatType(0)};
-        double sample_rate_{48000}, current_count_{0};
+
+        void update() {
+            // calculate the weighted sum square of the small block, for pre and post
+            for (size_t i = 0; i < 2; ++i) {
+                double sum_square = 0.0;
+                for (size_t chan = 0; chan < num_channels_; ++chan) {
+                    auto& channel_sum_square{channel_sum_squares_[chan + i * num_channels_]};
+                    sum_square += channel_sum_square * weights_[chan];
+                    channel_sum_square = 0.0;
+                }
+                block_sums_[i][block_pos_] = sum_square;
+            }
+            block_pos_ = (block_pos_ + 1) % kMomentaryBlockNum;
+            if (ready_count_ < kMomentaryBlockNum - 1) {
+                ready_count_ += 1;
+            } else {
+                // update histograms with the momentary mean square
+                for (size_t i = 0; i < 2; ++i) {
+                    const auto& block_sums{block_sums_[i]};
+                    histograms_[i].push((block_sums[0] + block_sums[1] + block_sums[2] + block_sums[3]) * mean_mul_);
+                }
+            }
+            // publish the loudness difference
+            publish_count_ += 1;
+            if (publish_count_ >= publish_block_num_.load(std::memory_order::relaxed)) {
+                publish_count_ = 0;
+                const auto pre_loudness = histograms_[0].getIntegratedLoudness();
+                const auto post_loudness = histograms_[1].getIntegratedLoudness();
+                loudness_diff_.store(post_loudness - pre_loudness, std::memory_order::relaxed);
+            }
+        }
     };
 }
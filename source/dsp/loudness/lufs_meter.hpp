@@ -9,10 +9,17 @@
 
 #pragma once
 
+#include <atomic>
 #include "../vector/vector.hpp"
 #include "k_weighting_filter.hpp"
+#include "loudness_histogram.hpp"
 
 namespace zldsp::loudness {
+    /**
+     * a loudness meter which measures momentary, short-term, integrated loudness and loudness range
+     * all measurements are derived from the sum of squares of 100 ms blocks
+     * @tparam FloatType the float type of input audio buffer
+     */
     template <typename FloatType>
     class LUFSMeter {
     public:
@@ -22,26 +29,19 @@ namespace zldsp::loudness {
          */
         explicit LUFSMeter(const bool use_low_pass = true) :
             k_weighting_filter_(use_low_pass) {
-            histogram_.resize(701);
-            histogram_sums_.resize(701);
         }
 
         void prepare(const double sample_rate, const size_t num_channels) {
             k_weighting_filter_.prepare(sample_rate, num_channels);
             weights_.resize(num_channels);
             for (size_t i = 0; i < num_channels; ++i) {
-                weights_[i] = (i == 4 || i == 5) ? FloatType(1.41) : FloatType(1);
+                weights_[i] = (i == 4 || i == 5) ? 1.41 : 1.0;
             }
+            channel_sum_squares_.resize(num_channels);
 
-            max_idx_ = static_cast<int>(sample_rate * 0.1);
-            mean_mul_ = static_cast<FloatType>(2.5 / sample_rate);
-
-            small_buffer_.resize(num_channels);
-            small_buffer_ptrs_.resize(num_channels);
-            for (size_t channel = 0; channel < num_channels; ++channel) {
-                small_buffer_[channel].resize(static_cast<size_t>(max_idx_));
-                small_buffer_ptrs_[channel] = small_buffer_[channel].data();
-            }
+            max_idx_ = static_cast<size_t>(sample_rate * 0.1);
+            momentary_mul_ = 1.0 / (static_cast<double>(max_idx_) * static_cast<double>(kMomentaryBlockNum));
+            short_term_mul_ = 1.0 / (static_cast<double>(max_idx_) * static_cast<double>(kShortTermBlockNum));
             reset();
         }
 
@@ -49,99 +49,145 @@ namespace zldsp::loudness {
             k_weighting_filter_.reset();
             current_idx_ = 0;
             ready_count_ = 0;
-            std::fill(histogram_.begin(), histogram_.end(), FloatType(0));
-            std::fill(histogram_sums_.begin(), histogram_sums_.end(), FloatType(0));
-            for (auto& buffer : small_buffer_) {
-                std::fill(buffer.begin(), buffer.end(), FloatType(0));
-            }
+            block_pos_ = 0;
+            publish_count_ = 0;
+            momentary_sum_ = 0.0;
+            short_term_sum_ = 0.0;
+            std::fill(channel_sum_squares_.begin(), channel_sum_squares_.end(), 0.0);
+            std::fill(block_sums_.begin(), block_sums_.end(), 0.0);
+            histogram_.reset();
+            range_histogram_.reset();
+            momentary_loudness_.store(kMinLoudness, std::memory_order::relaxed);
+            short_term_loudness_.store(kMinLoudness, std::memory_order::relaxed);
+            integrated_loudness_.store(kMinLoudness, std::memory_order::relaxed);
+            loudness_range_.store(FloatType(0), std::memory_order::relaxed);
         }
 
-        void process(std::span<FloatType*> buffer, const size_t num_samples) {
-            const auto num_total = static_cast<int>(num_samples);
-            int start_idx = 0;
-            while (num_total - start_idx >= max_idx_ - current_idx_) {
-                // now we get a full 100 ms small block
-                const auto remaining_num = max_idx_ - current_idx_;
-                for (size_t channel = 0; channel < buffer.size(); ++channel) {
-                    vector::copy(small_buffer_[channel].data() + static_cast<size_t>(current_idx_),
-                                 buffer[channel] + static_cast<size_t>(start_idx),
-                                 static_cast<size_t>(remaining_num));
-                }
-                start_idx += remaining_num;
-                current_idx_ = 0;
-                update();
-            }
-            if (num_total - start_idx > 0) {
-                const auto remaining_num = num_total - start_idx;
-                for (size_t channel = 0; channel < buffer.size(); ++channel) {
-                    vector::copy(small_buffer_[channel].data() + static_cast<size_t>(current_idx_),
-                                 buffer[channel] + static_cast<size_t>(start_idx),
-                                 static_cast<size_t>(remaining_num));
+        void process(std::span<FloatType* const> buffer, const size_t num_samples) {
+            size_t start_idx = 0;
+            while (start_idx < num_samples) {
+                const auto num_to_process = std::min(max_idx_ - current_idx_, num_samples - start_idx);
+                k_weighting_filter_.accumulate(buffer, start_idx, num_to_process, channel_sum_squares_);
+                start_idx += num_to_process;
+                current_idx_ += num_to_process;
+                if (current_idx_ == max_idx_) {
+                    // now we get a full 100 ms small block
+                    current_idx_ = 0;
+                    update();
                 }
-                current_idx_ += remaining_num;
             }
         }
 
         FloatType getIntegratedLoudness() const {
-            const auto total_count = vector::sum(histogram_.data(), histogram_.size());
-            if (total_count < FloatType(0.5)) { return FloatType(0); }
-            const auto total_sum = vector::sum(histogram_sums_.data(), histogram_sums_.size());
-            const auto total_mean_square = total_sum / total_count;
-            const auto total_lufs = FloatType(-0.691) + FloatType(10) * std::log10(total_mean_square);
-            if (total_lufs <= FloatType(-60)) {
-                return total_lufs;
-            } else {
-                const auto end_idx = static_cast<size_t>(std::round(-(total_lufs - FloatType(10)) * FloatType(10)));
-                const auto sub_count = vector::sum(histogram_.data(), end_idx);
-                const auto sub_sum = vector::sum(histogram_sums_.data(), end_idx);
-                const auto sub_mean_square = sub_sum / sub_count;
-                const auto sub_lufs = FloatType(-0.691) + FloatType(10) * std::log10(sub_mean_square);
-                return sub_lufs;
-            }
+            return histogram_.getIntegratedLoudness();
+        }
+
+        FloatType getLoudnessRange() const {
+            return range_histogram_.getLoudnessRange();
+        }
+
+        /**
+         * thread-safe method
+         * @return the momentary loudness (400 ms)
+         */
+        FloatType getMomentaryLUFS() const {
+            return momentary_loudness_.load(std::memory_order::relaxed);
+        }
+
+        /**
+         * thread-safe method
+         * @return the short-term loudness (3 s)
+         */
+        FloatType getShortTermLUFS() const {
+            return short_term_loudness_.load(std::memory_order::relaxed);
+        }
+
+        /**
+         * thread-safe method
+         * @return the integrated loudness, published once per second
+         */
+        FloatType getIntegratedLUFS() const {
+            return integrated_loudness_.load(std::memory_order::relaxed);
+        }
+
+        /**
+         * thread-safe method
+         * @return the loudness range, published once per second
+         */
+        FloatType getLoudnessRangeLU() const {
+            return loudness_range_.load(std::memory_order::relaxed);
         }
 
     private:
+        static constexpr size_t kMomentaryBlockNum = 4;
+        static constexpr size_t kShortTermBlockNum = 30;
+        static constexpr size_t kPublishBlockNum = 10;
+        static constexpr FloatType kMinLoudness = LoudnessHistogram<FloatType>::kMinLoudness;
+
         KWeightingFilter<FloatType> k_weighting_filter_;
-        std::vector<std::vector<FloatType>> small_buffer_;
-        std::vector<FloatType*> small_buffer_ptrs_;
-        int current_idx_{0}, max_idx_{0};
-        int ready_count_{0};
-        FloatType mean_mul_{1};
-        std::array<FloatType, 4> sum_squares_{};
+        std::vector<double> weights_;
+        std::vector<double> channel_sum_squares_;
+        size_t current_idx_{0}, max_idx_{1};
+        size_t ready_count_{0}, block_pos_{0}, publish_count_{0};
+        double momentary_mul_{1}, short_term_mul_{1};
+        // circular 100 ms block sums with running sums of the momentary and the short-term window
+        std::array<double, kShortTermBlockNum> block_sums_{};
+        double momentary_sum_{0}, short_term_sum_{0};
+
+        // histogram of momentary loudness for integrated loudness
+        LoudnessHistogram<FloatType> histogram_;
+        // histogram of short-term loudness for loudness range
+        LoudnessHistogram<FloatType> range_histogram_;
 
-        vector::aligned_vector<FloatType> histogram_{};
-        vector::aligned_vector<FloatType> histogram_sums_{};
-        std::vector<FloatType> weights_;
+        std::atomic<FloatType> momentary_loudness_{kMinLoudness}, short_term_loudness_{kMinLoudness};
+        std::atomic<FloatType> integrated_loudness_{kMinLoudness}, loudness_range_{FloatType(0)};
+
+        static FloatType toLUFS(const double mean_square) {
+            return LoudnessHistogram<FloatType>::toLUFS(mean_square);
+        }
 
         void update() {
-            // perform K-weighting filtering
-            k_weighting_filter_.process(std::span(small_buffer_ptrs_), static_cast<size_t>(max_idx_));
-            // calculate the sum square of the small block
-            FloatType sum_square = 0;
-            for (size_t channel = 0; channel < small_buffer_.size(); ++channel) {
-                const auto channel_sum_square = vector::sum_sqr(small_buffer_[channel].data(),
-                                                                small_buffer_[channel].size());
-                sum_square += channel_sum_square * weights_[channel];
+            // calculate the weighted sum square of the small block
+            double sum_square = 0.0;
+            for (size_t channel = 0; channel < channel_sum_squares_.size(); ++channel) {
+                sum_square += channel_sum_squares_[channel] * weights_[channel];
+                channel_sum_squares_[channel] = 0.0;
+            }
+            // slide the momentary and the short-term window by one block
+            const auto momentary_oldest_pos = (block_pos_ + kShortTermBlockNum - kMomentaryBlockNum)
+                % kShortTermBlockNum;
+            momentary_sum_ += sum_square - block_sums_[momentary_oldest_pos];
+            short_term_sum_ += sum_square - block_sums_[block_pos_];
+            block_sums_[block_pos_] = sum_square;
+            block_pos_ = (block_pos_ + 1) % kShortTermBlockNum;
+            if (block_pos_ == 0) {
+                // recompute the running sums to get rid of accumulated rounding errors
+                short_term_sum_ = 0.0;
+                for (const auto& s : block_sums_) { short_term_sum_ += s; }
+                momentary_sum_ = 0.0;
+                for (size_t i = kShortTermBlockNum - kMomentaryBlockNum; i < kShortTermBlockNum; ++i) {
+                    momentary_sum_ += block_sums_[i];
+                }
+            }
+            ready_count_ = std::min(ready_count_ + 1, kShortTermBlockNum);
+            // update momentary loudness and the gating histogram
+            if (ready_count_ >= kMomentaryBlockNum) {
+                const auto mean_square = momentary_sum_ * momentary_mul_;
+                momentary_loudness_.store(toLUFS(mean_square), std::memory_order::relaxed);
+                histogram_.push(mean_square);
             }
-            // shift circular sumSquares
-            sum_squares_[0] = sum_squares_[1];
-            sum_squares_[1] = sum_squares_[2];
-            sum_squares_[2] = sum_squares_[3];
-            sum_squares_[3] = sum_square;
-            if (ready_count_ < 3) {
-                ready_count_ += 1;
-                return;
+            // update short-term loudness and the loudness range histogram
+            if (ready_count_ >= kShortTermBlockNum) {
+                const auto mean_square = short_term_sum_ * short_term_mul_;
+                short_term_loudness_.store(toLUFS(mean_square), std::memory_order::relaxed);
+                range_histogram_.push(mean_square);
             }
-            // calculate the mean square
-            const auto mean_square = (
-                sum_squares_[0] + sum_squares_[1] + sum_squares_[2] + sum_squares_[3]) * mean_mul_;
-            // update histogram
-            if (mean_square >= FloatType(1.1724653045822963e-7)) {
-                // if greater than -70 LKFS
-                const auto lkfs = std::min(-FloatType(0.691) + FloatType(10) * std::log10(mean_square), FloatType(0));
-                const auto hist_idx = static_cast<size_t>(std::round(-lkfs * FloatType(10)));
-                histogram_[hist_idx] += FloatType(1);
-                histogram_sums_[hist_idx] += mean_square;
+            // publish integrated loudness and loudness range
+            publish_count_ += 1;
+            if (publish_count_ == kPublishBlockNum) {
+                publish_count_ = 0;
+                integrated_loudness_.store(getIntegratedLoudness(), std::memory_order::relaxed);
+                loudness_range_.store(getLoudnessRange(), std::memory_order::relaxed);
             }
         }
     };
@@ -0,0 +1,86 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "../vector/vector.hpp"
+#include "over_sample_stage.hpp"
+#include "halfband_coeffs.hpp"
+
+namespace zldsp::oversample {
+    /**
+     * a halfband decimator which reuses the polyphase downsampling kernel of OverSampleStage
+     * it accepts blocks of arbitrary sizes and carries the odd sample to the next call
+     * @tparam FloatType
+     */
+    template <typename FloatType>
+    class HalfbandDecimator {
+    public:
+        explicit HalfbandDecimator(const halfband_coeff::CoeffID coeff_id = halfband_coeff::k64_10_100) :
+            stage_(halfband_coeff::getCoeffByID<FloatType>(coeff_id),
+                   halfband_coeff::getCoeffByID<FloatType>(coeff_id)) {
+        }
+
+        /**
+         *
+         * @param num_channels number of channels
+         * @param max_num_samples maximum number of input samples per call
+         */
+        void prepare(const size_t num_channels, const size_t max_num_samples) {
+            stage_.prepare(num_channels, max_num_samples / 2 + 1);
+            carry_.resize(num_channels);
+            reset();
+        }
+
+        void reset() {
+            stage_.reset();
+            std::fill(carry_.begin(), carry_.end(), FloatType(0));
+            has_carry_ = false;
+        }
+
+        /**
+         * decimate the input by 2
+         * @param in input pointers
+         * @param out output pointers, should hold at least (num_samples + 1) / 2 samples
+         * @param num_samples number of input samples
+         * @return number of output samples
+         */
+        size_t process(std::span<const FloatType* const> in, std::span<FloatType*> out, const size_t num_samples) {
+            if (num_samples == 0) {
+                return 0;
+            }
+            const auto num_total = num_samples + (has_carry_ ? 1 : 0);
+            const auto num_out = num_total >> 1;
+            auto& os_buffers{stage_.getOSBuffer()};
+            for (size_t chan = 0; chan < in.size(); ++chan) {
+                auto* os_data = os_buffers[chan].data();
+                if (has_carry_) {
+                    os_data[0] = carry_[chan];
+                    std::copy(in[chan], in[chan] + (num_out << 1) - 1, os_data + 1);
+                } else {
+                    std::copy(in[chan], in[chan] + (num_out << 1), os_data);
+                }
+                if ((num_total & 1) != 0) {
+                    carry_[chan] = in[chan][num_samples - 1];
+                }
+            }
+            has_carry_ = (num_total & 1) != 0;
+            if (num_out > 0) {
+                stage_.template downsample<true>(out, num_out);
+            }
+            return num_out;
+        }
+
+    private:
+        OverSampleStage<FloatType> stage_;
+        std::vector<FloatType> carry_;
+        bool has_carry_{false};
+    };
+}
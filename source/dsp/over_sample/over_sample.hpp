@@ -21,7 +21,14 @@ namespace zldsp::oversample {
     template <typename FloatType, size_t NumStage>
     class OverSampler {
     public:
-        explicit OverSampler() {
+        explicit OverSampler() : OverSampler(false) {
+        }
+
+        /**
+         *
+         * @param use_long_filters whether to use a medium filter instead of a small filter for the remaining stages
+         */
+        explicit OverSampler(const bool use_long_filters) {
             // ensure the latency is integer
             static_assert(NumStage >= 1);
             static_assert(NumStage <= 6);
@@ -30,11 +37,12 @@ namespace zldsp::oversample {
                 halfband_coeff::getCoeffByID<FloatType>(halfband_coeff::k128_05_100),
                 halfband_coeff::getCoeffByID<FloatType>(halfband_coeff::k128_05_100)
             });
-            // init the remaining stages with a small filter
+            // init the remaining stages with a small/medium filter
+            const auto coeff_ID = use_long_filters ? halfband_coeff::k64_10_100 : halfband_coeff::k32_22_100;
             for (size_t i = 1; i < NumStage; ++i) {
                 stages_.emplace_back(OverSampleStage<FloatType>{
-                    halfband_coeff::getCoeffByID<FloatType>(halfband_coeff::k32_22_100),
-                    halfband_coeff::getCoeffByID<FloatType>(halfband_coeff::k32_22_100)
+                    halfband_coeff::getCoeffByID<FloatType>(coeff_ID),
+                    halfband_coeff::getCoeffByID<FloatType>(coeff_ID)
                 });
             }
         }
@@ -0,0 +1,186 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <algorithm>
+
+#include "../vector/vector.hpp"
+
+namespace zldsp::splitter {
+    namespace hn = hwy::HWY_NAMESPACE;
+
+    /**
+     * a 4th order Linkwitz-Riley multiband splitter whose bands run in the lanes of one SIMD register
+     * the crossover tree is flattened, so band b is a cascade of one stage per crossover c:
+     * a high-pass if c < b, a low-pass if c == b and an all-pass if c > b, which aligns its phase with the upper bands
+     * the sum of all bands is the all-pass of all crossovers, i.e., it is flat in magnitude
+     * each stage is two trapezoidal SVFs which share the coefficients of the crossover and mix their outputs per lane
+     * @tparam FloatType the float type of input audio buffer
+     * @tparam kMaxBandNum the maximum number of bands, each band takes one lane
+     * @tparam kStreamNum the number of streams, e.g., channels, each of them keeps its own states
+     */
+    template <typename FloatType, size_t kMaxBandNum, size_t kStreamNum>
+    class LRSplitter {
+    public:
+        using D = hn::CappedTag<FloatType, kMaxBandNum>;
+        static_assert(hn::MaxLanes(D{}) == kMaxBandNum, "each band needs its own lane");
+
+        LRSplitter() {
+            setBandNum(1);
+        }
+
+        /**
+         * prepare the splitter and clear the states, the crossovers should be set again afterward
+         * @param sample_rate
+         */
+        void prepare(const double sample_rate) {
+            sample_rate_ = sample_rate;
+            reset();
+        }
+
+        void reset() {
+            for (auto& stream_states : states_) {
+                for (auto& section_states : stream_states) {
+                    for (auto& s : section_states) {
+                        s.fill(FloatType(0));
+                    }
+                }
+            }
+        }
+
+        /**
+         * set the number of bands and clear the states
+         * @param band_num
+         */
+        void setBandNum(const size_t band_num) {
+            band_num_ = std::clamp(band_num, static_cast<size_t>(1), kMaxBandNum);
+            for (size_t band = 0; band < kMaxBandNum; ++band) {
+                masks_[band] = band < band_num_ ? FloatType(1) : FloatType(0);
+                for (size_t c = 0; c < kStageNum; ++c) {
+                    auto& mix0{mixes_[2 * c]};
+                    auto& mix1{mixes_[2 * c + 1]};
+                    if (band >= band_num_ || c + 1 >= band_num_) {
+                        setMix(mix0, band, kIdentity);
+                        setMix(mix1, band, kIdentity);
+                    } else if (c < band) {
+                        setMix(mix0, band, kHighPass);
+                        setMix(mix1, band, kHighPass);
+                    } else if (c == band) {
+                        setMix(mix0, band, kLowPass);
+                        setMix(mix1, band, kLowPass);
+                    } else {
+                        setMix(mix0, band, kAllPass);
+                        setMix(mix1, band, kIdentity);
+                    }
+                }
+            }
+            reset();
+        }
+
+        [[nodiscard]] size_t getBandNum() const {
+            return band_num_;
+        }
+
+        /**
+         * set the frequency of one crossover, the crossovers should be ascending
+         * @param idx the crossover idx, the crossover idx splits band idx and band idx + 1
+         * @param freq
+         */
+        void setCrossover(const size_t idx, const double freq) {
+            const auto g = std::tan(std::numbers::pi * std::min(freq / sample_rate_, kMaxW));
+            const auto a1 = 1.0 / (1.0 + g * (g + kK));
+            coeffs_[idx] = {static_cast<FloatType>(a1), static_cast<FloatType>(g * a1),
+                            static_cast<FloatType>(g * g * a1)};
+        }
+
+        /**
+         * split one stream into bands, the unused bands are zeros
+         * @param stream the stream idx
+         * @param in the input samples
+         * @param out the output samples, interleaved as [sample][band]
+         * @param num_samples the number of samples
+         */
+        void process(const size_t stream, const FloatType* __restrict in, FloatType* __restrict out,
+                     const size_t num_samples) {
+            static constexpr D d;
+            const auto v_mask = hn::Load(d, masks_.data());
+            for (size_t i = 0; i < num_samples; ++i) {
+                hn::Store(hn::Mul(hn::Set(d, in[i]), v_mask), d, out + i * kMaxBandNum);
+            }
+            // run the cascades section by section with the states kept in registers
+            for (size_t section = 0; section < 2 * (band_num_ - 1); ++section) {
+                const auto& coeff{coeffs_[section / 2]};
+                const auto a1 = hn::Set(d, coeff[0]);
+                const auto a2 = hn::Set(d, coeff[1]);
+                const auto a3 = hn::Set(d, coeff[2]);
+                const auto& mix{mixes_[section]};
+                const auto m0 = hn::Load(d, mix[0].data());
+                const auto m1 = hn::Load(d, mix[1].data());
+                const auto m2 = hn::Load(d, mix[2].data());
+                auto& state{states_[stream][section]};
+                auto ic1 = hn::Load(d, state[0].data());
+                auto ic2 = hn::Load(d, state[1].data());
+                for (size_t i = 0; i < num_samples; ++i) {
+                    const auto x = hn::Load(d, out + i * kMaxBandNum);
+                    const auto v3 = hn::Sub(x, ic2);
+                    const auto v1 = hn::MulAdd(a1, ic1, hn::Mul(a2, v3));
+                    const auto v2 = hn::Add(ic2, hn::MulAdd(a2, ic1, hn::Mul(a3, v3)));
+                    ic1 = hn::Sub(hn::Add(v1, v1), ic1);
+                    ic2 = hn::Sub(hn::Add(v2, v2), ic2);
+                    const auto y = hn::MulAdd(m0, x, hn::MulAdd(m1, v1, hn::Mul(m2, v2)));
+                    hn::Store(y, d, out + i * kMaxBandNum);
+                }
+                hn::Store(ic1, d, state[0].data());
+                hn::Store(ic2, d, state[1].data());
+            }
+        }
+
+    private:
+        static constexpr size_t kStageNum = kMaxBandNum - 1;
+        // the damping of the butterworth sections
+        static constexpr double kK = std::numbers::sqrt2;
+        // keep tan(pi * w) finite
+        static constexpr double kMaxW = 0.4999;
+
+        // the output is m0 * x + m1 * bp + m2 * lp, where hp = x - k * bp - lp
+        enum MixType {
+            kIdentity, kLowPass, kHighPass, kAllPass
+        };
+
+        static constexpr std::array<std::array<FloatType, 3>, 4> kMixes{
+            std::array<FloatType, 3>{FloatType(1), FloatType(0), FloatType(0)},
+            std::array<FloatType, 3>{FloatType(0), FloatType(0), FloatType(1)},
+            std::array<FloatType, 3>{FloatType(1), static_cast<FloatType>(-kK), FloatType(-1)},
+            std::array<FloatType, 3>{FloatType(1), static_cast<FloatType>(-2 * kK), FloatType(0)}
+        };
+
+        double sample_rate_{48000.0};
+        size_t band_num_{1};
+        // per crossover: {a1, a2, a3}
+        std::array<std::array<FloatType, 3>, kStageNum> coeffs_{};
+        // per section: [m0, m1, m2][band]
+        alignas(64) std::array<std::array<std::array<FloatType, kMaxBandNum>, 3>, 2 * kStageNum> mixes_{};
+        // 1 for the used bands, otherwise 0
+        alignas(64) std::array<FloatType, kMaxBandNum> masks_{};
+        // per stream and section: [ic1, ic2][band]
+        alignas(64) std::array<std::array<std::array<std::array<FloatType, kMaxBandNum>, 2>, 2 * kStageNum>,
+                               kStreamNum> states_{};
+
+        static void setMix(std::array<std::array<FloatType, kMaxBandNum>, 3>& mix, const size_t band,
+                           const MixType type) {
+            for (size_t k = 0; k < 3; ++k) {
+                mix[k][band] = kMixes[static_cast<size_t>(type)][k];
+            }
+        }
+    };
+}
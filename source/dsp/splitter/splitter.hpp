@@ -10,3 +10,4 @@
 #pragma once
 
 #include "inplace_ms_splitter.hpp"
+#include "lr_splitter.hpp"
@@ -343,6 +343,14 @@ namespace zlgui {
             fft_extra_speed_.store(x, std::memory_order::relaxed);
         }
 
+        size_t getFFTResolutionID() const {
+            return fft_resolution_id_.load(std::memory_order::relaxed);
+        }
+
+        void setFFTResolutionID(const size_t x) {
+            fft_resolution_id_.store(x, std::memory_order::relaxed);
+        }
+
         float getMagCurveThickness() const {
             return mag_curve_thickness_.load(std::memory_order::relaxed);
         }
@@ -367,6 +375,22 @@ namespace zlgui {
             tooltip_lang_id_.store(x, std::memory_order::relaxed);
         }
 
+        size_t getBypassModeID() const {
+            return bypass_mode_id_.load(std::memory_order::relaxed);
+        }
+
+        void setBypassModeID(const size_t x) {
+            bypass_mode_id_.store(x, std::memory_order::relaxed);
+        }
+
+        size_t getOfflineOversampleID() const {
+            return offline_oversample_id_.load(std::memory_order::relaxed);
+        }
+
+        void setOfflineOversampleID(const size_t x) {
+            offline_oversample_id_.store(x, std::memory_order::relaxed);
+        }
+
         void loadFromAPVTS();
 
         void saveToAPVTS() const;
@@ -421,8 +445,11 @@ namespace zlgui {
         std::atomic<size_t> refresh_rate_id_{2};
         float rotary_drag_sensitivity_{1.f};
         std::atomic<float> fft_extra_tilt_{0.f}, fft_extra_speed_{1.f};
+        std::atomic<size_t> fft_resolution_id_{0};
         std::atomic<float> mag_curve_thickness_{1.f}, eq_curve_thickness_{1.f};
         std::atomic<size_t> tooltip_lang_id_{1};
+        std::atomic<size_t> bypass_mode_id_{0};
+        std::atomic<size_t> offline_oversample_id_{0};
 
         std::atomic<bool> is_mouse_wheel_shift_reverse_{false};
         std::atomic<bool> is_slider_double_click_open_editor_{false};
@@ -271,10 +271,13 @@ namespace zlgui {
             static_cast<size_t>(std::round(state.getRawParameterValue(zlstate::PTargetRefreshSpeed::kID)->load())));
         fft_extra_tilt_.store(loadPara(zlstate::PFFTExtraTilt::kID));
         fft_extra_speed_.store(loadPara(zlstate::PFFTExtraSpeed::kID));
+        fft_resolution_id_.store(static_cast<size_t>(std::round(loadPara(zlstate::PFFTResolution::kID))));
         mag_curve_thickness_.store(loadPara(zlstate::PMagCurveThickness::kID));
         eq_curve_thickness_.store(loadPara(zlstate::PEQCurveThickness::kID));
         tooltip_lang_id_.store(
             static_cast<size_t>(std::round(state.getRawParameterValue(zlstate::PTooltipLang::kID)->load())));
+        bypass_mode_id_.store(static_cast<size_t>(std::round(loadPara(zlstate::PBypassMode::kID))));
+        offline_oversample_id_.store(static_cast<size_t>(std::round(loadPara(zlstate::POfflineOversample::kID))));
         colour_map1_idx_ = static_cast<size_t>(loadPara(zlstate::PColourMap1Idx::kID));
         colour_map2_idx_ = static_cast<size_t>(loadPara(zlstate::PColourMap2Idx::kID));
     }
@@ -314,9 +317,13 @@ namespace zlgui {
                  static_cast<float>(refresh_rate_id_.load(std::memory_order::relaxed)));
         savePara(zlstate::PFFTExtraTilt::kID, fft_extra_tilt_.load(std::memory_order::relaxed));
         savePara(zlstate::PFFTExtraSpeed::kID, fft_extra_speed_.load(std::memory_order::relaxed));
+        savePara(zlstate::PFFTResolution::kID, static_cast<float>(fft_resolution_id_.load(std::memory_order::relaxed)));
         savePara(zlstate::PMagCurveThickness::kID, mag_curve_thickness_.load(std::memory_order::relaxed));
         savePara(zlstate::PEQCurveThickness::kID, eq_curve_thickness_.load(std::memory_order::relaxed));
         savePara(zlstate::PTooltipLang::kID, static_cast<float>(tooltip_lang_id_));
+        savePara(zlstate::PBypassMode::kID, static_cast<float>(bypass_mode_id_.load(std::memory_order::relaxed)));
+        savePara(zlstate::POfflineOversample::kID,
+                 static_cast<float>(offline_oversample_id_.load(std::memory_order::relaxed)));
         savePara(zlstate::PColourMap1Idx::kID, static_cast<float>(colour_map1_idx_));
         savePara(zlstate::PColourMap2Idx::kID, static_cast<float>(colour_map2_idx_));
     }
@@ -15,12 +15,17 @@ namespace zlpanel {
                                            const multilingual::TooltipHelper& tooltip_helper) :
         p_ref_(p), base_(base),
         rms_control_panel_(p, base, tooltip_helper),
+        multiband_control_panel_(p, base, tooltip_helper),
         rms_on_ref_(*p.parameters_.getRawParameterValue(zlp::PRMSON::kID)),
+        multiband_ref_(*p.parameters_.getRawParameterValue(zlp::PMultiBand::kID)),
         comp_direction_ref_(*p.parameters_.getRawParameterValue(zlp::PCompDirection::kID)),
         label_laf_(base),
         style_box_(zlp::PCompStyle::kChoices, base,
                    tooltip_helper.getToolTipText(multilingual::kCompressionStyle)),
         style_attachment_(style_box_.getBox(), p.parameters_, zlp::PCompStyle::kID, updater_),
+        multiband_box_(zlp::PMultiBand::kChoices, base,
+                       tooltip_helper.getToolTipText(multilingual::kMultiBand)),
+        multiband_attachment_(multiband_box_.getBox(), p.parameters_, zlp::PMultiBand::kID, updater_),
         rms_drawable_(juce::Drawable::createFromImageData(BinaryData::dline_r_svg,
                                                           BinaryData::dline_r_svgSize)),
         rms_button_(base, rms_drawable_.get(), rms_drawable_.get(),
@@ -45,11 +50,15 @@ namespace zlpanel {
         style_box_.setBufferedToImage(true);
         addAndMakeVisible(style_box_);
 
+        multiband_box_.setBufferedToImage(true);
+        addAndMakeVisible(multiband_box_);
+
         rms_button_.setImageAlpha(.5f, .5f, 1.f, 1.f);
         rms_button_.setBufferedToImage(true);
         addAndMakeVisible(rms_button_);
 
         addChildComponent(rms_control_panel_);
+        addChildComponent(multiband_control_panel_);
 
         setInterceptsMouseClicks(false, true);
     }
@@ -70,12 +79,21 @@ namespace zlpanel {
             style_box_.getBox().setItemEnabled(3, f);
             style_box_.getBox().setItemEnabled(4, f);
         }
-        const auto rms_on = rms_on_ref_.load(std::memory_order::relaxed) > .5f;
+        // the band controls take the place of the rms controls when the multiband is on
+        const auto multiband_on = multiband_ref_.load(std::memory_order::relaxed) > .5f;
+        if (multiband_on != multiband_control_panel_.isVisible()) {
+            multiband_control_panel_.setVisible(multiband_on);
+            // rms is not applied when the multiband is on
+            rms_button_.setAlpha(multiband_on ? .5f : 1.f);
+            rms_button_.setInterceptsMouseClicks(!multiband_on, !multiband_on);
+        }
+        const auto rms_on = !multiband_on && rms_on_ref_.load(std::memory_order::relaxed) > .5f;
         if (rms_on != rms_control_panel_.isVisible()) {
             rms_control_panel_.setVisible(rms_on);
         }
         updater_.updateComponents();
         rms_control_panel_.repaintCallBackSlow();
+        multiband_control_panel_.repaintCallBackSlow();
     }
 
     void BottomControlPanel::resized() {
@@ -85,7 +103,7 @@ namespace zlpanel {
         const auto button_size = getButtonSize(font_size);
         auto bound = getLocalBounds();
         bound.removeFromLeft(padding);
-        bound.removeFromLeft(slider_width);
+        multiband_box_.setBounds(bound.removeFromLeft(slider_width));
         bound.removeFromLeft(padding);
         threshold_label_.setBounds(bound.removeFromLeft(slider_width));
 
@@ -105,6 +123,7 @@ namespace zlpanel {
         bound.removeFromLeft(padding);
 
         rms_control_panel_.setBounds(bound);
+        multiband_control_panel_.setBounds(bound);
     }
 
     int BottomControlPanel::getIdealHeight() const {
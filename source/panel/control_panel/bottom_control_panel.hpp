@@ -14,6 +14,7 @@
 #include "../helper/helper.hpp"
 #include "../multilingual/tooltip_helper.hpp"
 #include "rms_control_panel.hpp"
+#include "multiband_control_panel.hpp"
 
 namespace zlpanel {
     class BottomControlPanel final : public juce::Component {
@@ -35,8 +36,10 @@ namespace zlpanel {
         zlgui::attachment::ComponentUpdater updater_;
 
         RMSControlPanel rms_control_panel_;
+        MultibandControlPanel multiband_control_panel_;
 
         std::atomic<float>& rms_on_ref_;
+        std::atomic<float>& multiband_ref_;
 
         std::atomic<float>& comp_direction_ref_;
         zlp::PCompDirection::Direction c_comp_direction_{zlp::PCompDirection::kCompress};
@@ -47,6 +50,9 @@ namespace zlpanel {
         zlgui::combobox::CompactCombobox style_box_;
         zlgui::attachment::ComboBoxAttachment<true> style_attachment_;
 
+        zlgui::combobox::CompactCombobox multiband_box_;
+        zlgui::attachment::ComboBoxAttachment<true> multiband_attachment_;
+
         const std::unique_ptr<juce::Drawable> rms_drawable_;
         zlgui::button::ClickButton rms_button_;
         zlgui::attachment::ButtonAttachment<true> rms_attachment_;
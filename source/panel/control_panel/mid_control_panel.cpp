@@ -14,6 +14,7 @@ namespace zlpanel {
                                      const multilingual::TooltipHelper& tooltip_helper) :
         p_ref_(p), base_(base),
         comp_direction_ref_(*p.parameters_.getRawParameterValue(zlp::PCompDirection::kID)),
+        multiband_ref_(*p.parameters_.getRawParameterValue(zlp::PMultiBand::kID)),
         knee_slider_("Knee", base_,
                      tooltip_helper.getToolTipText(multilingual::kKnee)),
         knee_attachment_(knee_slider_.getSlider(), p_ref_.parameters_, zlp::PKneeW::kID, updater_),
@@ -192,6 +193,13 @@ namespace zlpanel {
             }
             }
         }
+        // hold is not applied when the multiband is on
+        const auto multiband_on = multiband_ref_.load(std::memory_order::relaxed) > .5f;
+        if (multiband_on != c_multiband_on_) {
+            c_multiband_on_ = multiband_on;
+            hold_slider_.setAlpha(c_multiband_on_ ? .5f : 1.f);
+            hold_slider_.setInterceptsMouseClicks(!c_multiband_on_, !c_multiband_on_);
+        }
         updater_.updateComponents();
     }
 }
@@ -36,6 +36,9 @@ namespace zlpanel {
         std::atomic<float>& comp_direction_ref_;
         zlp::PCompDirection::Direction c_comp_direction_{zlp::PCompDirection::kCompress};
 
+        std::atomic<float>& multiband_ref_;
+        bool c_multiband_on_{false};
+
         zlgui::slider::CompactLinearSlider<true, true, true> knee_slider_;
         zlgui::attachment::SliderAttachment<true> knee_attachment_;
 
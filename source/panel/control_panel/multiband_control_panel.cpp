@@ -0,0 +1,103 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#include "multiband_control_panel.hpp"
+
+namespace zlpanel {
+    MultibandControlPanel::MultibandControlPanel(PluginProcessor& p, zlgui::UIBase& base,
+                                                 const multilingual::TooltipHelper& tooltip_helper) :
+        base_(base), updater_(),
+        multiband_ref_(*p.parameters_.getRawParameterValue(zlp::PMultiBand::kID)),
+        trim_sliders_{
+            zlgui::slider::CompactLinearSlider<false, false, false>(
+                "", base, tooltip_helper.getToolTipText(multilingual::kBandTrim)),
+            zlgui::slider::CompactLinearSlider<false, false, false>(
+                "", base, tooltip_helper.getToolTipText(multilingual::kBandTrim)),
+            zlgui::slider::CompactLinearSlider<false, false, false>(
+                "", base, tooltip_helper.getToolTipText(multilingual::kBandTrim)),
+            zlgui::slider::CompactLinearSlider<false, false, false>(
+                "", base, tooltip_helper.getToolTipText(multilingual::kBandTrim))
+        },
+        crossover_sliders_{
+            zlgui::slider::CompactLinearSlider<false, false, false>(
+                "", base, tooltip_helper.getToolTipText(multilingual::kCrossover)),
+            zlgui::slider::CompactLinearSlider<false, false, false>(
+                "", base, tooltip_helper.getToolTipText(multilingual::kCrossover)),
+            zlgui::slider::CompactLinearSlider<false, false, false>(
+                "", base, tooltip_helper.getToolTipText(multilingual::kCrossover))
+        } {
+        for (size_t i = 0; i < kBandNum; ++i) {
+            const auto ID = zlp::PBandTrim::kID + std::to_string(i);
+            trim_attachments_[i] = std::make_unique<zlgui::attachment::SliderAttachment<true>>(
+                trim_sliders_[i].getSlider(), p.parameters_, ID, updater_);
+            trim_sliders_[i].setComponentID(ID);
+        }
+        for (size_t i = 0; i + 1 < kBandNum; ++i) {
+            const auto ID = zlp::PCrossover::kID + std::to_string(i);
+            crossover_attachments_[i] = std::make_unique<zlgui::attachment::SliderAttachment<true>>(
+                crossover_sliders_[i].getSlider(), p.parameters_, ID, updater_);
+            crossover_sliders_[i].setComponentID(ID);
+        }
+        for (auto& s : trim_sliders_) {
+            s.setPrecision(3);
+            s.setFontScale(1.25f);
+            s.getSlider().setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+            s.getSlider().setSliderSnapsToMousePosition(false);
+            s.setBufferedToImage(true);
+            addChildComponent(s);
+        }
+        for (auto& s : crossover_sliders_) {
+            s.setPrecision(3);
+            s.setFontScale(1.25f);
+            s.getSlider().setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+            s.getSlider().setSliderSnapsToMousePosition(false);
+            s.setBufferedToImage(true);
+            addChildComponent(s);
+        }
+    }
+
+    void MultibandControlPanel::resized() {
+        auto bound = getLocalBounds();
+        const auto font_size = base_.getFontSize();
+        const auto padding = getPaddingSize(font_size) / 2;
+        // band 0 | crossover 0 | band 1 | crossover 1 | band 2 | crossover 2 | band 3
+        const auto width = (bound.getWidth() - padding * static_cast<int>(2 * kBandNum - 2))
+                           / static_cast<int>(2 * kBandNum - 1);
+        for (size_t i = 0; i < kBandNum; ++i) {
+            trim_sliders_[i].setBounds(bound.removeFromLeft(width));
+            bound.removeFromLeft(padding);
+            if (i + 1 < kBandNum) {
+                crossover_sliders_[i].setBounds(bound.removeFromLeft(width));
+                bound.removeFromLeft(padding);
+            }
+        }
+
+        const auto dragging_distance = getSliderDraggingDistance(font_size);
+        for (auto& s : trim_sliders_) {
+            s.setMouseDragSensitivity(dragging_distance);
+        }
+        for (auto& s : crossover_sliders_) {
+            s.setMouseDragSensitivity(dragging_distance);
+        }
+    }
+
+    void MultibandControlPanel::repaintCallBackSlow() {
+        const auto band_num = static_cast<size_t>(std::round(multiband_ref_.load(std::memory_order::relaxed))) + 1;
+        if (band_num != c_band_num_) {
+            c_band_num_ = band_num;
+            for (size_t i = 0; i < kBandNum; ++i) {
+                trim_sliders_[i].setVisible(i < c_band_num_);
+            }
+            for (size_t i = 0; i + 1 < kBandNum; ++i) {
+                crossover_sliders_[i].setVisible(i + 1 < c_band_num_);
+            }
+        }
+        updater_.updateComponents();
+    }
+}
@@ -0,0 +1,46 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "../../PluginProcessor.hpp"
+#include "../../gui/gui.hpp"
+#include "../helper/helper.hpp"
+#include "../multilingual/tooltip_helper.hpp"
+
+namespace zlpanel {
+    /**
+     * the band detector trims and the crossovers, laid out as band 0 | crossover 0 | band 1 | ... | band 3
+     * only the controls of the active bands are visible
+     */
+    class MultibandControlPanel final : public juce::Component {
+    public:
+        explicit MultibandControlPanel(PluginProcessor& p, zlgui::UIBase& base,
+                                       const multilingual::TooltipHelper& tooltip_helper);
+
+        void resized() override;
+
+        void repaintCallBackSlow();
+
+    private:
+        static constexpr size_t kBandNum = zlp::kCompBandNum;
+
+        zlgui::UIBase& base_;
+        zlgui::attachment::ComponentUpdater updater_;
+
+        std::atomic<float>& multiband_ref_;
+        size_t c_band_num_{0};
+
+        std::array<zlgui::slider::CompactLinearSlider<false, false, false>, kBandNum> trim_sliders_;
+        std::array<std::unique_ptr<zlgui::attachment::SliderAttachment<true>>, kBandNum> trim_attachments_;
+
+        std::array<zlgui::slider::CompactLinearSlider<false, false, false>, kBandNum - 1> crossover_sliders_;
+        std::array<std::unique_ptr<zlgui::attachment::SliderAttachment<true>>, kBandNum - 1> crossover_attachments_;
+    };
+}
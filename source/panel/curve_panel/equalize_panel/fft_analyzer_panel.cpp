@@ -51,9 +51,12 @@ namespace zlpanel {
             return;
         }
         const auto sample_rate = sender.getSampleRate();
-        if (std::abs(c_sample_rate_ - sample_rate) > 0.1) {
+        const auto is_multi_res = is_multi_res_.load(std::memory_order::relaxed);
+        if (std::abs(c_sample_rate_ - sample_rate) > 0.1 || c_is_multi_res_ != is_multi_res) {
             c_sample_rate_ = sample_rate;
+            c_is_multi_res_ = is_multi_res;
             to_update_tilt_.store(true, std::memory_order::relaxed);
+            to_update_decay_.store(true, std::memory_order::relaxed);
 
             int fft_order;
             if (sample_rate <= 50000) {
@@ -66,89 +69,95 @@ namespace zlpanel {
                 fft_order = 15;
             }
             fft_size_ = 1 << fft_order;
-            processor_.prepare(fft_order);
-            receiver_.prepare(1);
-            spectrum_smoother_.prepare(static_cast<size_t>(fft_size_));
-            spectrum_smoother_.setSmooth(0.5, sample_rate, zldsp::analyzer::SpectrumSmoother::SmoothMethod::kERB);
-            spectrum_tilter_.prepare(static_cast<size_t>(fft_size_));
-            spectrum_decayer_.prepare(static_cast<size_t>(fft_size_));
+            // smooth the spectrum directly onto a log-spaced grid
+            grid_freqs_.resize(kNumGridPoints);
+            grid_spectrum_.resize(kNumGridPoints);
+            const auto fft_max = static_cast<float>(zlp::getEQFFTMax(sample_rate));
+            const auto grid_mul = std::pow(fft_max / zlp::kEQMinFreq, 1.f / static_cast<float>(kNumGridPoints - 1));
+            grid_freqs_[0] = zlp::kEQMinFreq;
+            for (size_t i = 1; i < kNumGridPoints; ++i) {
+                grid_freqs_[i] = grid_freqs_[i - 1] * grid_mul;
+            }
+            if (c_is_multi_res_) {
+                // every level uses the same FFT size on a successively decimated signal
+                multi_res_analyzer_.prepare(fft_order, 1, sample_rate, kFFTOverlap);
+                multi_res_analyzer_.setGrid(0.5, zldsp::analyzer::SpectrumSmoother::SmoothMethod::kERB, grid_freqs_);
+            } else {
+                processor_.prepare(fft_order);
+                receiver_.prepare(1, static_cast<size_t>(fft_size_) / kFFTOverlap);
+                spectrum_smoother_.prepare(static_cast<size_t>(fft_size_));
+                spectrum_smoother_.setGrid(0.5, sample_rate, zldsp::analyzer::SpectrumSmoother::SmoothMethod::kERB,
+                                           grid_freqs_);
+            }
+            spectrum_decayer_.prepareGrid(kNumGridPoints);
 
-            xs_.resize(static_cast<size_t>(fft_size_) / 2 + 1);
-            ys_.resize(static_cast<size_t>(fft_size_) / 2 + 1);
+            xs_.resize(kNumGridPoints);
+            ys_.resize(kNumGridPoints);
 
             to_update_xs_ = true;
         }
 
         auto& fifo{sender.getAbstractFIFO()};
         auto num_read = fifo.getNumReady();
-        if (num_read > static_cast<int>(processor_.getFFTSize())) {
-            (void)fifo.prepareToRead(num_read - static_cast<int>(processor_.getFFTSize()));
-            fifo.finishRead(num_read - static_cast<int>(processor_.getFFTSize()));
-            num_read = static_cast<int>(processor_.getFFTSize());
+        if (num_read > fft_size_) {
+            (void)fifo.prepareToRead(num_read - fft_size_);
+            fifo.finishRead(num_read - fft_size_);
+            num_read = fft_size_;
         }
         const auto range = fifo.prepareToRead(num_read);
-        receiver_.pull(range, sender.getSampleFIFOs()[0]);
+        if (c_is_multi_res_) {
+            multi_res_analyzer_.pull(range, sender.getSampleFIFOs()[0]);
+        } else {
+            receiver_.pull(range, sender.getSampleFIFOs()[0]);
+        }
         fifo.finishRead(num_read);
         sender.getLock().unlock();
 
         if (fft_size_ <= 0) {
             return;
         }
-        receiver_.forward(zldsp::analyzer::StereoType::kStereo);
-
-        auto& spectrum{receiver_.getAbsSqrFFTBuffer()};
-        spectrum_smoother_.smooth(spectrum);
 
         if (to_update_tilt_.exchange(false, std::memory_order::acquire)) {
-            spectrum_tilter_.setTiltSlope(sample_rate, spectrum_tilt_slope_.load(std::memory_order::relaxed));
+            spectrum_tilter_.setTiltSlope(grid_freqs_, spectrum_tilt_slope_.load(std::memory_order::relaxed));
         }
         if (to_update_xs_ || std::abs(bound.getWidth() - c_width_) > 0.01f) {
             c_width_ = bound.getWidth();
-            const auto delta_freq = static_cast<float>(sample_rate / static_cast<double>(fft_size_));
-            const auto fft_max = static_cast<float>(zlp::getEQFFTMax(sample_rate));
-            const auto temp_scale = static_cast<float>(1.0 / std::log(fft_max / zlp::kEQMinFreq)) * bound.getWidth();
-            const auto temp_bias = std::log(zlp::kEQMinFreq) * temp_scale;
-            num_point_ = xs_.size();
-            for (size_t i = 1; i < xs_.size(); ++i) {
-                const auto freq = delta_freq * static_cast<float>(i);
-                xs_[i] = std::log(freq) * temp_scale - temp_bias;
-                if (freq > fft_max) {
-                    num_point_ = i;
-                    break;
-                }
+            const auto delta_x = bound.getWidth() / static_cast<float>(kNumGridPoints - 1);
+            for (size_t i = 0; i < kNumGridPoints; ++i) {
+                xs_[i] = static_cast<float>(i) * delta_x;
             }
-            xs_[0] = std::min(0.f, xs_[2] - 2.f * xs_[1]);
         }
         if (to_update_decay_.exchange(false, std::memory_order::acquire)) {
             const auto decay_speed = std::max(
                 0.1f, -spectrum_decay_speed_.load(std::memory_order::relaxed) / 20.f);
-            spectrum_decayer_.setDecaySpeed(refresh_rate_.load(std::memory_order::relaxed),
+            // the spectrum only changes once a hop is ready
+            const auto hop_size = c_is_multi_res_ ? multi_res_analyzer_.getHopSize() : receiver_.getHopSize();
+            const auto hop_rate = static_cast<float>(sample_rate / static_cast<double>(hop_size));
+            spectrum_decayer_.setDecaySpeed(std::min(refresh_rate_.load(std::memory_order::relaxed), hop_rate),
                                              -72.f, 0.15f / decay_speed);
         }
 
-        if (num_point_ < 3) {
-            return;
+        if (c_is_multi_res_) {
+            if (!multi_res_analyzer_.updateSpectrum(grid_spectrum_)) {
+                return;
+            }
+        } else {
+            if (!receiver_.updateSpectrum()) {
+                return;
+            }
+            spectrum_smoother_.smoothToGrid(receiver_.getAbsSqrFFTBuffer(), grid_spectrum_);
         }
-        zldsp::vector::sqr_mag_to_db(spectrum.data(), num_point_);
-        spectrum_tilter_.tilt(std::span{spectrum.data(), num_point_});
-        spectrum_decayer_.decay(std::span{spectrum.data(), num_point_},
-                                is_fft_frozen_.load(std::memory_order::relaxed));
-        zldsp::vector::multiply(ys_.data(), spectrum.data(), bound.getHeight() / -72.f, num_point_);
+        zldsp::vector::sqr_mag_to_db(grid_spectrum_.data(), kNumGridPoints);
+        spectrum_tilter_.tilt(grid_spectrum_);
+        spectrum_decayer_.decay(grid_spectrum_, is_fft_frozen_.load(std::memory_order::relaxed));
+        zldsp::vector::multiply(ys_.data(), grid_spectrum_.data(), bound.getHeight() / -72.f, kNumGridPoints);
 
         auto& next_out_path{out_path_.get_writer()};
         next_out_path.clear();
         PathMinimizer<10> minimizer{next_out_path};
-        const auto num_accu = static_cast<size_t>(std::sqrt(static_cast<float>(num_point_)));
         next_out_path.startNewSubPath(xs_.front() - .1f, bound.getBottom() * 1.5f);
-        for (size_t i = 0; i < num_accu; ++i) {
-            next_out_path.lineTo(xs_[i], ys_[i]);
-        }
-        minimizer.startNewSubPath<false>(xs_[num_accu], ys_[num_accu]);
-        for (size_t i = num_accu + 1; i < num_point_; ++i) {
-            minimizer.lineTo(xs_[i], ys_[i]);
-        }
-        minimizer.finish();
-        next_out_path.lineTo(xs_[num_point_ - 1] + .1f, bound.getBottom() * 1.5f);
+        minimizer.drawPath<false>(xs_, ys_);
+        next_out_path.lineTo(xs_.back() + .1f, bound.getBottom() * 1.5f);
         next_out_path.closeSubPath();
         out_path_.publish();
     }
@@ -164,6 +173,8 @@ namespace zlpanel {
 
         spectrum_tilt_slope_.store(4.5f + base_.getFFTExtraTilt(), std::memory_order::relaxed);
         to_update_tilt_.store(true, std::memory_order::release);
+
+        is_multi_res_.store(base_.getFFTResolutionID() == 1, std::memory_order::relaxed);
     }
 
     void FFTAnalyzerPanel::valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier& property) {
@@ -18,6 +18,7 @@
 #include "../../../dsp/analyzer/fft_analyzer/spectrum_smoother.hpp"
 #include "../../../dsp/analyzer/fft_analyzer/spectrum_tilter.hpp"
 #include "../../../dsp/analyzer/fft_analyzer/spectrum_decayer.hpp"
+#include "../../../dsp/analyzer/fft_analyzer/multires_fft_analyzer.hpp"
 
 namespace zlpanel {
     class FFTAnalyzerPanel final : public juce::Component,
@@ -36,6 +37,10 @@ namespace zlpanel {
         void setRefreshRate(double refresh_rate);
 
     private:
+        static constexpr size_t kFFTOverlap = 4;
+        static constexpr size_t kNumGridPoints = 400;
+        static constexpr size_t kNumResolutions = 3;
+
         PluginProcessor& p_ref_;
         zlgui::UIBase& base_;
 
@@ -43,12 +48,12 @@ namespace zlpanel {
         AtomicBound<float> atomic_bound_;
 
         std::vector<float> xs_{}, ys_{};
+        std::vector<float> grid_freqs_{}, grid_spectrum_{};
         BufferedUI<juce::Path> out_path_;
 
         double c_sample_rate_{};
         int fft_size_{0};
         float c_width_{};
-        size_t num_point_{0};
 
         std::atomic<float> refresh_rate_{30.0};
         std::atomic<float> spectrum_decay_speed_{-20.f};
@@ -59,11 +64,15 @@ namespace zlpanel {
 
         std::atomic<bool> is_fft_frozen_{false};
 
+        std::atomic<bool> is_multi_res_{false};
+        bool c_is_multi_res_{false};
+
         zldsp::analyzer::FFTAnalyzerProcessor processor_;
         zldsp::analyzer::FFTAnalyzerReceiver receiver_{processor_};
         zldsp::analyzer::SpectrumSmoother spectrum_smoother_;
         zldsp::analyzer::SpectrumTilter spectrum_tilter_;
         zldsp::analyzer::SpectrumDecayer spectrum_decayer_;
+        zldsp::analyzer::MultiResFFTAnalyzer<kNumResolutions> multi_res_analyzer_;
 
         void lookAndFeelChanged() override;
 
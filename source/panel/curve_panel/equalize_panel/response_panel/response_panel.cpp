@@ -18,8 +18,13 @@ namespace zlpanel {
           sum_panel_(base) {
         xs_.resize(kNumPoints);
         ws_.resize(kNumPoints);
+        parallel_reals_.resize(kNumPoints);
+        parallel_imags_.resize(kNumPoints);
+        parallel_mags_.resize(kNumPoints);
         for (size_t band = 0; band < zlp::kBandNum; ++band) {
             mags_[band].resize(kNumPoints);
+            reals_[band].resize(kNumPoints);
+            imags_[band].resize(kNumPoints);
             single_panels_[band] = std::make_unique<SinglePanel>(base, band, filters_[band]);
             dummy_component_.addChildComponent(single_panels_[band].get());
             const auto suffix = std::to_string(band);
@@ -31,6 +36,10 @@ namespace zlpanel {
                                      std::memory_order::relaxed));
             }
         }
+        p_ref_.parameters_.addParameterListener(zlp::PSideEQStructure::kID, this);
+        parameterChanged(zlp::PSideEQStructure::kID,
+                         p_ref_.parameters_.getRawParameterValue(zlp::PSideEQStructure::kID)->load(
+                             std::memory_order::relaxed));
         addChildComponent(dummy_component_);
         addAndMakeVisible(sum_panel_);
 
@@ -38,6 +47,7 @@ namespace zlpanel {
     }
 
     ResponsePanel::~ResponsePanel() {
+        p_ref_.parameters_.removeParameterListener(zlp::PSideEQStructure::kID, this);
         for (size_t band = 0; band < zlp::kBandNum; ++band) {
             const auto suffix = std::to_string(band);
             for (const auto& id : kBandIDs) {
@@ -78,6 +88,12 @@ namespace zlpanel {
             filters_[band].forceUpdate(paras);
             filters_[band].updateMagnitudeSquare(std::span<const float>(ws_.data(), ws_.size()), mags_[band]);
             zldsp::vector::sqr_mag_to_db(mags_[band].data(), mags_[band].size());
+            c_summed_[band] = c_filter_structure_ == zldsp::filter::kParallel
+                && zlp::EqualizeController::isSummed(paras);
+            if (c_summed_[band]) {
+                filters_[band].updateResponse(std::span<const float>(ws_.data(), ws_.size()),
+                                              reals_[band], imags_[band]);
+            }
             single_panels_[band]->run(std::span<const float>(xs_.data(), xs_.size()),
                                       std::span<const float>(mags_[band].data(), mags_[band].size()),
                                       c_bound_, eq_max_db_, c_sample_rate_, fft_max_);
@@ -88,12 +104,38 @@ namespace zlpanel {
         }
 
         if (to_update_sum_) {
+            const auto parallel_mags = updateParallelResponse()
+                                           ? std::span<const float>(parallel_mags_.data(), parallel_mags_.size())
+                                           : std::span<const float>();
             sum_panel_.run(std::span<const float>(xs_.data(), xs_.size()), mags_, c_filter_status_,
-                           c_bound_, eq_max_db_);
+                           c_summed_, parallel_mags, c_bound_, eq_max_db_);
             to_update_sum_ = false;
         }
     }
 
+    bool ResponsePanel::updateParallelResponse() {
+        std::fill(parallel_reals_.begin(), parallel_reals_.end(), 1.f);
+        std::fill(parallel_imags_.begin(), parallel_imags_.end(), 0.f);
+        bool has_summed{false};
+        for (size_t band = 0; band < zlp::kBandNum; ++band) {
+            if (c_summed_[band] && c_filter_status_[band] == zlp::EqualizeController::kOn) {
+                has_summed = true;
+                for (size_t i = 0; i < kNumPoints; ++i) {
+                    parallel_reals_[i] += reals_[band][i] - 1.f;
+                    parallel_imags_[i] += imags_[band][i];
+                }
+            }
+        }
+        if (!has_summed) {
+            return false;
+        }
+        for (size_t i = 0; i < kNumPoints; ++i) {
+            parallel_mags_[i] = parallel_reals_[i] * parallel_reals_[i] + parallel_imags_[i] * parallel_imags_[i];
+        }
+        zldsp::vector::sqr_mag_to_db(parallel_mags_.data(), parallel_mags_.size());
+        return true;
+    }
+
     void ResponsePanel::updateSampleRate(const double sample_rate) {
         sample_rate_.store(sample_rate, std::memory_order::relaxed);
     }
@@ -115,6 +157,11 @@ namespace zlpanel {
     }
 
     void ResponsePanel::parameterChanged(const juce::String& parameter_ID, const float new_value) {
+        if (parameter_ID == zlp::PSideEQStructure::kID) {
+            filter_structure_.store(static_cast<zldsp::filter::FilterStructure>(std::round(new_value)),
+                                    std::memory_order::relaxed);
+            return;
+        }
         const auto band = static_cast<size_t>(parameter_ID.getTrailingIntValue());
         if (parameter_ID.startsWith(zlp::PFilterStatus::kID)) {
             filter_status_[band].store(static_cast<zlp::EqualizeController::FilterStatus>(std::round(new_value)),
@@ -180,6 +227,13 @@ namespace zlpanel {
             force_curve_update = true;
         }
 
+        // the summed bands depend on the structure, and so does the sum curve
+        if (const auto filter_structure = filter_structure_.load(std::memory_order::relaxed);
+            filter_structure != c_filter_structure_) {
+            c_filter_structure_ = filter_structure;
+            force_curve_update = true;
+        }
+
         if (to_update_filter_status_.check()) {
             for (size_t band = 0; band < zlp::kBandNum; ++band) {
                 const auto filter_status = filter_status_[band].load(std::memory_order::relaxed);
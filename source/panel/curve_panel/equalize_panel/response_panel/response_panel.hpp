@@ -62,6 +62,10 @@ namespace zlpanel {
         std::array<std::atomic<zlp::EqualizeController::FilterStatus>, zlp::kBandNum> filter_status_{};
         std::array<zlp::EqualizeController::FilterStatus, zlp::kBandNum> c_filter_status_{};
         zlchore::thread::Notifier to_update_filter_status_{true};
+        std::atomic<zldsp::filter::FilterStructure> filter_structure_{zldsp::filter::kIIR};
+        zldsp::filter::FilterStructure c_filter_structure_{zldsp::filter::kIIR};
+        // bands which are summed by the parallel structure, the sum curve draws 1 + sum of (H_i - 1) for them
+        std::array<bool, zlp::kBandNum> c_summed_{};
 
         juce::Component dummy_component_;
         std::array<std::unique_ptr<SinglePanel>, zlp::kBandNum> single_panels_;
@@ -69,6 +73,8 @@ namespace zlpanel {
 
         zldsp::vector::aligned_vector<float> xs_, ws_;
         std::array<zldsp::vector::aligned_vector<float>, zlp::kBandNum> mags_;
+        std::array<zldsp::vector::aligned_vector<float>, zlp::kBandNum> reals_, imags_;
+        zldsp::vector::aligned_vector<float> parallel_reals_, parallel_imags_, parallel_mags_;
 
         AtomicBound<float> bound_;
         juce::Rectangle<float> c_bound_;
@@ -80,5 +86,7 @@ namespace zlpanel {
         void parameterChanged(const juce::String& parameter_ID, float new_value) override;
 
         void updateCurveParameters();
+
+        bool updateParallelResponse();
     };
 }
@@ -41,6 +41,8 @@ namespace zlpanel {
     void SumPanel::run(const std::span<const float> xs,
                        const std::array<zldsp::vector::aligned_vector<float>, zlp::kBandNum>& mags,
                        const std::array<zlp::EqualizeController::FilterStatus, zlp::kBandNum>& filter_status,
+                       const std::array<bool, zlp::kBandNum>& summed,
+                       const std::span<const float> parallel_mags,
                        const juce::Rectangle<float>& bound, const float max_db) {
         ys_.resize(xs.size());
         std::fill(ys_.begin(), ys_.end(), 0.f);
@@ -48,11 +50,19 @@ namespace zlpanel {
         for (size_t band = 0; band < zlp::kBandNum; ++band) {
             if (filter_status[band] == zlp::EqualizeController::FilterStatus::kOn) {
                 has_on_filter = true;
+                // the summed bands are included in the parallel response
+                if (summed[band]) {
+                    continue;
+                }
                 for (size_t i = 0; i < ys_.size(); ++i) {
                     ys_[i] += mags[band][i];
                 }
             }
         }
+        // the parallel response of the summed bands is in series with the other bands
+        for (size_t i = 0; i < std::min(ys_.size(), parallel_mags.size()); ++i) {
+            ys_[i] += parallel_mags[i];
+        }
 
         if (!has_on_filter) {
             std::fill(ys_.begin(), ys_.end(), bound.getCentreY());
@@ -30,6 +30,8 @@ namespace zlpanel {
         void run(std::span<const float> xs,
                  const std::array<zldsp::vector::aligned_vector<float>, zlp::kBandNum>& mags,
                  const std::array<zlp::EqualizeController::FilterStatus, zlp::kBandNum>& filter_status,
+                 const std::array<bool, zlp::kBandNum>& summed,
+                 std::span<const float> parallel_mags,
                  const juce::Rectangle<float>& bound, float max_db);
 
     private:
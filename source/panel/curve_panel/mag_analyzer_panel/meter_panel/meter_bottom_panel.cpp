@@ -0,0 +1,61 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "meter_bottom_panel.hpp"
+
+namespace zlpanel {
+    MeterBottomPanel::MeterBottomPanel(zlgui::UIBase& base) :
+        base_(base) {
+        setInterceptsMouseClicks(false, false);
+    }
+
+    void MeterBottomPanel::paint(juce::Graphics& g) {
+        auto bound = getLocalBounds().toFloat();
+        g.setColour(base_.getBackgroundColour().withAlpha(.5f));
+        g.fillRect(bound);
+
+        const auto meter_width = bound.getWidth() * .45f;
+        g.setFont(base_.getFontSize());
+        g.setColour(base_.getTextColour());
+        // short-term and integrated loudness on the first row, loudness range on the second row
+        auto row_bound = bound.removeFromTop(bound.getHeight() * .5f);
+        if (short_term_value_ > -99.f) {
+            g.drawText(formatValue(short_term_value_), row_bound.removeFromLeft(meter_width),
+                       juce::Justification::centred, false);
+        }
+        if (integrated_value_ > -99.f) {
+            g.drawText(formatValue(integrated_value_), row_bound.removeFromRight(meter_width),
+                       juce::Justification::centred, false);
+            g.drawText("LRA " + formatValue(range_value_), bound, juce::Justification::centred, false);
+        }
+    }
+
+    void MeterBottomPanel::updateValue(const float short_term_value, const float integrated_value,
+                                       const float range_value) {
+        if (std::abs(short_term_value - short_term_value_) > 0.05f
+            || std::abs(integrated_value - integrated_value_) > 0.05f
+            || std::abs(range_value - range_value_) > 0.05f) {
+            short_term_value_ = short_term_value;
+            integrated_value_ = integrated_value;
+            range_value_ = range_value;
+            repaint();
+        }
+    }
+
+    std::string MeterBottomPanel::formatValue(const float value) {
+        std::stringstream ss;
+        if (std::abs(value) < 100.f) {
+            ss << std::fixed << std::setprecision(1) << value;
+        } else {
+            ss << std::fixed << std::setprecision(0) << value;
+        }
+        return ss.str();
+    }
+}
@@ -0,0 +1,33 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "../../../../gui/gui.hpp"
+
+namespace zlpanel {
+    class MeterBottomPanel final : public juce::Component {
+    public:
+        explicit MeterBottomPanel(zlgui::UIBase& base);
+
+        void paint(juce::Graphics& g) override;
+
+        void updateValue(float short_term_value, float integrated_value, float range_value);
+
+    private:
+        zlgui::UIBase& base_;
+
+        float short_term_value_{-100.f};
+        float integrated_value_{-100.f};
+        float range_value_{0.f};
+
+        static std::string formatValue(float value);
+    };
+}
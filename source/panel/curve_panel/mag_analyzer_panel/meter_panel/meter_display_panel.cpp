@@ -12,7 +12,9 @@
 namespace zlpanel {
     MeterDisplayPanel::MeterDisplayPanel(PluginProcessor& p, zlgui::UIBase& base) :
         base_(base),
+        controller_ref_(p.getCompressController()),
         meter_top_panel_(base),
+        meter_bottom_panel_(base),
         comp_direction_ref_(*p.parameters_.getRawParameterValue(zlp::PCompDirection::kID)),
         analyzer_mag_type_ref_(*p.na_parameters_.getRawParameterValue(zlstate::PAnalyzerMagType::kID)),
         analyzer_min_db_ref_(*p.na_parameters_.getRawParameterValue(zlstate::PAnalyzerMinDB::kID)) {
@@ -26,6 +28,8 @@ namespace zlpanel {
 
         meter_top_panel_.setBufferedToImage(true);
         addAndMakeVisible(meter_top_panel_);
+        meter_bottom_panel_.setBufferedToImage(true);
+        addAndMakeVisible(meter_bottom_panel_);
     }
 
     MeterDisplayPanel::~MeterDisplayPanel() = default;
@@ -81,6 +85,8 @@ namespace zlpanel {
         const auto meter_width = static_cast<float>(bound.getWidth()) * .2f;
         const auto meter_padding = meter_width * .5f;
         meter_top_panel_.setBounds(bound.withHeight(juce::roundToInt(base_.getFontSize() * 1.25f)));
+        // the bottom panel has two rows, the loudness range is on the second row
+        meter_bottom_panel_.setBounds(bound.withTop(bound.getBottom() - juce::roundToInt(base_.getFontSize() * 2.5f)));
 
         constexpr auto x1 = 0.f;
         const auto x2 = x1 + meter_width + meter_padding * .5f;
@@ -102,6 +108,10 @@ namespace zlpanel {
     void MeterDisplayPanel::repaintCallBackSlow() {
         meter_top_panel_.updateValue(reduction_peak_.load(std::memory_order::relaxed),
                                      out_peak_.load(std::memory_order::relaxed));
+        const auto& out_loudness_meter{controller_ref_.getOutLoudnessMeter()};
+        meter_bottom_panel_.updateValue(out_loudness_meter.getShortTermLUFS(),
+                                        out_loudness_meter.getIntegratedLUFS(),
+                                        out_loudness_meter.getLoudnessRangeLU());
     }
 
     void MeterDisplayPanel::run(const double next_time_stamp,
@@ -240,6 +250,7 @@ namespace zlpanel {
     void MeterDisplayPanel::mouseDoubleClick(const juce::MouseEvent&) {
         reduction_peak_.store(0.f, std::memory_order::relaxed);
         out_peak_.store(-240.f, std::memory_order::relaxed);
+        controller_ref_.resetOutLoudnessMeter();
     }
 
     std::string MeterDisplayPanel::formatValue(const float value) {
@@ -16,6 +16,7 @@
 #include "../../../../dsp/analyzer/mag_analyzer/mag_receiver.hpp"
 #include "../../../../dsp/analyzer/mag_analyzer/mag_reduction_receiver.hpp"
 #include "meter_top_panel.hpp"
+#include "meter_bottom_panel.hpp"
 
 namespace zlpanel {
     class MeterDisplayPanel final : public juce::Component {
@@ -38,7 +39,9 @@ namespace zlpanel {
         static constexpr float kReductionDecayPerSecond = 16.f;
         static constexpr float kMeterDecayPerSecond = 8.f;
         zlgui::UIBase& base_;
+        zlp::CompressController& controller_ref_;
         MeterTopPanel meter_top_panel_;
+        MeterBottomPanel meter_bottom_panel_;
 
         std::atomic<float>& comp_direction_ref_;
         std::atomic<float>& analyzer_mag_type_ref_;
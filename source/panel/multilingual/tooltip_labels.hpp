@@ -60,6 +60,9 @@ namespace zlpanel::multilingual {
         kMagMeasureStereo,
         kMagAnalyzerTimeLength,
         kMagAnalyzerMinDB,
+        kMultiBand,
+        kCrossover,
+        kBandTrim,
         kLabelNum
     };
 }
@@ -63,6 +63,9 @@ namespace zlpanel::multilingual::de {
         "Wählt die Methode der Magnitudenmessung.",
         "Wählt den Stereokanal für die Magnitudenmessung.",
         "Wählt die Zeitdauer des Magnitudenanalysators.",
-        "Wählt den minimalen Dezibelwert des Magnitudenanalysators."
+        "Wählt den minimalen Dezibelwert des Magnitudenanalysators.",
+        "Wählt die Anzahl der Bänder der Multiband-Kompression.",
+        "Steuert die Übergangsfrequenz zwischen zwei benachbarten Bändern.",
+        "Steuert den Pegelversatz des Banddetektors, ein höherer Versatz führt zu mehr Verstärkungsänderung in diesem Band."
     };
 }
@@ -63,6 +63,9 @@ namespace zlpanel::multilingual::en {
         "Choose the magnitude measurement method.",
         "Choose the magnitude measurement stereo channel.",
         "Choose the magnitude analyzer time length.",
-        "Choose the magnitude analyzer minimum decibel value."
+        "Choose the magnitude analyzer minimum decibel value.",
+        "Choose the number of bands of the multiband compression.",
+        "Control the crossover frequency between two neighbouring bands.",
+        "Control the level offset of the band detector, a higher offset results in more gain change on this band."
     };
 }
@@ -63,6 +63,9 @@ namespace zlpanel::multilingual::es {
         "Elige el método de medición de magnitud.",
         "Elige el canal estéreo de medición de magnitud.",
         "Elige la duración del analizador de magnitud.",
-        "Elige el valor mínimo en decibelios del analizador de magnitud."
+        "Elige el valor mínimo en decibelios del analizador de magnitud.",
+        "Elige el número de bandas de la compresión multibanda.",
+        "Controla la frecuencia de cruce entre dos bandas vecinas.",
+        "Controla el desplazamiento de nivel del detector de la banda; un desplazamiento mayor produce más cambio de ganancia en esta banda."
     };
 }
@@ -63,6 +63,9 @@ namespace zlpanel::multilingual::it {
         "Scegli il metodo di misurazione dell'ampiezza.",
         "Scegli il canale stereo per la misurazione dell'ampiezza.",
         "Scegli la durata temporale dell'analizzatore di ampiezza.",
-        "Scegli il valore minimo in decibel dell'analizzatore di ampiezza."
+        "Scegli il valore minimo in decibel dell'analizzatore di ampiezza.",
+        "Scegli il numero di bande della compressione multibanda.",
+        "Controlla la frequenza di crossover tra due bande adiacenti.",
+        "Controlla l'offset di livello del rilevatore della banda; un offset maggiore produce più variazione di guadagno su questa banda."
     };
 }
@@ -63,6 +63,9 @@ namespace zlpanel::multilingual::ja {
         "振幅測定方法を選択します。",
         "振幅測定を行うステレオチャンネルを選択します。",
         "振幅アナライザーの時間長を選択します。",
-        "振幅アナライザーの最小デシベル値を選択します。"
+        "振幅アナライザーの最小デシベル値を選択します。",
+        "マルチバンド圧縮のバンド数を選択します。",
+        "隣接する2つのバンド間のクロスオーバー周波数を調整します。",
+        "バンドの検出器のレベルオフセットを調整します。オフセットが大きいほど、このバンドのゲイン変化が大きくなります。"
     };
 }
@@ -63,6 +63,9 @@ namespace zlpanel::multilingual::zh_Hans {
         "选择幅度测量方法。",
         "选择幅度测量的立体声通道。",
         "选择幅度分析仪的时间长度。",
-        "选择幅度分析仪的最小分贝值。"
+        "选择幅度分析仪的最小分贝值。",
+        "选择多段压缩的频段数量。",
+        "调整相邻两个频段之间的分频频率。",
+        "调整频段检测器的电平偏移，偏移越大，该频段的增益变化越大。"
     };
 }
@@ -63,6 +63,9 @@ namespace zlpanel::multilingual::zh_Hant {
         "選擇振幅測量方法。",
         "選擇振幅測量的立體聲通道。",
         "選擇振幅分析儀的時間長度。",
-        "選擇振幅分析儀的最小分貝值。"
+        "選擇振幅分析儀的最小分貝值。",
+        "選擇多段壓縮的頻段數量。",
+        "調整相鄰兩個頻段之間的分頻頻率。",
+        "調整頻段檢測器的電平偏移，偏移越大，該頻段的增益變化越大。"
     };
 }
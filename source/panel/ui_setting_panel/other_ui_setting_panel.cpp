@@ -16,9 +16,12 @@ namespace zlpanel {
           refresh_rate_box_(zlstate::PTargetRefreshSpeed::kChoices, base),
           fft_tilt_slider_("Tilt", base),
           fft_speed_slider_("Speed", base),
+          fft_resolution_box_(zlstate::PFFTResolution::kChoices, base),
           mag_curve_slider_("Mag", base),
           eq_curve_slider_("EQ", base),
           tooltip_box_(zlstate::PTooltipLang::kChoices, base),
+          bypass_box_(zlstate::PBypassMode::kChoices, base),
+          offline_box_(zlstate::POfflineOversample::kChoices, base),
           font_mode_box_(zlstate::PFontMode::kChoices, base),
           font_scale_slider_("Scale", base),
           static_font_size_slider_("Static", base) {
@@ -41,6 +44,7 @@ namespace zlpanel {
         fft_speed_slider_.getSlider().setNormalisableRange(juce::NormalisableRange<double>(0., 2., .01));
         fft_speed_slider_.getSlider().setDoubleClickReturnValue(true, 1.0);
         addAndMakeVisible(fft_speed_slider_);
+        addAndMakeVisible(fft_resolution_box_);
 
         curve_thick_label_.setText("Curve Thickness", juce::dontSendNotification);
         curve_thick_label_.setJustificationType(juce::Justification::centredRight);
@@ -59,6 +63,18 @@ namespace zlpanel {
         addAndMakeVisible(tooltip_label_);
         addAndMakeVisible(tooltip_box_);
 
+        bypass_label_.setText("Bypass", juce::dontSendNotification);
+        bypass_label_.setJustificationType(juce::Justification::centredRight);
+        bypass_label_.setLookAndFeel(&name_laf_);
+        addAndMakeVisible(bypass_label_);
+        addAndMakeVisible(bypass_box_);
+
+        offline_label_.setText("Offline OS", juce::dontSendNotification);
+        offline_label_.setJustificationType(juce::Justification::centredRight);
+        offline_label_.setLookAndFeel(&name_laf_);
+        addAndMakeVisible(offline_label_);
+        addAndMakeVisible(offline_box_);
+
         font_label_.setText("UI Scaling", juce::dontSendNotification);
         font_label_.setJustificationType(juce::Justification::centredRight);
         font_label_.setLookAndFeel(&name_laf_);
@@ -76,9 +92,12 @@ namespace zlpanel {
         refresh_rate_box_.getBox().setSelectedItemIndex(static_cast<int>(base_.getRefreshRateID()));
         fft_tilt_slider_.getSlider().setValue(static_cast<double>(base_.getFFTExtraTilt()));
         fft_speed_slider_.getSlider().setValue(static_cast<double>(base_.getFFTExtraSpeed()));
+        fft_resolution_box_.getBox().setSelectedItemIndex(static_cast<int>(base_.getFFTResolutionID()));
         mag_curve_slider_.getSlider().setValue(base_.getMagCurveThickness());
         tooltip_box_.getBox().setSelectedItemIndex(static_cast<int>(base_.getTooltipLangID()));
         eq_curve_slider_.getSlider().setValue(base_.getEQCurveThickness());
+        bypass_box_.getBox().setSelectedItemIndex(static_cast<int>(base_.getBypassModeID()));
+        offline_box_.getBox().setSelectedItemIndex(static_cast<int>(base_.getOfflineOversampleID()));
         font_mode_box_.getBox().setSelectedItemIndex(static_cast<int>(base_.getFontMode()), juce::sendNotificationSync);
         font_scale_slider_.getSlider().setValue(static_cast<double>(base_.getFontScale()));
         static_font_size_slider_.getSlider().setValue(static_cast<double>(base_.getFontSize()));
@@ -89,9 +108,12 @@ namespace zlpanel {
         base_.setRefreshRateID(static_cast<size_t>(refresh_rate_box_.getBox().getSelectedItemIndex()));
         base_.setFFTExtraTilt(static_cast<float>(fft_tilt_slider_.getSlider().getValue()));
         base_.setFFTExtraSpeed(static_cast<float>(fft_speed_slider_.getSlider().getValue()));
+        base_.setFFTResolutionID(static_cast<size_t>(fft_resolution_box_.getBox().getSelectedItemIndex()));
         base_.setMagCurveThickness(static_cast<float>(mag_curve_slider_.getSlider().getValue()));
         base_.setEQCurveThickness(static_cast<float>(eq_curve_slider_.getSlider().getValue()));
         base_.setTooltipLandID(static_cast<size_t>(tooltip_box_.getBox().getSelectedItemIndex()));
+        base_.setBypassModeID(static_cast<size_t>(bypass_box_.getBox().getSelectedItemIndex()));
+        base_.setOfflineOversampleID(static_cast<size_t>(offline_box_.getBox().getSelectedItemIndex()));
         base_.setFontMode(static_cast<size_t>(font_mode_box_.getBox().getSelectedItemIndex()));
         base_.setFontScale(static_cast<float>(font_scale_slider_.getSlider().getValue()));
         base_.setStaticFontSize(static_cast<float>(static_font_size_slider_.getSlider().getValue()));
@@ -105,7 +127,7 @@ namespace zlpanel {
         const auto padding = juce::roundToInt(base_.getFontSize() * kPaddingScale * 3.f);
         const auto slider_height = juce::roundToInt(base_.getFontSize() * kSliderHeightScale);
 
-        return padding * 6 + slider_height * 5;
+        return padding * 8 + slider_height * 7;
     }
 
     void OtherUISettingPanel::resized() {
@@ -129,6 +151,8 @@ namespace zlpanel {
             fft_tilt_slider_.setBounds(local_bound.removeFromLeft(slider_width));
             local_bound.removeFromLeft(padding);
             fft_speed_slider_.setBounds(local_bound.removeFromLeft(slider_width));
+            local_bound.removeFromLeft(padding);
+            fft_resolution_box_.setBounds(local_bound.removeFromLeft(slider_width).reduced(0, padding / 3));
         }
         {
             bound.removeFromTop(padding);
@@ -146,6 +170,20 @@ namespace zlpanel {
             local_bound.removeFromLeft(padding);
             tooltip_box_.setBounds(local_bound.removeFromLeft(slider_width).reduced(0, padding / 3));
         }
+        {
+            bound.removeFromTop(padding);
+            auto local_bound = bound.removeFromTop(slider_height);
+            bypass_label_.setBounds(local_bound.removeFromLeft(slider_width * 2));
+            local_bound.removeFromLeft(padding);
+            bypass_box_.setBounds(local_bound.removeFromLeft(slider_width).reduced(0, padding / 3));
+        }
+        {
+            bound.removeFromTop(padding);
+            auto local_bound = bound.removeFromTop(slider_height);
+            offline_label_.setBounds(local_bound.removeFromLeft(slider_width * 2));
+            local_bound.removeFromLeft(padding);
+            offline_box_.setBounds(local_bound.removeFromLeft(slider_width).reduced(0, padding / 3));
+        }
         {
             bound.removeFromTop(padding);
             auto local_bound = bound.removeFromTop(slider_height);
@@ -40,10 +40,15 @@ namespace zlpanel {
         zlgui::combobox::CompactCombobox refresh_rate_box_;
         juce::Label fft_label_;
         zlgui::slider::CompactLinearSlider<true, true, true> fft_tilt_slider_, fft_speed_slider_;
+        zlgui::combobox::CompactCombobox fft_resolution_box_;
         juce::Label curve_thick_label_;
         zlgui::slider::CompactLinearSlider<true, true, true> mag_curve_slider_, eq_curve_slider_;
         juce::Label tooltip_label_;
         zlgui::combobox::CompactCombobox tooltip_box_;
+        juce::Label bypass_label_;
+        zlgui::combobox::CompactCombobox bypass_box_;
+        juce::Label offline_label_;
+        zlgui::combobox::CompactCombobox offline_box_;
 
         juce::Label font_label_;
         zlgui::combobox::CompactCombobox font_mode_box_;
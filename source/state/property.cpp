@@ -17,19 +17,36 @@ namespace zlstate {
         loadAPVTS(apvts);
     }
 
+    Property::SharedCache& Property::getSharedCache() {
+        static SharedCache cache;
+        return cache;
+    }
+
     void Property::loadAPVTS(juce::AudioProcessorValueTreeState& apvts) {
-        std::lock_guard<std::mutex> lock_guard{mutex_};
-        if (checkCreateDirectory()) {
-            if (const auto xml = juce::XmlDocument::parse(kUIPath); xml) {
-                apvts.replaceState(juce::ValueTree::fromXml(*xml));
+        auto& cache{getSharedCache()};
+        std::lock_guard<std::mutex> lock_guard{cache.mutex};
+        // only the first instance touches the disk
+        if (!cache.is_loaded) {
+            cache.is_loaded = true;
+            if (checkCreateDirectory()) {
+                if (const auto xml = juce::XmlDocument::parse(kUIPath); xml) {
+                    cache.state = juce::ValueTree::fromXml(*xml);
+                }
             }
         }
+        if (cache.state.isValid()) {
+            apvts.replaceState(cache.state.createCopy());
+        }
     }
 
     void Property::saveAPVTS(juce::AudioProcessorValueTreeState& apvts) {
-        std::lock_guard<std::mutex> lock{mutex_};
+        auto& cache{getSharedCache()};
+        const auto state = apvts.copyState();
+        std::lock_guard<std::mutex> lock{cache.mutex};
+        cache.is_loaded = true;
+        cache.state = state.createCopy();
         if (checkCreateDirectory()) {
-            if (const auto xml = apvts.copyState().createXml(); xml) {
+            if (const auto xml = state.createXml(); xml) {
                 if (!xml->writeTo(kUIPath)) {
                     return;
                 }
@@ -12,6 +12,10 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 
 namespace zlstate {
+    /**
+     * the UI settings stored on disk
+     * the settings file is read once per process and the parsed state is shared by all instances
+     */
     class Property {
     public:
         Property();
@@ -37,7 +41,13 @@ namespace zlstate {
             .getChildFile(JucePlugin_Name);
         const juce::File kUIPath = kPath.getChildFile("ui.xml");
 
-        std::mutex mutex_;
+        struct SharedCache {
+            std::mutex mutex;
+            bool is_loaded{false};
+            juce::ValueTree state;
+        };
+
+        static SharedCache& getSharedCache();
 
         bool checkCreateDirectory() const;
     };
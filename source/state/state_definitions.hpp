@@ -371,6 +371,16 @@ namespace zlstate {
         auto static constexpr kDefaultV = 1.f;
     };
 
+    class PFFTResolution : public ChoiceParameters<PFFTResolution> {
+    public:
+        auto static constexpr kID = "fft_resolution";
+        auto static constexpr kName = "";
+        inline auto static const kChoices = juce::StringArray{
+            "Single", "Multi"
+        };
+        int static constexpr kDefaultI = 0;
+    };
+
     class PMagCurveThickness : public FloatParameters<PMagCurveThickness> {
     public:
         auto static constexpr kID = "mag_curve_thickness";
@@ -405,6 +415,43 @@ namespace zlstate {
         int static constexpr kDefaultI = 1;
     };
 
+    class PBypassMode : public ChoiceParameters<PBypassMode> {
+    public:
+        auto static constexpr kID = "bypass_mode";
+        auto static constexpr kName = "";
+        inline auto static const kChoices = juce::StringArray{
+            "Light", "Warm"
+        };
+        int static constexpr kDefaultI = 0;
+    };
+
+    class POfflineOversample : public ChoiceParameters<POfflineOversample> {
+    public:
+        auto static constexpr kID = "offline_oversample";
+        auto static constexpr kName = "";
+
+        inline auto static const kChoices = juce::StringArray{
+#if ZL_MAX_OVERSAMPLE_RATE == 0
+            "Off"
+#elif ZL_MAX_OVERSAMPLE_RATE == 1
+            "Off", "2x"
+#elif ZL_MAX_OVERSAMPLE_RATE == 2
+            "Off", "2x", "4x"
+#elif ZL_MAX_OVERSAMPLE_RATE == 3
+            "Off", "2x", "4x", "8x"
+#elif ZL_MAX_OVERSAMPLE_RATE == 4
+            "Off", "2x", "4x", "8x", "16x"
+#elif ZL_MAX_OVERSAMPLE_RATE == 5
+            "Off", "2x", "4x", "8x", "16x", "32x"
+#elif ZL_MAX_OVERSAMPLE_RATE == 6
+            "Off", "2x", "4x", "8x", "16x", "32x", "64x"
+#else
+#error "Invalid ZL_MAX_OVERSAMPLE_RATE"
+#endif
+        };
+        int static constexpr kDefaultI = ZL_MAX_OVERSAMPLE_RATE < 2 ? ZL_MAX_OVERSAMPLE_RATE : 2;
+    };
+
     class PColourMapIdx : public ChoiceParameters<PColourMapIdx> {
     public:
         auto static constexpr kID = "colour_map_idx";
@@ -498,9 +545,9 @@ namespace zlstate {
                    PRotaryStyle::get(), PRotaryDragSensitivity::get(),
                    PSliderDoubleClickFunc::get(),
                    PTargetRefreshSpeed::get(),
-                   PFFTExtraTilt::get(), PFFTExtraSpeed::get(),
+                   PFFTExtraTilt::get(), PFFTExtraSpeed::get(), PFFTResolution::get(),
                    PMagCurveThickness::get(), PEQCurveThickness::get(),
-                   PTooltipLang::get());
+                   PTooltipLang::get(), PBypassMode::get(), POfflineOversample::get());
 
         for (size_t i = 0; i < kColourNames.size(); ++i) {
             const auto name = std::string(kColourNames[i]);
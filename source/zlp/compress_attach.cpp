@@ -16,91 +16,167 @@ namespace zlp {
         processor_ref_(processor),
         parameters_ref_(parameters),
         controller_ref_(controller),
-        compression_computer_ref_(controller.getCompressionComputer()),
-        expansion_computer_ref_(controller.getExpansionComputer()),
-        inflation_computer_ref_(controller.getInflationComputer()),
         follower_ref_(controller.getFollower()[0]) {
         juce::ignoreUnused(processor_ref_);
-        for (size_t i = 0; i < kIDs.size(); ++i) {
-            parameters_ref_.addParameterListener(kIDs[i], this);
-            parameterChanged(kIDs[i], parameters.getRawParameterValue(kIDs[i])->load(std::memory_order::relaxed));
+        for (size_t i = 0; i < kListenerNum; ++i) {
+            const auto ID = getID(i);
+            listeners_[i] = std::make_unique<juce_helper::ParaIdxListener<CompressAttach>>(*this, i);
+            parameters_ref_.addParameterListener(ID, listeners_[i].get());
+            parameterChanged(i, parameters.getRawParameterValue(ID)->load(std::memory_order::relaxed));
         }
     }
 
     CompressAttach::~CompressAttach() {
-        for (auto& ID : kIDs) {
-            parameters_ref_.removeParameterListener(ID, this);
+        for (size_t i = 0; i < kListenerNum; ++i) {
+            parameters_ref_.removeParameterListener(getID(i), listeners_[i].get());
         }
     }
 
-    void CompressAttach::parameterChanged(const juce::String& parameter_ID, float value) {
-        if (parameter_ID == PCompStyle::kID) {
+    std::string CompressAttach::getID(const size_t idx) {
+        if (idx < kIDs.size()) {
+            return kIDs[idx];
+        } else if (idx < kIDs.size() + kCrossoverNum) {
+            return PCrossover::kID + std::to_string(idx - kIDs.size());
+        } else {
+            return PBandTrim::kID + std::to_string(idx - kIDs.size() - kCrossoverNum);
+        }
+    }
+
+    void CompressAttach::parameterChanged(const size_t idx, const float value) {
+        if (idx >= kIDs.size() + kCrossoverNum) {
+            controller_ref_.setBandTrim(idx - kIDs.size() - kCrossoverNum, value);
+            return;
+        } else if (idx >= kIDs.size()) {
+            controller_ref_.setCrossover(idx - kIDs.size(), value);
+            return;
+        }
+        switch (idx) {
+        case getIdx(PCompStyle::kID): {
             controller_ref_.setCompStyle(static_cast<zldsp::compressor::Style>(value));
-        } else if (parameter_ID == PCompDirection::kID) {
+            break;
+        }
+        case getIdx(PCompDirection::kID): {
             controller_ref_.setCompDirection(static_cast<PCompDirection::Direction>(std::round(value)));
-        } else if (parameter_ID == PThreshold::kID) {
-            compression_computer_ref_.setThreshold(value);
-            expansion_computer_ref_.setThreshold(value);
-            inflation_computer_ref_.setThreshold(value);
-        } else if (parameter_ID == PRatio::kID) {
-            compression_computer_ref_.setRatio(value);
-            expansion_computer_ref_.setRatio(value);
-            inflation_computer_ref_.setRatio(value);
-        } else if (parameter_ID == PKneeW::kID) {
-            compression_computer_ref_.setKneeW(value);
-            expansion_computer_ref_.setKneeW(value);
-            inflation_computer_ref_.setKneeW(value);
-        } else if (parameter_ID == PCurve::kID) {
-            compression_computer_ref_.setCurve(PCurve::formatV(value));
-        } else if (parameter_ID == PFloor::kID) {
-            expansion_computer_ref_.setFloor(value);
-            inflation_computer_ref_.setFloor(value);
-        } else if (parameter_ID == PAttack::kID) {
+            break;
+        }
+        case getIdx(PThreshold::kID): {
+            controller_ref_.setThreshold(value);
+            break;
+        }
+        case getIdx(PRatio::kID): {
+            controller_ref_.setRatio(value);
+            break;
+        }
+        case getIdx(PKneeW::kID): {
+            controller_ref_.setKneeW(value);
+            break;
+        }
+        case getIdx(PCurve::kID): {
+            controller_ref_.setCurve(PCurve::formatV(value));
+            break;
+        }
+        case getIdx(PFloor::kID): {
+            controller_ref_.setFloor(value);
+            break;
+        }
+        case getIdx(PAttack::kID): {
             controller_ref_.setAttack(value);
-        } else if (parameter_ID == PRelease::kID) {
+            break;
+        }
+        case getIdx(PRelease::kID): {
             controller_ref_.setRelease(value);
-        } else if (parameter_ID == PPump::kID) {
+            break;
+        }
+        case getIdx(PPump::kID): {
             follower_ref_.setPumpPunch(PPump::formatV(value));
-        } else if (parameter_ID == PSmooth::kID) {
+            break;
+        }
+        case getIdx(PSmooth::kID): {
             follower_ref_.setSmooth(PSmooth::formatV(value));
-        } else if (parameter_ID == PHold::kID) {
+            break;
+        }
+        case getIdx(PHold::kID): {
             controller_ref_.setHoldLength(value);
-        } else if (parameter_ID == PRange::kID) {
+            break;
+        }
+        case getIdx(PRange::kID): {
             controller_ref_.setRange(value);
-        } else if (parameter_ID == POutGain::kID) {
+            break;
+        }
+        case getIdx(POutGain::kID): {
             controller_ref_.setOutputGain(value);
-        } else if (parameter_ID == PWet::kID) {
+            break;
+        }
+        case getIdx(PWet::kID): {
             controller_ref_.setWet(value);
-        } else if (parameter_ID == PSideStereoMode::kID) {
+            break;
+        }
+        case getIdx(PSideStereoMode::kID): {
             controller_ref_.setStereoMode(static_cast<int>(std::round(value)));
-        } else if (parameter_ID == PSideStereoSwap::kID) {
+            break;
+        }
+        case getIdx(PSideStereoSwap::kID): {
             controller_ref_.setStereoSwap(value > .5f);
-        } else if (parameter_ID == PSideStereoLink::kID) {
+            break;
+        }
+        case getIdx(PSideStereoLink::kID): {
             controller_ref_.setStereoLink(value);
-        } else if (parameter_ID == PSideStereoWet1::kID) {
+            break;
+        }
+        case getIdx(PSideStereoWet1::kID): {
             controller_ref_.setWet1(value);
-        } else if (parameter_ID == PSideStereoWet2::kID) {
+            break;
+        }
+        case getIdx(PSideStereoWet2::kID): {
             controller_ref_.setWet2(value);
-        } else if (parameter_ID == PClipperDrive::kID) {
+            break;
+        }
+        case getIdx(PClipperDrive::kID): {
             controller_ref_.getClipper().setWet(value);
-        } else if (parameter_ID == POversample::kID) {
+            break;
+        }
+        case getIdx(POversample::kID): {
             controller_ref_.setOversampleIdx(static_cast<int>(value));
-        } else if (parameter_ID == PLookAhead::kID) {
+            break;
+        }
+        case getIdx(PLookAhead::kID): {
             controller_ref_.setLookahead(value);
-        } else if (parameter_ID == PCompON::kID) {
+            break;
+        }
+        case getIdx(PCompON::kID): {
             controller_ref_.setIsON(value > .5f);
-        } else if (parameter_ID == PCompDelta::kID) {
+            break;
+        }
+        case getIdx(PCompDelta::kID): {
             controller_ref_.setIsDelta(value > .5f);
-        } else if (parameter_ID == PRMSON::kID) {
+            break;
+        }
+        case getIdx(PRMSON::kID): {
             controller_ref_.setRMSOn(value > .5f);
-        } else if (parameter_ID == PRMSLength::kID) {
+            break;
+        }
+        case getIdx(PRMSLength::kID): {
             controller_ref_.setRMSLength(value);
-        } else if (parameter_ID == PRMSSpeed::kID) {
+            break;
+        }
+        case getIdx(PRMSSpeed::kID): {
             controller_ref_.setRMSSpeed(value);
-        } else if (parameter_ID == PRMSMix::kID) {
+            break;
+        }
+        case getIdx(PRMSMix::kID): {
             controller_ref_.setRMSMix(value);
-        } else if (parameter_ID == PRangeINF::kID) {
+            break;
+        }
+        case getIdx(PRangeINF::kID): {
             controller_ref_.setIsRangeINF(value > .5f);
+            break;
+        }
+        case getIdx(PMultiBand::kID): {
+            controller_ref_.setBandNum(static_cast<size_t>(std::round(value)) + 1);
+            break;
+        }
+        default:
+            break;
         }
     }
 }
@@ -9,26 +9,28 @@
 
 #pragma once
 
+#include <string_view>
+
 #include "zlp_definitions.hpp"
 #include "compress_controller.hpp"
+#include "juce_helper/para_idx_listener.hpp"
 
 namespace zlp {
-    class CompressAttach final : private juce::AudioProcessorValueTreeState::Listener {
+    class CompressAttach final {
     public:
         explicit CompressAttach(juce::AudioProcessor& processor,
                                 juce::AudioProcessorValueTreeState& parameters,
                                 CompressController& controller);
 
-        ~CompressAttach() override;
+        ~CompressAttach();
 
     private:
+        friend class juce_helper::ParaIdxListener<CompressAttach>;
+
         juce::AudioProcessor& processor_ref_;
         juce::AudioProcessorValueTreeState& parameters_ref_;
         CompressController& controller_ref_;
 
-        zldsp::compressor::CompressionComputer<float, true>& compression_computer_ref_;
-        zldsp::compressor::ExpansionComputer<float, true>& expansion_computer_ref_;
-        zldsp::compressor::InflationComputer<float, true>& inflation_computer_ref_;
         zldsp::compressor::PSFollower<float>& follower_ref_;
 
         constexpr static std::array kIDs{
@@ -43,9 +45,27 @@ namespace zlp {
             POversample::kID, PLookAhead::kID,
             PCompON::kID, PCompDelta::kID,
             PRMSON::kID, PRMSLength::kID, PRMSSpeed::kID, PRMSMix::kID,
-            PRangeINF::kID
+            PRangeINF::kID, PMultiBand::kID
         };
 
-        void parameterChanged(const juce::String& parameter_ID, float value) override;
+        static constexpr size_t kCrossoverNum = kCompBandNum - 1;
+        static constexpr size_t kListenerNum = kIDs.size() + kCrossoverNum + kCompBandNum;
+
+        // one listener per parameter, each of them carries the index of its parameter in kIDs
+        // the crossovers and the band thresholds come after the parameters of kIDs
+        std::array<std::unique_ptr<juce_helper::ParaIdxListener<CompressAttach>>, kListenerNum> listeners_;
+
+        static constexpr size_t getIdx(const std::string_view parameter_ID) {
+            for (size_t i = 0; i < kIDs.size(); ++i) {
+                if (parameter_ID == kIDs[i]) {
+                    return i;
+                }
+            }
+            return kIDs.size();
+        }
+
+        static std::string getID(size_t idx);
+
+        void parameterChanged(size_t idx, float value);
     };
 }
@@ -21,6 +21,7 @@ namespace zlp {
             mag_analyzer_sender_.setON(i, true);
         }
         lufs_matcher_.prepare(sample_rate, 2);
+        out_loudness_meter_.prepare(sample_rate, 2);
         output_gain_.prepare(sample_rate, max_num_samples, 0.1);
 
         pre_buffer_[0].resize(max_num_samples);
@@ -40,7 +41,30 @@ namespace zlp {
         }
         rms_side_buffer0_.resize(max_num_samples * (1 << ZL_MAX_OVERSAMPLE_RATE));
         rms_side_buffer1_.resize(rms_side_buffer0_.size());
-        // init oversamplers
+        band_fade_buffer0_.resize(rms_side_buffer0_.size());
+        band_fade_buffer1_.resize(rms_side_buffer0_.size());
+        // init oversamplers, the offline quality mode uses longer halfband filters
+        if (const auto is_offline = processor_ref_.isNonRealtime(); is_offline != c_is_offline_) {
+            c_is_offline_ = is_offline;
+#if ZL_MAX_OVERSAMPLE_RATE >= 1
+            over_sampler2_ = zldsp::oversample::OverSampler<float, 1>(c_is_offline_);
+#endif
+#if ZL_MAX_OVERSAMPLE_RATE >= 2
+            over_sampler4_ = zldsp::oversample::OverSampler<float, 2>(c_is_offline_);
+#endif
+#if ZL_MAX_OVERSAMPLE_RATE >= 3
+            over_sampler8_ = zldsp::oversample::OverSampler<float, 3>(c_is_offline_);
+#endif
+#if ZL_MAX_OVERSAMPLE_RATE >= 4
+            over_sampler16_ = zldsp::oversample::OverSampler<float, 4>(c_is_offline_);
+#endif
+#if ZL_MAX_OVERSAMPLE_RATE >= 5
+            over_sampler32_ = zldsp::oversample::OverSampler<float, 5>(c_is_offline_);
+#endif
+#if ZL_MAX_OVERSAMPLE_RATE >= 6
+            over_sampler64_ = zldsp::oversample::OverSampler<float, 6>(c_is_offline_);
+#endif
+        }
 #if ZL_MAX_OVERSAMPLE_RATE >= 1
         over_sampler2_.prepare(4, max_num_samples);
 #endif
@@ -86,34 +110,40 @@ namespace zlp {
         // init lookahead delay
         lookahead_delay_.prepare(sample_rate, max_num_samples, 2, 0.02f);
         lookahead_delay_.setDelayInSamples(0);
-        to_update_status_.signal();
-        to_update_stereo_.signal();
-        to_update_style_.signal();
-        to_update_follower_.signal();
-        to_update_rms_.signal();
-        to_update_hold_.signal();
-        to_update_range_.signal();
-        to_update_wet_.signal();
-        to_update_output_gain_.signal();
-        to_update_oversample_.signal();
-        to_update_lookahead_.signal();
+        side_delay_.prepare(sample_rate, max_num_samples, 2, kMaxSideLatencySeconds);
+        side_delay_.setDelayInSamples(0);
+        resume_fade_length_ = std::max(static_cast<size_t>(kResumeFadeSeconds * sample_rate), size_t(1));
+        resume_fade_remaining_ = 0;
+        // prepare the bypass splitter with the host samplerate, the crossovers are set with the multiband update
+        bypass_splitter_.prepare(sample_rate);
+        bypass_splitter_.setBandNum(c_band_num_);
+        was_light_bypassed_ = false;
+        c_computer_snap_ = true;
         // init hold buffers
         for (auto& h : hold_buffer_) {
             h.setCapacity(static_cast<size_t>(8.0 * sample_rate));
         }
-        to_update_.signal();
+        update_flags_.signal(kUpdateAll);
+        // apply all parameters now, so that the host gets the latency of this mode before the first block
+        prepareBuffer();
+        cancelPendingUpdate();
+        processor_ref_.setLatencySamples(pdc_.load(std::memory_order::relaxed));
     }
 
     void CompressController::prepareBuffer() {
-        if (!to_update_.check()) {
+        auto flags = update_flags_.take();
+        if (flags == 0) {
             return;
         }
         bool to_update_pdc = false;
 
-        if (to_update_status_.check()) {
+        if (flags & kUpdateStatus) {
             c_is_on_ = is_on_.load(std::memory_order::relaxed);
             c_is_delta_ = is_delta_.load(std::memory_order::relaxed);
             c_mag_analyzer_on_ = mag_analyzer_on_.load(std::memory_order::relaxed);
+            if (to_reset_out_loudness_.exchange(false, std::memory_order::relaxed)) {
+                out_loudness_meter_.reset();
+            }
 
             const auto new_lufs_matcher_on_ = lufs_matcher_on_.load(std::memory_order::relaxed);
             if (new_lufs_matcher_on_ != c_lufs_matcher_on_) {
@@ -122,13 +152,17 @@ namespace zlp {
                     lufs_matcher_.reset();
                 }
             }
-            c_copy_pre = c_mag_analyzer_on_ || c_is_delta_;
+            c_copy_pre = c_mag_analyzer_on_ || c_is_delta_ || c_lufs_matcher_on_;
             c_copy_post = c_mag_analyzer_on_ || c_is_delta_;
         }
 
         // load oversampling idx, set up trackers/followers and update latency
-        if (to_update_oversample_.check()) {
-            const auto new_oversample_idx = oversample_idx_.load(std::memory_order::relaxed);
+        if (flags & kUpdateOversample) {
+            auto new_oversample_idx = oversample_idx_.load(std::memory_order::relaxed);
+            if (c_is_offline_) {
+                new_oversample_idx = std::max(new_oversample_idx,
+                                              offline_oversample_idx_.load(std::memory_order::relaxed));
+            }
             to_update_pdc = true;
             c_oversample_idx_ = new_oversample_idx;
             switch (c_oversample_idx_) {
@@ -183,7 +217,7 @@ namespace zlp {
             const auto oversample_mul = 1 << c_oversample_idx_;
             // prepare tracker and followers with the multiplied samplerate
             oversample_sr_ = sample_rate_ * static_cast<double>(oversample_mul);
-            to_update_rms_.signal();
+            flags |= kUpdateRMS;
             for (auto& f : follower_) {
                 f.prepare(oversample_sr_);
             }
@@ -193,15 +227,20 @@ namespace zlp {
             for (auto& t : rms_tracker_) {
                 t.prepare(oversample_sr_);
             }
-            to_update_style_.signal();
+            // prepare the splitter with the multiplied samplerate, the crossovers are set again below
+            splitter_.prepare(oversample_sr_);
+            band_fade_length_ = std::max(static_cast<size_t>(kResumeFadeSeconds * oversample_sr_), size_t(1));
+            band_fade_remaining_ = 0;
+            flags |= kUpdateMultiband;
+            flags |= kUpdateStyle;
             // prepare the hold buffer with the multiplied samplerate
             for (auto& h : hold_buffer_) {
                 h.setCapacity(static_cast<size_t>(oversample_sr_));
             }
-            to_update_hold_.signal();
+            flags |= kUpdateHold;
         }
 
-        if (to_update_lookahead_.check()) {
+        if (flags & kUpdateLookahead) {
             const auto delay_length = lookahead_delay_length_.load(std::memory_order::relaxed);
             to_update_pdc = true;
             lookahead_delay_.setDelay(std::abs(delay_length));
@@ -212,9 +251,34 @@ namespace zlp {
             } else {
                 delay_status_ = DelayStatus::kSideDelay;
             }
+            const auto max_side_latency = static_cast<int>(kMaxSideLatencySeconds * sample_rate_);
+            const auto side_latency = std::min(side_latency_.load(std::memory_order::relaxed), max_side_latency);
+            if (side_latency != side_delay_.getDelayInSamples()) {
+                // the delay is not processed while it is zero, so its states are stale
+                const auto to_reset = side_delay_.getDelayInSamples() == 0;
+                side_delay_.setDelayInSamples(side_latency);
+                if (to_reset) {
+                    side_delay_.reset();
+                }
+            }
+        }
+
+        // load computer parameters, snap to them after preparing, otherwise ramp to them in this block
+        if (flags & kUpdateComputer) {
+            for (size_t i = 0; i < kComputerParaNum; ++i) {
+                c_computer_target_[i] = computer_paras_[i].load(std::memory_order::relaxed);
+            }
+            if (c_computer_snap_) {
+                c_computer_snap_ = false;
+                c_computer_ramp_ = false;
+                applyComputerParas(c_computer_target_);
+            } else {
+                c_computer_start_ = c_computer_paras_;
+                c_computer_ramp_ = true;
+            }
         }
 
-        if (to_update_follower_.check()) {
+        if (flags & kUpdateFollower) {
             const auto attack = attack_.load(std::memory_order::relaxed);
             const auto release = release_.load(std::memory_order::relaxed);
             const auto rms_speed = rms_speed_.load(std::memory_order::relaxed);
@@ -225,7 +289,7 @@ namespace zlp {
         }
 
         // load stereo mode
-        if (to_update_stereo_.check()) {
+        if (flags & kUpdateStereo) {
             const auto stereo_mode = stereo_mode_.load(std::memory_order::relaxed);
             c_stereo_mode_is_midside = (stereo_mode == 0) || (stereo_mode == 2);
             c_stereo_mode_is_max = (stereo_mode == 2) || (stereo_mode == 3);
@@ -234,8 +298,37 @@ namespace zlp {
             c_stereo_link_max_ = 1.f - 2.f * (1.f - c_stereo_link_);
         }
 
+        // load band number, crossovers and band thresholds, the band followers are reset with the style
+        if (flags & kUpdateMultiband) {
+            const auto band_num = std::clamp(band_num_.load(std::memory_order::relaxed),
+                                             static_cast<size_t>(1), kMaxBandNum);
+            if (band_num != c_band_num_) {
+                fade_splitter_ = splitter_;
+                band_fade_gains_ = band_last_gains_;
+                band_fade_remaining_ = band_fade_length_;
+                c_band_num_ = band_num;
+                splitter_.setBandNum(c_band_num_);
+                bypass_splitter_.setBandNum(c_band_num_);
+                flags |= kUpdateStyle;
+            }
+            std::array<float, kMaxBandNum - 1> crossovers{};
+            for (size_t i = 0; i + 1 < c_band_num_; ++i) {
+                crossovers[i] = crossovers_[i].load(std::memory_order::relaxed);
+            }
+            std::sort(crossovers.begin(), crossovers.begin() + static_cast<std::ptrdiff_t>(c_band_num_ - 1));
+            const auto max_crossover = kMaxCrossoverRatio * sample_rate_;
+            for (size_t i = 0; i + 1 < c_band_num_; ++i) {
+                const auto crossover = std::min(static_cast<double>(crossovers[i]), max_crossover);
+                splitter_.setCrossover(i, crossover);
+                bypass_splitter_.setCrossover(i, crossover);
+            }
+            for (size_t i = 0; i < kMaxBandNum; ++i) {
+                c_band_trims_[i] = zldsp::chore::decibelsToGain(band_trims_[i].load(std::memory_order::relaxed));
+            }
+        }
+
         // load compressor style, reset the internal state if different
-        if (to_update_style_.check()) {
+        if (flags & kUpdateStyle) {
             const auto previous_direction = c_direction_;
             c_comp_style_ = comp_style_.load(std::memory_order::relaxed);
             c_direction_ = direction_.load(std::memory_order::relaxed);
@@ -279,14 +372,22 @@ namespace zlp {
             }
             zldsp::compressor::CleanCompressor<float>::reset(rms_follower_[0]);
             zldsp::compressor::CleanCompressor<float>::reset(rms_follower_[1]);
+            // all styles start from zero, as their reset do
+            for (size_t chan = 0; chan < 2; ++chan) {
+                for (auto& f : band_followers_[chan]) {
+                    f.reset(0.f);
+                }
+                band_x0_[chan].fill(0.f);
+            }
             if (direction_changed) {
                 hold_buffer_[0].clear();
                 hold_buffer_[1].clear();
             }
+            updateDetectorKernel();
         }
 
         // load hold values
-        if (to_update_hold_.check()) {
+        if (flags & kUpdateHold) {
             const auto oversample_mul = 1 << c_oversample_idx_;
             const auto hold_size = static_cast<size_t>(
                 sample_rate_ * hold_length_.load(std::memory_order::relaxed)
@@ -295,23 +396,23 @@ namespace zlp {
             hold_buffer_[1].setSize(hold_size);
         }
         // load wet values
-        if (to_update_wet_.check()) {
+        if (flags & kUpdateWet) {
             const auto c_wet = wet_.load(std::memory_order::relaxed);
             c_wet1_ = wet1_.load(std::memory_order::relaxed) * c_wet * 0.05f;
             // 0.05 accounts for the db to gain transformation
             c_wet2_ = wet2_.load(std::memory_order::relaxed) * c_wet * 0.05f;
-            to_update_range_.signal();
-            to_update_output_gain_.signal();
+            flags |= kUpdateRange;
+            flags |= kUpdateOutputGain;
         }
-        if (to_update_range_.check()) {
+        if (flags & kUpdateRange) {
             c_range_ = range_.load(std::memory_order::relaxed) * wet_.load(std::memory_order::relaxed);
             c_is_range_inf_ = is_range_inf_.load(std::memory_order::relaxed);
         }
-        if (to_update_output_gain_.check()) {
+        if (flags & kUpdateOutputGain) {
             output_gain_.setGainDecibels(
                 output_gain_db_.load(std::memory_order::relaxed) * wet_.load(std::memory_order::relaxed));
         }
-        if (to_update_rms_.check()) {
+        if (flags & kUpdateRMS) {
             const auto rms_length = rms_length_.load(std::memory_order::relaxed);
             rms_tracker_[0].setMomentarySeconds(rms_length);
             rms_tracker_[1].setMomentarySeconds(rms_length);
@@ -338,6 +439,7 @@ namespace zlp {
                 break;
             }
             }
+            new_pdc += side_delay_.getDelayInSamples();
             if (pdc_.exchange(new_pdc) != new_pdc) {
                 triggerAsyncUpdate();
             }
@@ -347,7 +449,15 @@ namespace zlp {
     void CompressController::process(std::array<float*, 2> main_pointers,
                                      std::array<float*, 2> side_pointers,
                                      const size_t num_samples, bool bypass) {
+        profiler_.startBlock();
+        if (was_light_bypassed_) {
+            // the side-chain states are stale, reset them and fade from the dry signal
+            was_light_bypassed_ = false;
+            resume_fade_remaining_ = resume_fade_length_;
+            update_flags_.signal(kUpdateOversample | kUpdateStyle);
+        }
         prepareBuffer();
+        profiler_.lap(kStagePrepare);
         switch (delay_status_) {
         case DelayStatus::kZero: {
             break;
@@ -361,19 +471,22 @@ namespace zlp {
             break;
         }
         }
-        // process the pre lufs matcher
-        if (c_lufs_matcher_on_) {
-            lufs_matcher_.processPre(main_pointers, num_samples);
+        if (side_delay_.getDelayInSamples() > 0) {
+            side_delay_.process(main_pointers, num_samples);
         }
-        // copy pre buffer
-        if (c_copy_pre) {
+        profiler_.lap(kStageLookahead);
+        // copy pre buffer, with oversampling it also feeds the oversample delay
+        // which has to hold the current input when the light bypass takes over
+        if (c_copy_pre || resume_fade_remaining_ > 0 || c_oversample_idx_ > 0) {
             zldsp::vector::copy<float>(pre_pointers_, main_pointers, num_samples);
         }
+        profiler_.lap(kStagePreCopy);
         // stereo split the main/side buffer
         if (c_stereo_mode_is_midside) {
             zldsp::splitter::InplaceMSSplitter<float>::split(main_pointers[0], main_pointers[1], num_samples);
             zldsp::splitter::InplaceMSSplitter<float>::split(side_pointers[0], side_pointers[1], num_samples);
         }
+        profiler_.lap(kStageMSSplit);
         // upsample side buffer
         std::array<float*, 4> pointers{main_pointers[0], main_pointers[1], side_pointers[0], side_pointers[1]};
         switch (c_oversample_idx_) {
@@ -385,407 +498,823 @@ namespace zlp {
 #if ZL_MAX_OVERSAMPLE_RATE >= 1
         case 1: {
             over_sampler2_.upsample(pointers, num_samples);
+            profiler_.lap(kStageUpsample);
             auto& os_pointers = over_sampler2_.getOSPointer();
             processBuffer(os_pointers[0], os_pointers[1], os_pointers[2], os_pointers[3], num_samples << 1, bypass);
             over_sampler2_.downsample(pointers, num_samples);
             oversample_delay_.process(pre_pointers_, num_samples);
+            profiler_.lap(kStageDownsample);
             break;
         }
 #endif
 #if ZL_MAX_OVERSAMPLE_RATE >= 2
         case 2: {
             over_sampler4_.upsample(pointers, num_samples);
+            profiler_.lap(kStageUpsample);
             auto& os_pointers = over_sampler4_.getOSPointer();
             processBuffer(os_pointers[0], os_pointers[1], os_pointers[2], os_pointers[3], num_samples << 2, bypass);
             over_sampler4_.downsample(pointers, num_samples);
             oversample_delay_.process(pre_pointers_, num_samples);
+            profiler_.lap(kStageDownsample);
             break;
         }
 #endif
 #if ZL_MAX_OVERSAMPLE_RATE >= 3
         case 3: {
             over_sampler8_.upsample(pointers, num_samples);
+            profiler_.lap(kStageUpsample);
             auto& os_pointers = over_sampler8_.getOSPointer();
             processBuffer(os_pointers[0], os_pointers[1], os_pointers[2], os_pointers[3], num_samples << 3, bypass);
             over_sampler8_.downsample(pointers, num_samples);
             oversample_delay_.process(pre_pointers_, num_samples);
+            profiler_.lap(kStageDownsample);
             break;
         }
 #endif
 #if ZL_MAX_OVERSAMPLE_RATE >= 4
         case 4: {
             over_sampler16_.upsample(pointers, num_samples);
+            profiler_.lap(kStageUpsample);
             auto& os_pointers = over_sampler16_.getOSPointer();
             processBuffer(os_pointers[0], os_pointers[1], os_pointers[2], os_pointers[3], num_samples << 4, bypass);
             over_sampler16_.downsample(pointers, num_samples);
             oversample_delay_.process(pre_pointers_, num_samples);
+            profiler_.lap(kStageDownsample);
             break;
         }
 #endif
 #if ZL_MAX_OVERSAMPLE_RATE >= 5
         case 5: {
             over_sampler32_.upsample(pointers, num_samples);
+            profiler_.lap(kStageUpsample);
             auto& os_pointers = over_sampler32_.getOSPointer();
             processBuffer(os_pointers[0], os_pointers[1], os_pointers[2], os_pointers[3], num_samples << 5, bypass);
             over_sampler32_.downsample(pointers, num_samples);
             oversample_delay_.process(pre_pointers_, num_samples);
+            profiler_.lap(kStageDownsample);
             break;
         }
 #endif
 #if ZL_MAX_OVERSAMPLE_RATE >= 6
         case 6: {
             over_sampler64_.upsample(pointers, num_samples);
+            profiler_.lap(kStageUpsample);
             auto& os_pointers = over_sampler64_.getOSPointer();
             processBuffer(os_pointers[0], os_pointers[1], os_pointers[2], os_pointers[3], num_samples << 6, bypass);
             over_sampler64_.downsample(pointers, num_samples);
             oversample_delay_.process(pre_pointers_, num_samples);
+            profiler_.lap(kStageDownsample);
             break;
         }
 #endif
         default: ;
         }
-        // stereo combine the main buffer
-        if (c_stereo_mode_is_midside) {
-            zldsp::splitter::InplaceMSSplitter<float>::combine(main_pointers[0], main_pointers[1], num_samples);
-        }
-        // copy post buffer
-        if (c_copy_post) {
-            zldsp::vector::copy<float>(post_pointers_, main_pointers, num_samples);
-        }
-        // makeup gain
-        if (c_is_on_ && !bypass) {
-            output_gain_.template process<false>(main_pointers, num_samples);
-        } else {
-            output_gain_.template process<true>(main_pointers, num_samples);
-        }
+        // stereo combine, copy post, makeup gain and delta in a single pass
+        // the analyzer needs the output before delta, so delta is only fused when the analyzer is off
+        const auto fuse_delta = c_is_delta_ && !c_mag_analyzer_on_;
+        const auto gain_mode = (fuse_delta || !c_is_on_ || bypass)
+                                   ? EpilogueGain::kNone
+                                   : (output_gain_.isSmoothing() ? EpilogueGain::kRamp : EpilogueGain::kConstant);
+        const auto dispatch_bool = [](const bool flag, auto&& func) {
+            if (flag) {
+                func(std::true_type{});
+            } else {
+                func(std::false_type{});
+            }
+        };
+        dispatch_bool(c_stereo_mode_is_midside, [&](auto is_midside) {
+            dispatch_bool(c_copy_post, [&](auto copy_post) {
+                dispatch_bool(fuse_delta, [&](auto delta) {
+                    constexpr bool kMidSide = decltype(is_midside)::value;
+                    constexpr bool kCopyPost = decltype(copy_post)::value;
+                    constexpr bool kDelta = decltype(delta)::value;
+                    switch (gain_mode) {
+                    case EpilogueGain::kNone: {
+                        processEpilogue<kMidSide, kCopyPost, kDelta, EpilogueGain::kNone>(
+                            main_pointers[0], main_pointers[1], num_samples);
+                        break;
+                    }
+                    case EpilogueGain::kConstant: {
+                        processEpilogue<kMidSide, kCopyPost, kDelta, EpilogueGain::kConstant>(
+                            main_pointers[0], main_pointers[1], num_samples);
+                        break;
+                    }
+                    case EpilogueGain::kRamp: {
+                        processEpilogue<kMidSide, kCopyPost, kDelta, EpilogueGain::kRamp>(
+                            main_pointers[0], main_pointers[1], num_samples);
+                        break;
+                    }
+                    }
+                });
+            });
+        });
+        output_gain_.skip(num_samples);
+        profiler_.lap(kStageGain);
         // mag analyzer
         if (c_mag_analyzer_on_) {
             mag_analyzer_sender_.process({pre_pointers_, post_pointers_, main_pointers}, num_samples);
         }
-        // delta
-        if (c_is_delta_) {
+        profiler_.lap(kStageAnalyzer);
+        // delta, if it has not been fused
+        if (c_is_delta_ && !fuse_delta) {
             for (size_t chan = 0; chan < 2; ++chan) {
                 zldsp::vector::sub(main_pointers[chan], pre_pointers_[chan], post_pointers_[chan], num_samples);
             }
         }
-        // process the post lufs matcher
+        // fade from the dry signal after a light bypass
+        if (resume_fade_remaining_ > 0) {
+            processResumeFade(main_pointers, num_samples);
+        }
+        profiler_.lap(kStageGain);
+        // process the lufs matcher, the pre buffer has been aligned with the main buffer
         if (c_lufs_matcher_on_) {
-            lufs_matcher_.processPost(main_pointers, num_samples);
+            lufs_matcher_.process(pre_pointers_, main_pointers, num_samples);
+        }
+        profiler_.lap(kStageLUFS);
+        // process the output loudness meter
+        if (c_mag_analyzer_on_) {
+            out_loudness_meter_.process(main_pointers, num_samples);
+        }
+        profiler_.lap(kStageAnalyzer);
+        profiler_.finishBlock();
+    }
+
+    void CompressController::processBypass(std::array<float*, 2> main_pointers, const size_t num_samples) {
+        prepareBuffer();
+        if (!was_light_bypassed_) {
+            bypass_splitter_.reset();
+        }
+        was_light_bypassed_ = true;
+        if (delay_status_ == DelayStatus::kMainDelay) {
+            lookahead_delay_.process(main_pointers, num_samples);
+        }
+        if (side_delay_.getDelayInSamples() > 0) {
+            side_delay_.process(main_pointers, num_samples);
+        }
+        if (c_oversample_idx_ > 0) {
+            oversample_delay_.process(main_pointers, num_samples);
+        }
+        // sum up the bands, so that the light bypass keeps the phase of the splitter as the normal bypass
+        if (c_band_num_ > 1) {
+            static constexpr BandTag d;
+            for (size_t chan = 0; chan < 2; ++chan) {
+                float* __restrict main_buffer = main_pointers[chan];
+                for (size_t start_idx = 0; start_idx < num_samples; start_idx += kBandChunkSize) {
+                    const auto chunk = std::min(kBandChunkSize, num_samples - start_idx);
+                    bypass_splitter_.process(chan, main_buffer + start_idx, band_main_[0].data(), chunk);
+                    for (size_t i = 0; i < chunk; ++i) {
+                        main_buffer[start_idx + i] = hn::ReduceSum(
+                            d, hn::Load(d, band_main_[0].data() + i * kMaxBandNum));
+                    }
+                }
+            }
+        }
+    }
+
+    void CompressController::processResumeFade(std::array<float*, 2> main_pointers, const size_t num_samples) {
+        const auto num_fade = std::min(num_samples, resume_fade_remaining_);
+        const auto step = 1.f / static_cast<float>(resume_fade_length_);
+        const auto w = static_cast<float>(resume_fade_length_ - resume_fade_remaining_) * step;
+        for (size_t chan = 0; chan < 2; ++chan) {
+            float* __restrict main_buffer = main_pointers[chan];
+            const float* __restrict pre_buffer = pre_pointers_[chan];
+            auto chan_w = w;
+            if (c_band_num_ > 1) {
+                // fade from the sum of the bands, which the light bypass has output
+                static constexpr BandTag d;
+                for (size_t start_idx = 0; start_idx < num_fade; start_idx += kBandChunkSize) {
+                    const auto chunk = std::min(kBandChunkSize, num_fade - start_idx);
+                    bypass_splitter_.process(chan, pre_buffer + start_idx, band_main_[0].data(), chunk);
+                    for (size_t i = 0; i < chunk; ++i) {
+                        chan_w += step;
+                        const auto dry = hn::ReduceSum(d, hn::Load(d, band_main_[0].data() + i * kMaxBandNum));
+                        main_buffer[start_idx + i] = dry + (main_buffer[start_idx + i] - dry) * chan_w;
+                    }
+                }
+            } else {
+                for (size_t i = 0; i < num_fade; ++i) {
+                    chan_w += step;
+                    main_buffer[i] = pre_buffer[i] + (main_buffer[i] - pre_buffer[i]) * chan_w;
+                }
+            }
+        }
+        resume_fade_remaining_ -= num_fade;
+    }
+
+    template <bool is_midside, bool copy_post, bool delta, CompressController::EpilogueGain gain_mode>
+    void CompressController::processEpilogue(float* __restrict main_buffer0, float* __restrict main_buffer1,
+                                             const size_t num_samples) {
+        static constexpr hn::ScalableTag<float> d;
+        static constexpr size_t lanes = hn::MaxLanes(d);
+        float* __restrict post_buffer0 = post_pointers_[0];
+        float* __restrict post_buffer1 = post_pointers_[1];
+        const float* __restrict pre_buffer0 = pre_pointers_[0];
+        const float* __restrict pre_buffer1 = pre_pointers_[1];
+        // the gain of the k-th sample is start + step * (k + 1), bounded by the target
+        const auto start = output_gain_.getCurrentGainLinear();
+        const auto step = gain_mode == EpilogueGain::kRamp ? output_gain_.getRampStep() : 0.f;
+        const auto target = output_gain_.getTargetGainLinear();
+        const auto is_increasing = step > 0.f;
+
+        const auto v_start = hn::Set(d, start);
+        const auto v_step = hn::Set(d, step);
+        const auto v_target = hn::Set(d, target);
+        const auto v_lanes = hn::Set(d, static_cast<float>(lanes));
+        auto v_idx = hn::Iota(d, 1.f);
+
+        size_t i = 0;
+        for (; i + lanes <= num_samples; i += lanes) {
+            auto v_main0 = hn::LoadU(d, main_buffer0 + i);
+            auto v_main1 = hn::LoadU(d, main_buffer1 + i);
+            if constexpr (is_midside) {
+                const auto v_mid = v_main0;
+                v_main0 = hn::Add(v_mid, v_main1);
+                v_main1 = hn::Sub(v_mid, v_main1);
+            }
+            if constexpr (copy_post) {
+                hn::StoreU(v_main0, d, post_buffer0 + i);
+                hn::StoreU(v_main1, d, post_buffer1 + i);
+            }
+            if constexpr (delta) {
+                v_main0 = hn::Sub(hn::LoadU(d, pre_buffer0 + i), v_main0);
+                v_main1 = hn::Sub(hn::LoadU(d, pre_buffer1 + i), v_main1);
+            } else if constexpr (gain_mode == EpilogueGain::kConstant) {
+                v_main0 = hn::Mul(v_main0, v_start);
+                v_main1 = hn::Mul(v_main1, v_start);
+            } else if constexpr (gain_mode == EpilogueGain::kRamp) {
+                auto v_gain = hn::MulAdd(v_idx, v_step, v_start);
+                v_gain = is_increasing ? hn::Min(v_gain, v_target) : hn::Max(v_gain, v_target);
+                v_main0 = hn::Mul(v_main0, v_gain);
+                v_main1 = hn::Mul(v_main1, v_gain);
+                v_idx = hn::Add(v_idx, v_lanes);
+            }
+            hn::StoreU(v_main0, d, main_buffer0 + i);
+            hn::StoreU(v_main1, d, main_buffer1 + i);
+        }
+        for (; i < num_samples; ++i) {
+            auto main0 = main_buffer0[i];
+            auto main1 = main_buffer1[i];
+            if constexpr (is_midside) {
+                const auto mid = main0;
+                main0 = mid + main1;
+                main1 = mid - main1;
+            }
+            if constexpr (copy_post) {
+                post_buffer0[i] = main0;
+                post_buffer1[i] = main1;
+            }
+            if constexpr (delta) {
+                main0 = pre_buffer0[i] - main0;
+                main1 = pre_buffer1[i] - main1;
+            } else if constexpr (gain_mode == EpilogueGain::kConstant) {
+                main0 *= start;
+                main1 *= start;
+            } else if constexpr (gain_mode == EpilogueGain::kRamp) {
+                const auto gain = start + step * static_cast<float>(i + 1);
+                const auto bounded_gain = is_increasing ? std::min(gain, target) : std::max(gain, target);
+                main0 *= bounded_gain;
+                main1 *= bounded_gain;
+            }
+            main_buffer0[i] = main0;
+            main_buffer1[i] = main1;
         }
     }
 
     void CompressController::processBuffer(float* __restrict main_buffer0, float* __restrict main_buffer1,
                                            float* __restrict side_buffer0, float* __restrict side_buffer1,
                                            const size_t num_samples, const bool bypass) {
-        // prepare followers
+        // prepare followers, the detector kernel depends on the punch-pump and the smooth state
         if (follower_[0].prepareBuffer()) {
             follower_[1].copyFrom(follower_[0]);
+            for (auto& band_followers : band_followers_) {
+                for (auto& f : band_followers) {
+                    f.copyFrom(follower_[0]);
+                }
+            }
+            updateDetectorKernel();
         }
-        // prepare rms compressors
-        if (c_use_rms_) {
-            if (rms_follower_[0].prepareBuffer()) {
-                rms_follower_[1].copyFrom(rms_follower_[0]);
+        // if bypassed, the gains on the bands are ones
+        if (!c_is_on_ || bypass) {
+            for (auto& gains : band_last_gains_) {
+                gains.fill(1.f);
             }
-            zldsp::vector::copy(rms_side_buffer0_.data(), side_buffer0, num_samples);
-            zldsp::vector::copy(rms_side_buffer1_.data(), side_buffer1, num_samples);
         }
-        // prepare computer & process
-        switch (c_direction_) {
-        case PCompDirection::kCompress: {
-            if (compression_computer_.prepareBuffer()) {
-                clipper_.setReductionAtUnit(compression_computer_.eval(0.f));
+        // keep the dry samples for the band fade
+        const auto band_fade_num = std::min(num_samples, band_fade_remaining_);
+        if (band_fade_num > 0) {
+            zldsp::vector::copy(band_fade_buffer0_.data(), main_buffer0, band_fade_num);
+            zldsp::vector::copy(band_fade_buffer1_.data(), main_buffer1, band_fade_num);
+        }
+        if (c_band_num_ > 1) {
+            processMultiband(main_buffer0, main_buffer1, side_buffer0, side_buffer1, num_samples, bypass);
+        } else {
+            // prepare rms compressors
+            if (c_use_rms_) {
+                if (rms_follower_[0].prepareBuffer()) {
+                    rms_follower_[1].copyFrom(rms_follower_[0]);
+                }
+                zldsp::vector::copy(rms_side_buffer0_.data(), side_buffer0, num_samples);
+                zldsp::vector::copy(rms_side_buffer1_.data(), side_buffer1, num_samples);
+            }
+            // prepare computer & process
+            if (!c_computer_ramp_) {
+                (this->*c_detector_kernel_)(side_buffer0, side_buffer1,
+                                            rms_side_buffer0_.data(), rms_side_buffer1_.data(), num_samples);
+            } else {
+                // split the block and step the computer parameters towards the target at each sub-block
+                const auto sub_block_size = kComputerSubBlockSize << c_oversample_idx_;
+                const auto num_sub_blocks = (num_samples + sub_block_size - 1) / sub_block_size;
+                for (size_t k = 0; k < num_sub_blocks; ++k) {
+                    stepComputerParas(k, num_sub_blocks);
+                    const auto start_idx = k * sub_block_size;
+                    const auto sub_num_samples = std::min(sub_block_size, num_samples - start_idx);
+                    (this->*c_detector_kernel_)(side_buffer0 + start_idx, side_buffer1 + start_idx,
+                                                rms_side_buffer0_.data() + start_idx,
+                                                rms_side_buffer1_.data() + start_idx, sub_num_samples);
+                }
+                applyComputerParas(c_computer_target_);
+                c_computer_ramp_ = false;
+            }
+            // mix rms -> hold -> stereo link -> range clamp -> decibel to gain -> apply, in a single pass
+            const auto use_hold = hold_buffer_[0].getSize() > 0;
+            if (c_use_rms_) {
+                if (use_hold) {
+                    dispatchSideKernel<true, true>(main_buffer0, main_buffer1, side_buffer0, side_buffer1,
+                                                   num_samples, bypass);
+                } else {
+                    dispatchSideKernel<true, false>(main_buffer0, main_buffer1, side_buffer0, side_buffer1,
+                                                    num_samples, bypass);
+                }
+            } else {
+                if (use_hold) {
+                    dispatchSideKernel<false, true>(main_buffer0, main_buffer1, side_buffer0, side_buffer1,
+                                                    num_samples, bypass);
+                } else {
+                    dispatchSideKernel<false, false>(main_buffer0, main_buffer1, side_buffer0, side_buffer1,
+                                                     num_samples, bypass);
+                }
             }
-            processSideBuffer(compression_computer_,
-                              side_buffer0, side_buffer1, num_samples);
-            break;
         }
-        case PCompDirection::kShape: {
-            compression_computer_.prepareBuffer();
-            processSideBuffer(compression_computer_,
-                              side_buffer0, side_buffer1, num_samples);
-            break;
+        if (band_fade_num > 0) {
+            processBandFade(main_buffer0, main_buffer1, band_fade_num);
         }
-        case PCompDirection::kExpand: {
-            expansion_computer_.prepareBuffer();
-            processSideBuffer(expansion_computer_,
-                              side_buffer0, side_buffer1, num_samples);
-            break;
+        profiler_.lap(kStageSideKernel);
+        // if bypassed, skip the clipper
+        if (!c_is_on_ || bypass) {
+            return;
         }
-        case PCompDirection::kInflate: {
-            inflation_computer_.prepareBuffer();
-            processSideBuffer(inflation_computer_,
-                              side_buffer0, side_buffer1, num_samples);
-            break;
+        // apply clipper
+        clipper_.prepareBuffer();
+        if (clipper_.getIsON()) {
+            clipper_.process(main_buffer0, num_samples);
+            clipper_.process(main_buffer1, num_samples);
         }
+        profiler_.lap(kStageClipper);
+    }
+
+    void CompressController::applyComputerParas(const std::array<float, kComputerParaNum>& paras) {
+        compression_computer_.setThreshold(paras[kThreshold]);
+        expansion_computer_.setThreshold(paras[kThreshold]);
+        inflation_computer_.setThreshold(paras[kThreshold]);
+        compression_computer_.setRatio(paras[kRatio]);
+        expansion_computer_.setRatio(paras[kRatio]);
+        inflation_computer_.setRatio(paras[kRatio]);
+        compression_computer_.setKneeW(paras[kKneeW]);
+        expansion_computer_.setKneeW(paras[kKneeW]);
+        inflation_computer_.setKneeW(paras[kKneeW]);
+        compression_computer_.setCurve(paras[kCurve]);
+        expansion_computer_.setFloor(paras[kFloor]);
+        inflation_computer_.setFloor(paras[kFloor]);
+        c_computer_paras_ = paras;
+    }
+
+    void CompressController::stepComputerParas(const size_t k, const size_t num_sub_blocks) {
+        const auto alpha = static_cast<float>(k + 1) / static_cast<float>(num_sub_blocks);
+        std::array<float, kComputerParaNum> paras{};
+        for (size_t i = 0; i < kComputerParaNum; ++i) {
+            paras[i] = c_computer_start_[i] + alpha * (c_computer_target_[i] - c_computer_start_[i]);
         }
-        // process rms compressors and mix rms
-        if (c_use_rms_) {
-            switch (c_direction_) {
-            case PCompDirection::kCompress:
-            case PCompDirection::kShape: {
-                processSideBufferRMS(compression_computer_,
-                                     rms_side_buffer0_.data(), rms_side_buffer1_.data(), num_samples);
-                break;
-            }
-            case PCompDirection::kExpand: {
-                processSideBufferRMS(expansion_computer_,
-                                     rms_side_buffer0_.data(), rms_side_buffer1_.data(), num_samples);
-                break;
+        applyComputerParas(paras);
+    }
+
+    void CompressController::processMultiband(float* __restrict main_buffer0, float* __restrict main_buffer1,
+                                              const float* __restrict side_buffer0,
+                                              const float* __restrict side_buffer1,
+                                              const size_t num_samples, const bool bypass) {
+        static constexpr BandTag d;
+        const auto v_trims = hn::Load(d, c_band_trims_.data());
+        // the chunks never cross the sub-blocks of the computer ramp, since the sub-block size is a multiple
+        const auto sub_block_size = kComputerSubBlockSize << c_oversample_idx_;
+        const auto num_sub_blocks = (num_samples + sub_block_size - 1) / sub_block_size;
+        for (size_t start_idx = 0; start_idx < num_samples; start_idx += kBandChunkSize) {
+            const auto chunk = std::min(kBandChunkSize, num_samples - start_idx);
+            if (c_computer_ramp_ && start_idx % sub_block_size == 0) {
+                stepComputerParas(start_idx / sub_block_size, num_sub_blocks);
             }
-            case PCompDirection::kInflate: {
-                processSideBufferRMS(inflation_computer_,
-                                     rms_side_buffer0_.data(), rms_side_buffer1_.data(), num_samples);
-                break;
+            // split main and side buffers into bands
+            splitter_.process(0, main_buffer0 + start_idx, band_main_[0].data(), chunk);
+            splitter_.process(1, main_buffer1 + start_idx, band_main_[1].data(), chunk);
+            splitter_.process(2, side_buffer0 + start_idx, band_side_[0].data(), chunk);
+            splitter_.process(3, side_buffer1 + start_idx, band_side_[1].data(), chunk);
+            // apply the band thresholds as detector trims
+            for (auto& band_side : band_side_) {
+                for (size_t i = 0; i < chunk; ++i) {
+                    auto* samples = band_side.data() + i * kMaxBandNum;
+                    hn::Store(hn::Mul(hn::Load(d, samples), v_trims), d, samples);
+                }
             }
+            (this->*c_band_detector_kernel_)(band_side_[0].data(), band_side_[1].data(), chunk);
+            // if bypassed, sum up the bands without gains, so that the main buffer keeps the phase of the splitter
+            if (!c_is_on_ || bypass) {
+                for (size_t i = 0; i < chunk; ++i) {
+                    const auto offset = i * kMaxBandNum;
+                    main_buffer0[start_idx + i] = hn::ReduceSum(d, hn::Load(d, band_main_[0].data() + offset));
+                    main_buffer1[start_idx + i] = hn::ReduceSum(d, hn::Load(d, band_main_[1].data() + offset));
+                }
+                continue;
             }
-            {
-                static constexpr hn::ScalableTag<float> d;
-                static constexpr size_t lanes = hn::MaxLanes(d);
-                const auto v_mix = hn::Set(d, c_rms_mix_);
-                size_t i = 0;
-                for (; i + lanes <= num_samples; i += lanes) {
-                    const auto v_rms_side0 = hn::LoadU(d, rms_side_buffer0_.data() + i);
-                    const auto v_rms_side1 = hn::LoadU(d, rms_side_buffer1_.data() + i);
-                    auto v_side0 = hn::LoadU(d, side_buffer0 + i);
-                    auto v_side1 = hn::LoadU(d, side_buffer1 + i);
-                    v_side0 = hn::MulAdd(v_mix, hn::Sub(v_rms_side0, v_side0), v_side0);
-                    v_side1 = hn::MulAdd(v_mix, hn::Sub(v_rms_side1, v_side1), v_side1);
-                    hn::StoreU(v_side0, d, side_buffer0 + i);
-                    hn::StoreU(v_side1, d, side_buffer1 + i);
+            if (c_stereo_mode_is_max) {
+                if (c_stereo_swap_) {
+                    processBandSideKernel<true, true>(main_buffer0 + start_idx, main_buffer1 + start_idx, chunk);
+                } else {
+                    processBandSideKernel<true, false>(main_buffer0 + start_idx, main_buffer1 + start_idx, chunk);
                 }
-                for (; i < num_samples; ++i) {
-                    const auto v_rms_side0 = rms_side_buffer0_[i];
-                    const auto v_rms_side1 = rms_side_buffer1_[i];
-                    auto v_side0 = side_buffer0[i];
-                    auto v_side1 = side_buffer1[i];
-                    v_side0 = c_rms_mix_ * (v_rms_side0 - v_side0) + v_side0;
-                    v_side1 = c_rms_mix_ * (v_rms_side1 - v_side1) + v_side1;
-                    side_buffer0[i] = v_side0;
-                    side_buffer1[i] = v_side1;
+            } else {
+                if (c_stereo_swap_) {
+                    processBandSideKernel<false, true>(main_buffer0 + start_idx, main_buffer1 + start_idx, chunk);
+                } else {
+                    processBandSideKernel<false, false>(main_buffer0 + start_idx, main_buffer1 + start_idx, chunk);
                 }
             }
         }
-        // apply the hold
-        if (hold_buffer_[0].getSize() > 0) {
-            for (size_t i = 0; i < num_samples; ++i) {
-                side_buffer0[i] = hold_buffer_[0].push(side_buffer0[i]);
-                side_buffer1[i] = hold_buffer_[1].push(side_buffer1[i]);
+        if (c_computer_ramp_) {
+            applyComputerParas(c_computer_target_);
+            c_computer_ramp_ = false;
+        }
+    }
+
+    void CompressController::processBandFade(float* __restrict main_buffer0, float* __restrict main_buffer1,
+                                             const size_t num_samples) {
+        static constexpr BandTag d;
+        const auto step = 1.f / static_cast<float>(band_fade_length_);
+        auto w = static_cast<float>(band_fade_length_ - band_fade_remaining_) * step;
+        const auto v_gain0 = hn::Load(d, band_fade_gains_[0].data());
+        const auto v_gain1 = hn::Load(d, band_fade_gains_[1].data());
+        for (size_t start_idx = 0; start_idx < num_samples; start_idx += kBandChunkSize) {
+            const auto chunk = std::min(kBandChunkSize, num_samples - start_idx);
+            // run the dry samples through the previous bands and apply their held gains
+            fade_splitter_.process(0, band_fade_buffer0_.data() + start_idx, band_main_[0].data(), chunk);
+            fade_splitter_.process(1, band_fade_buffer1_.data() + start_idx, band_main_[1].data(), chunk);
+            for (size_t i = 0; i < chunk; ++i) {
+                w += step;
+                const auto offset = i * kMaxBandNum;
+                const auto old0 = hn::ReduceSum(d, hn::Mul(hn::Load(d, band_main_[0].data() + offset), v_gain0));
+                const auto old1 = hn::ReduceSum(d, hn::Mul(hn::Load(d, band_main_[1].data() + offset), v_gain1));
+                main_buffer0[start_idx + i] = old0 + (main_buffer0[start_idx + i] - old0) * w;
+                main_buffer1[start_idx + i] = old1 + (main_buffer1[start_idx + i] - old1) * w;
             }
         }
-        // if bypassed, skip reduction calculation
+        band_fade_remaining_ -= num_samples;
+    }
+
+    template <bool link_max, bool stereo_swap>
+    void CompressController::processBandSideKernel(float* __restrict main_buffer0, float* __restrict main_buffer1,
+                                                   const size_t num_samples) {
+        static constexpr BandTag d;
+        static constexpr float kLn10 = 2.30258509299404568402f;
+
+        // the same stereo link, range clamp and decibel to gain as processSideKernel, applied per band
+        const float wet1 = c_is_downward_ ? c_wet1_ * kLn10 : -c_wet1_ * kLn10;
+        const float wet2 = c_is_downward_ ? c_wet2_ * kLn10 : -c_wet2_ * kLn10;
+        const auto range_low = c_is_range_inf_ ? -240.f : -c_range_;
+        const auto range_high = c_is_range_inf_ ? 40.f : std::min(40.f, c_range_);
+        const auto link = link_max ? c_stereo_link_max_ : c_stereo_link_;
+
+        const auto v_link = hn::Set(d, link);
+        const auto v_wet1 = hn::Set(d, wet1);
+        const auto v_wet2 = hn::Set(d, wet2);
+        const auto v_neg_range = hn::Set(d, range_low);
+        const auto v_pos_range = hn::Set(d, range_high);
+
+        auto v_gain0 = hn::Load(d, band_last_gains_[0].data());
+        auto v_gain1 = hn::Load(d, band_last_gains_[1].data());
+        for (size_t i = 0; i < num_samples; ++i) {
+            const auto offset = i * kMaxBandNum;
+            auto v_side0 = hn::Load(d, band_side_[0].data() + offset);
+            auto v_side1 = hn::Load(d, band_side_[1].data() + offset);
+            if constexpr (link_max) {
+                const auto v_min = hn::Min(v_side0, v_side1);
+                v_side0 = hn::MulAdd(hn::Sub(v_side0, v_min), v_link, v_min);
+                v_side1 = hn::MulAdd(hn::Sub(v_side1, v_min), v_link, v_min);
+            } else {
+                const auto v_xy = hn::Mul(v_link, hn::Sub(v_side0, v_side1));
+                const auto v_x = v_side0;
+                v_side0 = hn::Add(v_side1, v_xy);
+                v_side1 = hn::Sub(v_x, v_xy);
+            }
+            v_side0 = hn::Exp(d, hn::Mul(hn::Clamp(v_side0, v_neg_range, v_pos_range), v_wet1));
+            v_side1 = hn::Exp(d, hn::Mul(hn::Clamp(v_side1, v_neg_range, v_pos_range), v_wet2));
+            // apply the gains on the bands and sum them up, the unused bands are zeros
+            if constexpr (stereo_swap) {
+                v_gain0 = v_side1;
+                v_gain1 = v_side0;
+            } else {
+                v_gain0 = v_side0;
+                v_gain1 = v_side1;
+            }
+            main_buffer0[i] = hn::ReduceSum(d, hn::Mul(hn::Load(d, band_main_[0].data() + offset), v_gain0));
+            main_buffer1[i] = hn::ReduceSum(d, hn::Mul(hn::Load(d, band_main_[1].data() + offset), v_gain1));
+        }
+        hn::Store(v_gain0, d, band_last_gains_[0].data());
+        hn::Store(v_gain1, d, band_last_gains_[1].data());
+    }
+
+    template <bool use_rms, bool use_hold>
+    void CompressController::dispatchSideKernel(float* __restrict main_buffer0, float* __restrict main_buffer1,
+                                                float* __restrict side_buffer0, float* __restrict side_buffer1,
+                                                const size_t num_samples, const bool bypass) {
+        // if bypassed, only keep the hold buffers running
         if (!c_is_on_ || bypass) {
+            if constexpr (use_hold) {
+                processSideKernel<use_rms, use_hold, false, false, false>(
+                    main_buffer0, main_buffer1, side_buffer0, side_buffer1, num_samples);
+            }
             return;
         }
-        // apply the stereo link
         if (c_stereo_mode_is_max) {
-            for (size_t i = 0; i < num_samples; ++i) {
-                const auto x = side_buffer0[i];
-                const auto y = side_buffer1[i];
-                if (x < y) {
-                    side_buffer1[i] = (y - x) * c_stereo_link_max_ + x;
-                } else {
-                    side_buffer0[i] = (x - y) * c_stereo_link_max_ + y;
-                }
+            if (c_stereo_swap_) {
+                processSideKernel<use_rms, use_hold, true, true, true>(
+                    main_buffer0, main_buffer1, side_buffer0, side_buffer1, num_samples);
+            } else {
+                processSideKernel<use_rms, use_hold, true, true, false>(
+                    main_buffer0, main_buffer1, side_buffer0, side_buffer1, num_samples);
             }
         } else {
-            for (size_t i = 0; i < num_samples; ++i) {
-                const auto x = side_buffer0[i];
-                const auto y = side_buffer1[i];
-                const auto xy = c_stereo_link_ * (x - y);
-                side_buffer0[i] = y + xy;
-                side_buffer1[i] = x - xy;
+            if (c_stereo_swap_) {
+                processSideKernel<use_rms, use_hold, true, false, true>(
+                    main_buffer0, main_buffer1, side_buffer0, side_buffer1, num_samples);
+            } else {
+                processSideKernel<use_rms, use_hold, true, false, false>(
+                    main_buffer0, main_buffer1, side_buffer0, side_buffer1, num_samples);
             }
         }
-        // process wet values and convert decibel to gain, apply stereo swap
-        if (c_stereo_swap_) {
-            appleSideBuffer<true>(main_buffer0, main_buffer1, side_buffer0, side_buffer1, num_samples);
-        } else {
-            appleSideBuffer<false>(main_buffer0, main_buffer1, side_buffer0, side_buffer1, num_samples);
-        }
-        // apply clipper
-        clipper_.prepareBuffer();
-        if (clipper_.getIsON()) {
-            clipper_.process(main_buffer0, num_samples);
-            clipper_.process(main_buffer1, num_samples);
-        }
     }
 
-    template <bool stereo_swap>
-    void CompressController::appleSideBuffer(float* __restrict main_buffer0, float* __restrict main_buffer1,
-                                             float* __restrict side_buffer0, float* __restrict side_buffer1,
-                                             const size_t num_samples) const {
+    template <bool use_rms, bool use_hold, bool apply, bool link_max, bool stereo_swap>
+    void CompressController::processSideKernel(float* __restrict main_buffer0, float* __restrict main_buffer1,
+                                               const float* __restrict side_buffer0,
+                                               const float* __restrict side_buffer1,
+                                               const size_t num_samples) {
         static constexpr hn::ScalableTag<float> d;
         static constexpr size_t lanes = hn::MaxLanes(d);
         static constexpr float kLn10 = 2.30258509299404568402f;
 
+        // the direction is folded into the sign of the wet values
         const float wet1 = c_is_downward_ ? c_wet1_ * kLn10 : -c_wet1_ * kLn10;
         const float wet2 = c_is_downward_ ? c_wet2_ * kLn10 : -c_wet2_ * kLn10;
-
-        const auto v_wet1 = hn::Set(d, wet1);
-        const auto v_wet2 = hn::Set(d, wet2);
         const auto range_low = c_is_range_inf_ ? -240.f : -c_range_;
         const auto range_high = c_is_range_inf_ ? 40.f : std::min(40.f, c_range_);
+        const auto link = link_max ? c_stereo_link_max_ : c_stereo_link_;
 
+        const auto v_mix = hn::Set(d, c_rms_mix_);
+        const auto v_link = hn::Set(d, link);
+        const auto v_wet1 = hn::Set(d, wet1);
+        const auto v_wet2 = hn::Set(d, wet2);
         const auto v_neg_range = hn::Set(d, range_low);
         const auto v_pos_range = hn::Set(d, range_high);
 
+        alignas(64) std::array<float, lanes> hold0{}, hold1{};
+        // the gains of the last vector, they are kept for the band fade
+        [[maybe_unused]] auto v_gain0 = hn::Set(d, band_last_gains_[0][0]);
+        [[maybe_unused]] auto v_gain1 = hn::Set(d, band_last_gains_[1][0]);
+
         size_t i = 0;
         for (; i + lanes <= num_samples; i += lanes) {
             auto v_side0 = hn::LoadU(d, side_buffer0 + i);
             auto v_side1 = hn::LoadU(d, side_buffer1 + i);
-            v_side0 = hn::Clamp(v_side0, v_neg_range, v_pos_range);
-            v_side0 = hn::Exp(d, hn::Mul(v_side0, v_wet1));
-            v_side1 = hn::Clamp(v_side1, v_neg_range, v_pos_range);
-            v_side1 = hn::Exp(d, hn::Mul(v_side1, v_wet2));
-            auto v_main0 = hn::LoadU(d, main_buffer0 + i);
-            auto v_main1 = hn::LoadU(d, main_buffer1 + i);
-            if constexpr (stereo_swap) {
-                v_main0 = hn::Mul(v_main0, v_side1);
-                v_main1 = hn::Mul(v_main1, v_side0);
-            } else {
-                v_main0 = hn::Mul(v_main0, v_side0);
-                v_main1 = hn::Mul(v_main1, v_side1);
+            // mix rms
+            if constexpr (use_rms) {
+                const auto v_rms_side0 = hn::LoadU(d, rms_side_buffer0_.data() + i);
+                const auto v_rms_side1 = hn::LoadU(d, rms_side_buffer1_.data() + i);
+                v_side0 = hn::MulAdd(v_mix, hn::Sub(v_rms_side0, v_side0), v_side0);
+                v_side1 = hn::MulAdd(v_mix, hn::Sub(v_rms_side1, v_side1), v_side1);
+            }
+            // apply the hold, which is sequential
+            if constexpr (use_hold) {
+                hn::Store(v_side0, d, hold0.data());
+                hn::Store(v_side1, d, hold1.data());
+                for (size_t j = 0; j < lanes; ++j) {
+                    hold0[j] = hold_buffer_[0].push(hold0[j]);
+                    hold1[j] = hold_buffer_[1].push(hold1[j]);
+                }
+                v_side0 = hn::Load(d, hold0.data());
+                v_side1 = hn::Load(d, hold1.data());
+            }
+            if constexpr (apply) {
+                // apply the stereo link
+                if constexpr (link_max) {
+                    const auto v_min = hn::Min(v_side0, v_side1);
+                    v_side0 = hn::MulAdd(hn::Sub(v_side0, v_min), v_link, v_min);
+                    v_side1 = hn::MulAdd(hn::Sub(v_side1, v_min), v_link, v_min);
+                } else {
+                    const auto v_xy = hn::Mul(v_link, hn::Sub(v_side0, v_side1));
+                    const auto v_x = v_side0;
+                    v_side0 = hn::Add(v_side1, v_xy);
+                    v_side1 = hn::Sub(v_x, v_xy);
+                }
+                // process wet values and convert decibel to gain
+                v_side0 = hn::Clamp(v_side0, v_neg_range, v_pos_range);
+                v_side0 = hn::Exp(d, hn::Mul(v_side0, v_wet1));
+                v_side1 = hn::Clamp(v_side1, v_neg_range, v_pos_range);
+                v_side1 = hn::Exp(d, hn::Mul(v_side1, v_wet2));
+                // apply stereo swap
+                if constexpr (stereo_swap) {
+                    v_gain0 = v_side1;
+                    v_gain1 = v_side0;
+                } else {
+                    v_gain0 = v_side0;
+                    v_gain1 = v_side1;
+                }
+                const auto v_main0 = hn::LoadU(d, main_buffer0 + i);
+                const auto v_main1 = hn::LoadU(d, main_buffer1 + i);
+                hn::StoreU(hn::Mul(v_main0, v_gain0), d, main_buffer0 + i);
+                hn::StoreU(hn::Mul(v_main1, v_gain1), d, main_buffer1 + i);
             }
-            hn::StoreU(v_main0, d, main_buffer0 + i);
-            hn::StoreU(v_main1, d, main_buffer1 + i);
+        }
+        if constexpr (apply) {
+            band_last_gains_[0][0] = hn::ExtractLane(v_gain0, lanes - 1);
+            band_last_gains_[1][0] = hn::ExtractLane(v_gain1, lanes - 1);
         }
 
         for (; i < num_samples; ++i) {
             float s0 = side_buffer0[i];
             float s1 = side_buffer1[i];
-            s0 = std::clamp(s0, range_low, range_high);
-            s0 = std::exp(s0 * wet1);
-            s1 = std::clamp(s1, range_low, range_high);
-            s1 = std::exp(s1 * wet2);
-            float m0 = main_buffer0[i];
-            float m1 = main_buffer1[i];
-            if constexpr (stereo_swap) {
-                m0 *= s1;
-                m1 *= s0;
-            } else {
-                m0 *= s0;
-                m1 *= s1;
+            if constexpr (use_rms) {
+                s0 = c_rms_mix_ * (rms_side_buffer0_[i] - s0) + s0;
+                s1 = c_rms_mix_ * (rms_side_buffer1_[i] - s1) + s1;
+            }
+            if constexpr (use_hold) {
+                s0 = hold_buffer_[0].push(s0);
+                s1 = hold_buffer_[1].push(s1);
+            }
+            if constexpr (apply) {
+                if constexpr (link_max) {
+                    const auto s_min = std::min(s0, s1);
+                    s0 = (s0 - s_min) * link + s_min;
+                    s1 = (s1 - s_min) * link + s_min;
+                } else {
+                    const auto xy = link * (s0 - s1);
+                    const auto x = s0;
+                    s0 = s1 + xy;
+                    s1 = x - xy;
+                }
+                s0 = std::clamp(s0, range_low, range_high);
+                s0 = std::exp(s0 * wet1);
+                s1 = std::clamp(s1, range_low, range_high);
+                s1 = std::exp(s1 * wet2);
+                band_last_gains_[0][0] = stereo_swap ? s1 : s0;
+                band_last_gains_[1][0] = stereo_swap ? s0 : s1;
+                main_buffer0[i] *= band_last_gains_[0][0];
+                main_buffer1[i] *= band_last_gains_[1][0];
             }
-            main_buffer0[i] = m0;
-            main_buffer1[i] = m1;
         }
     }
 
-    template <typename C>
-    void CompressController::processSideBuffer(C& c,
-                                               float* __restrict buffer0, float* __restrict buffer1,
-                                               size_t num_samples) {
-        switch (c_comp_style_) {
-        case zldsp::compressor::Style::kClean: {
-            dispatchProcess(c, clean_comps_[0], clean_comps_[1], buffer0, buffer1, num_samples);
+    void CompressController::updateDetectorKernel() {
+        using zldsp::compressor::Style;
+        const auto follower_idx = static_cast<size_t>(follower_[0].getPPState()) * kSStateNum
+            + static_cast<size_t>(follower_[0].getSState());
+        // expanders and inflators only support the clean and the classic style, c_comp_style_ is limited accordingly
+        switch (c_direction_) {
+        case PCompDirection::kCompress:
+        case PCompDirection::kShape: {
+            static constexpr auto kKernels = makeDetectorKernels<decltype(compression_computer_), false,
+                Style::kClean, Style::kClassic, Style::kOptical, Style::kVocal>();
+            static constexpr auto kBandKernels = makeDetectorKernels<decltype(compression_computer_), true,
+                Style::kClean, Style::kClassic, Style::kOptical, Style::kVocal>();
+            c_detector_kernel_ = kKernels[static_cast<size_t>(c_comp_style_)][follower_idx];
+            c_band_detector_kernel_ = kBandKernels[static_cast<size_t>(c_comp_style_)][follower_idx];
             break;
         }
-        case zldsp::compressor::Style::kClassic: {
-            dispatchProcess(c, classic_comps_[0], classic_comps_[1], buffer0, buffer1, num_samples);
+        case PCompDirection::kExpand: {
+            static constexpr auto kKernels = makeDetectorKernels<decltype(expansion_computer_), false,
+                Style::kClean, Style::kClassic>();
+            static constexpr auto kBandKernels = makeDetectorKernels<decltype(expansion_computer_), true,
+                Style::kClean, Style::kClassic>();
+            c_detector_kernel_ = kKernels[static_cast<size_t>(c_comp_style_)][follower_idx];
+            c_band_detector_kernel_ = kBandKernels[static_cast<size_t>(c_comp_style_)][follower_idx];
             break;
         }
-        case zldsp::compressor::Style::kOptical: {
-            dispatchProcess(c, optical_comps_[0], optical_comps_[1], buffer0, buffer1, num_samples);
+        case PCompDirection::kInflate: {
+            static constexpr auto kKernels = makeDetectorKernels<decltype(inflation_computer_), false,
+                Style::kClean, Style::kClassic>();
+            static constexpr auto kBandKernels = makeDetectorKernels<decltype(inflation_computer_), true,
+                Style::kClean, Style::kClassic>();
+            c_detector_kernel_ = kKernels[static_cast<size_t>(c_comp_style_)][follower_idx];
+            c_band_detector_kernel_ = kBandKernels[static_cast<size_t>(c_comp_style_)][follower_idx];
             break;
         }
-        case zldsp::compressor::Style::kVocal: {
-            dispatchProcess(c, vocal_comps_[0], vocal_comps_[1], buffer0, buffer1, num_samples);
-            break;
         }
-        default:
-            return;
+    }
+
+    template <typename C, zldsp::compressor::Style style,
+              zldsp::compressor::PPState pp_state, zldsp::compressor::SState s_state>
+    void CompressController::processDetectorKernel(float* __restrict side_buffer0, float* __restrict side_buffer1,
+                                                   float* __restrict rms_side_buffer0,
+                                                   float* __restrict rms_side_buffer1,
+                                                   const size_t num_samples) {
+        auto& c = prepareComputer<C>();
+        auto& comps = getStyleComps<style>();
+        processStyle<C, std::remove_reference_t<decltype(comps[0])>, pp_state, s_state>(
+            c, comps[0], comps[1], side_buffer0, side_buffer1, num_samples);
+        profiler_.lap(kStageStyle);
+        // process rms compressors
+        if (c_use_rms_) {
+            processSideBufferRMS(c, rms_side_buffer0, rms_side_buffer1, num_samples);
+            profiler_.lap(kStageRMS);
         }
     }
 
-    template <typename C, typename Style>
-    void CompressController::dispatchProcess(C& c, Style& comp0, Style& comp1,
-                                             float* __restrict buffer0, float* __restrict buffer1,
-                                             const size_t num_samples) {
-        using zldsp::compressor::PPState;
-        using zldsp::compressor::SState;
-        const auto pp_state = follower_[0].getPPState();
-        const auto s_state = follower_[0].getSState();
-        switch (pp_state) {
-        // ================== PPState: kOff ==================
-        case PPState::kOff:
-            switch (s_state) {
-            case SState::kOff: {
-                comp0.template process<C, zldsp::compressor::PSFollower<float>, PPState::kOff, SState::kOff>(
-                    c, follower_[0], buffer0, num_samples);
-                comp1.template process<C, zldsp::compressor::PSFollower<float>, PPState::kOff, SState::kOff>(
-                    c, follower_[1], buffer1, num_samples);
-                break;
-            }
-            case SState::kFull: {
-                comp0.template process<C, zldsp::compressor::PSFollower<float>, PPState::kOff, SState::kFull>(
-                    c, follower_[0], buffer0, num_samples);
-                comp1.template process<C, zldsp::compressor::PSFollower<float>, PPState::kOff, SState::kFull>(
-                    c, follower_[1], buffer1, num_samples);
-                break;
-            }
-            case SState::kMix: {
-                comp0.template process<C, zldsp::compressor::PSFollower<float>, PPState::kOff, SState::kMix>(
-                    c, follower_[0], buffer0, num_samples);
-                comp1.template process<C, zldsp::compressor::PSFollower<float>, PPState::kOff, SState::kMix>(
-                    c, follower_[1], buffer1, num_samples);
-                break;
+    template <typename C, zldsp::compressor::Style style,
+              zldsp::compressor::PPState pp_state, zldsp::compressor::SState s_state>
+    void CompressController::processBandDetectorKernel(float* __restrict band_side_buffer0,
+                                                       float* __restrict band_side_buffer1,
+                                                       const size_t num_samples) {
+        static constexpr BandTag d;
+        using StyleComp = std::remove_reference_t<decltype(getStyleComps<style>()[0])>;
+        auto& c = prepareComputer<C>();
+        const std::array band_buffers{band_side_buffer0, band_side_buffer1};
+        for (size_t chan = 0; chan < 2; ++chan) {
+            // the bands of one channel run in the lanes of one register
+            std::array<zldsp::compressor::PSFollower<float>*, kMaxBandNum> followers{};
+            for (size_t band = 0; band < kMaxBandNum; ++band) {
+                followers[band] = &band_followers_[chan][band];
             }
+            zldsp::compressor::PSFollowerLanes<BandTag> lanes{followers};
+            if constexpr (style == zldsp::compressor::Style::kClassic || style == zldsp::compressor::Style::kVocal) {
+                auto v_x0 = hn::Load(d, band_x0_[chan].data());
+                StyleComp::template processLanes<C, BandTag, pp_state, s_state>(
+                    c, lanes, v_x0, band_buffers[chan], num_samples);
+                hn::Store(v_x0, d, band_x0_[chan].data());
+            } else {
+                StyleComp::template processLanes<C, BandTag, pp_state, s_state>(
+                    c, lanes, band_buffers[chan], num_samples);
             }
-            break;
+            lanes.store();
+        }
+        profiler_.lap(kStageStyle);
+    }
 
-        // ================== PPState: kPunch ==================
-        case PPState::kPunch:
-            switch (s_state) {
-            case SState::kOff: {
-                comp0.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPunch, SState::kOff>(
-                    c, follower_[0], buffer0, num_samples);
-                comp1.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPunch, SState::kOff>(
-                    c, follower_[1], buffer1, num_samples);
-                break;
-            }
-            case SState::kFull: {
-                comp0.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPunch, SState::kFull>(
-                    c, follower_[0], buffer0, num_samples);
-                comp1.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPunch, SState::kFull>(
-                    c, follower_[1], buffer1, num_samples);
-                break;
-            }
-            case SState::kMix: {
-                comp0.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPunch, SState::kMix>(
-                    c, follower_[0], buffer0, num_samples);
-                comp1.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPunch, SState::kMix>(
-                    c, follower_[1], buffer1, num_samples);
-                break;
-            }
+    template <typename C>
+    C& CompressController::prepareComputer() {
+        auto& c = getComputer<C>();
+        if constexpr (std::is_same_v<C, decltype(compression_computer_)>) {
+            if (c.prepareBuffer() && c_direction_ == PCompDirection::kCompress) {
+                clipper_.setReductionAtUnit(c.eval(0.f));
             }
-            break;
+        } else {
+            c.prepareBuffer();
+        }
+        return c;
+    }
 
-        // ================== PPState: kPump ==================
-        case PPState::kPump:
-            switch (s_state) {
-            case SState::kOff: {
-                comp0.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPump, SState::kOff>(
-                    c, follower_[0], buffer0, num_samples);
-                comp1.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPump, SState::kOff>(
-                    c, follower_[1], buffer1, num_samples);
-                break;
-            }
-            case SState::kFull: {
-                comp0.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPump, SState::kFull>(
-                    c, follower_[0], buffer0, num_samples);
-                comp1.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPump, SState::kFull>(
-                    c, follower_[1], buffer1, num_samples);
-                break;
-            }
-            case SState::kMix: {
-                comp0.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPump, SState::kMix>(
-                    c, follower_[0], buffer0, num_samples);
-                comp1.template process<C, zldsp::compressor::PSFollower<float>, PPState::kPump, SState::kMix>(
-                    c, follower_[1], buffer1, num_samples);
-                break;
-            }
-            }
-            break;
+    template <typename C>
+    C& CompressController::getComputer() {
+        if constexpr (std::is_same_v<C, decltype(compression_computer_)>) {
+            return compression_computer_;
+        } else if constexpr (std::is_same_v<C, decltype(expansion_computer_)>) {
+            return expansion_computer_;
+        } else {
+            return inflation_computer_;
+        }
+    }
+
+    template <zldsp::compressor::Style style>
+    auto& CompressController::getStyleComps() {
+        if constexpr (style == zldsp::compressor::Style::kClean) {
+            return clean_comps_;
+        } else if constexpr (style == zldsp::compressor::Style::kClassic) {
+            return classic_comps_;
+        } else if constexpr (style == zldsp::compressor::Style::kOptical) {
+            return optical_comps_;
+        } else {
+            return vocal_comps_;
+        }
+    }
+
+    template <typename C, typename Style, zldsp::compressor::PPState pp_state, zldsp::compressor::SState s_state>
+    void CompressController::processStyle(C& c, Style& comp0, Style& comp1,
+                                          float* __restrict buffer0, float* __restrict buffer1,
+                                          const size_t num_samples) {
+        if constexpr (requires { &Style::template processStereo<C, pp_state, s_state>; }) {
+            // the feedback styles run both channels in the lanes of one register
+            Style::template processStereo<C, pp_state, s_state>(c, comp0, comp1, follower_[0], follower_[1],
+                                                                buffer0, buffer1, num_samples);
+        } else {
+            comp0.template process<C, zldsp::compressor::PSFollower<float>, pp_state, s_state>(
+                c, follower_[0], buffer0, num_samples);
+            comp1.template process<C, zldsp::compressor::PSFollower<float>, pp_state, s_state>(
+                c, follower_[1], buffer1, num_samples);
         }
     }
 
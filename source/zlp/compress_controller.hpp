@@ -9,7 +9,8 @@
 
 #pragma once
 
-#include "../chore/thread/notifier.hpp"
+#include "../chore/profile/stage_profiler.hpp"
+#include "../chore/thread/dirty_mask.hpp"
 #include "../dsp/compressor/compressor.hpp"
 #include "../dsp/gain/gain.hpp"
 #include "../dsp/splitter/splitter.hpp"
@@ -31,13 +32,40 @@ namespace zlp {
         static constexpr size_t kAnalyzerPointNum = 251;
         static constexpr size_t kAvgAnalyzerPointNum = 120;
 
+        // stages of the timing probes, the rms mix, hold, stereo link and apply are fused into the side kernel
+        enum ProfileStage : size_t {
+            kStagePrepare, kStageLookahead, kStagePreCopy, kStageMSSplit, kStageUpsample,
+            kStageStyle, kStageRMS, kStageSideKernel, kStageClipper, kStageDownsample,
+            kStageGain, kStageAnalyzer, kStageLUFS, kStageNum
+        };
+
+        static constexpr std::array<const char*, kStageNum> kStageNames{
+            "prepare", "lookahead", "pre copy", "m/s split", "upsample",
+            "style", "rms", "side kernel", "clipper", "downsample",
+            "gain", "analyzer", "lufs matcher"
+        };
+
         explicit CompressController(juce::AudioProcessor& processor);
 
+        /**
+         * prepare the controller, if the processor is non-realtime, the offline quality mode is used
+         * the latency is updated and reported before returning
+         * @param sample_rate the sample rate
+         * @param max_num_samples the maximum number of samples per block
+         */
         void prepare(double sample_rate, size_t max_num_samples);
 
         void process(std::array<float*, 2> main_pointers, std::array<float*, 2> side_pointers,
                      size_t num_samples, bool bypass);
 
+        /**
+         * process the main buffer while bypassed, only the latency is kept
+         * the side-chain and the detector are left untouched and get reset when the processing resumes
+         * @param main_pointers the main buffer
+         * @param num_samples the number of samples
+         */
+        void processBypass(std::array<float*, 2> main_pointers, size_t num_samples);
+
         auto& getMagAnalyzerSender() { return mag_analyzer_sender_; }
 
         auto& getCompressionComputer() { return compression_computer_; }
@@ -52,166 +80,274 @@ namespace zlp {
 
         auto& getClipper() { return clipper_; }
 
+        auto& getProfiler() { return profiler_; }
+
+        /**
+         * thread-safe method
+         * computer parameter changes are ramped across the next block in sub-blocks
+         */
+        void setThreshold(const float x) {
+            computer_paras_[kThreshold].store(x, std::memory_order::relaxed);
+            update_flags_.signal(kUpdateComputer);
+        }
+
+        void setRatio(const float x) {
+            computer_paras_[kRatio].store(x, std::memory_order::relaxed);
+            update_flags_.signal(kUpdateComputer);
+        }
+
+        void setKneeW(const float x) {
+            computer_paras_[kKneeW].store(x, std::memory_order::relaxed);
+            update_flags_.signal(kUpdateComputer);
+        }
+
+        void setCurve(const float x) {
+            computer_paras_[kCurve].store(x, std::memory_order::relaxed);
+            update_flags_.signal(kUpdateComputer);
+        }
+
+        void setFloor(const float x) {
+            computer_paras_[kFloor].store(x, std::memory_order::relaxed);
+            update_flags_.signal(kUpdateComputer);
+        }
+
         void setCompDirection(const PCompDirection::Direction direction) {
             direction_.store(direction, std::memory_order::relaxed);
-            to_update_style_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateStyle);
         }
 
         void setCompStyle(const zldsp::compressor::Style style) {
             comp_style_.store(style, std::memory_order::relaxed);
-            to_update_style_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateStyle);
         }
 
         void setAttack(const float attack) {
             attack_.store(attack, std::memory_order::relaxed);
-            to_update_follower_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateFollower);
         }
 
         void setRelease(const float release) {
             release_.store(release, std::memory_order::relaxed);
-            to_update_follower_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateFollower);
         }
 
         void setRMSSpeed(const float speed) {
             rms_speed_.store(speed, std::memory_order::relaxed);
-            to_update_follower_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateFollower);
         }
 
         void setRMSOn(const bool use_rms) {
             use_rms_.store(use_rms, std::memory_order::relaxed);
-            to_update_rms_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateRMS);
         }
 
         void setRMSLength(const float millisecond) {
             const auto seconds = millisecond * 1e-3f;
             rms_length_.store(seconds, std::memory_order::relaxed);
-            to_update_rms_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateRMS);
         }
 
         void setRMSMix(const float percent) {
             rms_mix_.store(percent * 0.01f, std::memory_order::relaxed);
-            to_update_rms_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateRMS);
         }
 
         void setHoldLength(const float millisecond) {
             hold_length_.store(millisecond * 1e-3f, std::memory_order::relaxed);
-            to_update_hold_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateHold);
         }
 
         void setRange(const float db) {
             range_.store(db, std::memory_order::relaxed);
-            to_update_range_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateRange);
         }
 
         void setIsRangeINF(const bool is_range_inf) {
             is_range_inf_.store(is_range_inf, std::memory_order::relaxed);
-            to_update_range_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateRange);
+        }
+
+        /**
+         * set the number of bands, a single band turns off the multiband mode
+         * @param band_num the number of bands, from 1 to kCompBandNum
+         */
+        void setBandNum(const size_t band_num) {
+            band_num_.store(band_num, std::memory_order::relaxed);
+            update_flags_.signal(kUpdateMultiband);
+        }
+
+        /**
+         * set the frequency of one crossover, the crossovers are sorted before use
+         * @param idx the crossover idx
+         * @param freq the frequency in Hz
+         */
+        void setCrossover(const size_t idx, const float freq) {
+            crossovers_[idx].store(freq, std::memory_order::relaxed);
+            update_flags_.signal(kUpdateMultiband);
+        }
+
+        /**
+         * set the detector trim of one band, a positive trim raises the detector input and results in more gain change
+         * @param idx the band idx
+         * @param db the trim in dB
+         */
+        void setBandTrim(const size_t idx, const float db) {
+            band_trims_[idx].store(db, std::memory_order::relaxed);
+            update_flags_.signal(kUpdateMultiband);
         }
 
         void setOutputGain(const float db) {
             output_gain_db_.store(db, std::memory_order::relaxed);
-            to_update_output_gain_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateOutputGain);
         }
 
         void setWet(const float percent) {
             wet_.store(percent * 0.01f, std::memory_order::relaxed);
-            to_update_wet_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateWet);
         }
 
         void setWet1(const float percent) {
             wet1_.store(percent * 0.01f, std::memory_order::relaxed);
-            to_update_wet_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateWet);
         }
 
         void setWet2(const float percent) {
             wet2_.store(percent * 0.01f, std::memory_order::relaxed);
-            to_update_wet_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateWet);
         }
 
         void setMagAnalyzerOn(const bool f) {
             mag_analyzer_on_.store(f, std::memory_order::relaxed);
-            to_update_status_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateStatus);
         }
 
         void setLUFSMatcherOn(const bool f) {
             lufs_matcher_on_.store(f, std::memory_order::relaxed);
-            to_update_status_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateStatus);
         }
 
         float getLUFSMatcherDiff() const {
             return lufs_matcher_.getDiff();
         }
 
+        void setLUFSMatcherPublishInterval(const double seconds) {
+            lufs_matcher_.setPublishInterval(seconds);
+        }
+
+        const zldsp::loudness::LUFSMeter<float>& getOutLoudnessMeter() const {
+            return out_loudness_meter_;
+        }
+
+        void resetOutLoudnessMeter() {
+            to_reset_out_loudness_.store(true, std::memory_order::relaxed);
+            update_flags_.signal(kUpdateStatus);
+        }
+
         void setStereoMode(const int mode) {
             stereo_mode_.store(mode, std::memory_order::relaxed);
-            to_update_stereo_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateStereo);
         }
 
         void setStereoSwap(const bool f) {
             stereo_swap_.store(f, std::memory_order::relaxed);
-            to_update_stereo_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateStereo);
         }
 
         void setStereoLink(const float percent) {
             stereo_link_.store(1.f - percent * 0.005f, std::memory_order::relaxed);
-            to_update_stereo_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateStereo);
         }
 
         void setIsON(const bool is_on) {
             is_on_.store(is_on, std::memory_order::relaxed);
-            to_update_status_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateStatus);
         }
 
         void setIsDelta(const bool is_delta) {
             is_delta_.store(is_delta, std::memory_order::relaxed);
-            to_update_status_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateStatus);
         }
 
         void setOversampleIdx(const int idx) {
             oversample_idx_.store(idx, std::memory_order::relaxed);
-            to_update_oversample_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateOversample);
+        }
+
+        /**
+         * set the minimum oversampling idx of the offline quality mode
+         * it takes effect at the next prepare call
+         * @param idx the oversampling idx
+         */
+        void setOfflineOversampleIdx(const int idx) {
+            offline_oversample_idx_.store(idx, std::memory_order::relaxed);
+        }
+
+        /**
+         * thread-safe method
+         * get the time it takes for the output and all detector states to settle after the input becomes silent
+         * @return the tail length in seconds
+         */
+        double getTailLengthSeconds() const {
+            const auto use_rms = use_rms_.load(std::memory_order::relaxed);
+            const auto release_mul = use_rms
+                                         ? std::max(1.f, rms_speed_.load(std::memory_order::relaxed))
+                                         : 1.f;
+            const auto release = static_cast<double>(release_.load(std::memory_order::relaxed) * release_mul) * 1e-3;
+            const auto rms_length = use_rms ? static_cast<double>(rms_length_.load(std::memory_order::relaxed)) : 0.0;
+            return static_cast<double>(pdc_.load(std::memory_order::relaxed)) / sample_rate_
+                + static_cast<double>(std::abs(lookahead_delay_length_.load(std::memory_order::relaxed)))
+                + static_cast<double>(hold_length_.load(std::memory_order::relaxed))
+                + rms_length + release * kReleaseTailMul + kTailMargin;
         }
 
         void setLookahead(const float x) {
             lookahead_delay_length_.store(x * 0.001f, std::memory_order::relaxed);
-            to_update_lookahead_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateLookahead);
+        }
+
+        /**
+         * set the latency of the side-chain processing before the compressor, the main buffer is delayed to align
+         * @param samples the latency in samples
+         */
+        void setSideLatency(const int samples) {
+            if (side_latency_.exchange(samples, std::memory_order::relaxed) != samples) {
+                update_flags_.signal(kUpdateLookahead);
+            }
         }
 
     private:
+        // the follower decays by 2 * pi time constants per release time, 1.5 release times is about -80 dB
+        static constexpr double kReleaseTailMul = 1.5;
+        // extra time for the side-chain filters and the style compressors to settle
+        static constexpr double kTailMargin = 0.1;
         juce::AudioProcessor& processor_ref_;
         double sample_rate_{48000.0};
         std::array<zldsp::vector::aligned_vector<float>, 2> pre_buffer_, post_buffer_;
         std::array<float*, 2> pre_pointers_{}, post_pointers_{};
-        // global parameter update flag
-        zlchore::thread::Notifier to_update_{true};
+        // parameter update flags, raised by setters and taken once per block by the audio thread
+        enum UpdateFlag : uint32_t {
+            kUpdateStatus = 1 << 0,
+            kUpdateStereo = 1 << 1,
+            kUpdateStyle = 1 << 2,
+            kUpdateWet = 1 << 3,
+            kUpdateOversample = 1 << 4,
+            kUpdateLookahead = 1 << 5,
+            kUpdateFollower = 1 << 6,
+            kUpdateRMS = 1 << 7,
+            kUpdateHold = 1 << 8,
+            kUpdateRange = 1 << 9,
+            kUpdateOutputGain = 1 << 10,
+            kUpdateComputer = 1 << 11,
+            kUpdateMultiband = 1 << 12,
+            kUpdateAll = (1 << 13) - 1
+        };
+
+        zlchore::thread::DirtyMask update_flags_{kUpdateAll};
+        // per-stage timing probes, compiled out unless ZL_DSP_PROFILE is on
+        zlchore::profile::StageProfiler<kStageNum> profiler_;
         // on and delta
         std::atomic<bool> is_on_{true}, is_delta_{false};
         bool c_is_on_{true}, c_is_delta_{false};
-        zlchore::thread::Notifier to_update_status_{true};
         // magnitude analyzer
         std::atomic<bool> mag_analyzer_on_{true};
         bool c_mag_analyzer_on_{true};
@@ -220,6 +356,9 @@ namespace zlp {
         std::atomic<bool> lufs_matcher_on_{false};
         bool c_lufs_matcher_on_{false};
         zldsp::loudness::LUFSMatcher<float> lufs_matcher_{true};
+        // output loudness meter, runs together with the magnitude analyzer
+        std::atomic<bool> to_reset_out_loudness_{false};
+        zldsp::loudness::LUFSMeter<float> out_loudness_meter_{true};
         // copy pre post flags
         bool c_copy_pre{false}, c_copy_post{false};
         // stereo control
@@ -229,22 +368,30 @@ namespace zlp {
         float c_stereo_link_{1.}, c_stereo_link_max_{1.f};
         std::atomic<bool> stereo_swap_{false};
         bool c_stereo_swap_{false};
-        zlchore::thread::Notifier to_update_stereo_{true};
+        // the fully specialised detector of the current direction, style and follower state
+        // it is resolved by updateDetectorKernel when any of them changes
+        using DetectorKernel = void (CompressController::*)(float* __restrict, float* __restrict,
+                                                            float* __restrict, float* __restrict, size_t);
+        static constexpr size_t kPPStateNum = 3, kSStateNum = 3;
+        DetectorKernel c_detector_kernel_{nullptr};
+        // the detector of the multiband mode, it processes the bands of both channels, see processBandDetectorKernel
+        using BandDetectorKernel = void (CompressController::*)(float* __restrict, float* __restrict, size_t);
+        BandDetectorKernel c_band_detector_kernel_{nullptr};
         // compressor style
         std::atomic<PCompDirection::Direction> direction_{PCompDirection::kCompress};
         PCompDirection::Direction c_direction_{PCompDirection::kCompress};
         bool c_is_downward_{true};
         std::atomic<zldsp::compressor::Style> comp_style_{zldsp::compressor::Style::kClean};
         zldsp::compressor::Style c_comp_style_{zldsp::compressor::Style::kClean};
-        zlchore::thread::Notifier to_update_style_{true};
         // wet
-        zlchore::thread::Notifier to_update_wet_{true};
         std::atomic<float> wet_{1.0}, wet1_{1.0}, wet2_{1.0};
         float c_wet1_{1.0}, c_wet2_{1.0};
         // oversample
         std::atomic<int> oversample_idx_{0};
         int c_oversample_idx_{-1};
-        zlchore::thread::Notifier to_update_oversample_{true};
+        // offline quality mode, it uses at least the offline oversampling idx and longer halfband filters
+        std::atomic<int> offline_oversample_idx_{0};
+        bool c_is_offline_{false};
         // oversamplers
 #if ZL_MAX_OVERSAMPLE_RATE >= 1
         zldsp::oversample::OverSampler<float, 1> over_sampler2_;
@@ -273,15 +420,33 @@ namespace zlp {
         };
 
         std::atomic<float> lookahead_delay_length_{0.f};
-        zlchore::thread::Notifier to_update_lookahead_{true};
         DelayStatus delay_status_{DelayStatus::kZero};
         zldsp::delay::IntegerDelay<float> lookahead_delay_{};
+        // side-chain latency, e.g., of the linear-phase side-chain EQ
+        static constexpr float kMaxSideLatencySeconds = 0.1f;
+        std::atomic<int> side_latency_{0};
+        zldsp::delay::IntegerDelay<float> side_delay_{};
         // pdc
         std::atomic<int> pdc_{0};
+        // light bypass, the output fades from the dry signal when the processing resumes
+        static constexpr double kResumeFadeSeconds = 0.02;
+        bool was_light_bypassed_{false};
+        size_t resume_fade_length_{1}, resume_fade_remaining_{0};
         // computer, trackers and followers
         zldsp::compressor::CompressionComputer<float, true> compression_computer_{};
         zldsp::compressor::ExpansionComputer<float, true> expansion_computer_{};
         zldsp::compressor::InflationComputer<float, true> inflation_computer_{};
+        // computer parameters, a change is ramped across one block with a step per sub-block
+        // since the host only delivers the automation value at the end of the block
+        static constexpr size_t kComputerSubBlockSize = 32;
+
+        enum ComputerPara {
+            kThreshold, kRatio, kKneeW, kCurve, kFloor, kComputerParaNum
+        };
+
+        std::array<std::atomic<float>, kComputerParaNum> computer_paras_{-18.f, 2.f, .25f, 0.f, -140.f};
+        std::array<float, kComputerParaNum> c_computer_paras_{}, c_computer_start_{}, c_computer_target_{};
+        bool c_computer_ramp_{false}, c_computer_snap_{true};
         std::array<zldsp::compressor::RMSTracker<float>, 2> rms_tracker_{};
         std::array<zldsp::compressor::PSFollower<float>, 2> follower_{};
         std::array<zldsp::compressor::PSFollower<float>, 2> rms_follower_{};
@@ -290,10 +455,12 @@ namespace zlp {
             zldsp::compressor::CleanCompressor<float>{},
             zldsp::compressor::CleanCompressor<float>{}
         };
+        // the feedback styles convert between dB and gain per sample, fast conversions are accurate to 0.001 dB
+        static constexpr auto kFeedbackPrecision = zldsp::chore::fast_db::Precision::kMilliDecibel;
         // classic compressors
-        std::array<zldsp::compressor::ClassicCompressor<float>, 2> classic_comps_ = {
-            zldsp::compressor::ClassicCompressor<float>{},
-            zldsp::compressor::ClassicCompressor<float>{}
+        std::array<zldsp::compressor::ClassicCompressor<float, kFeedbackPrecision>, 2> classic_comps_ = {
+            zldsp::compressor::ClassicCompressor<float, kFeedbackPrecision>{},
+            zldsp::compressor::ClassicCompressor<float, kFeedbackPrecision>{}
         };
         // optical compressors
         std::array<zldsp::compressor::OpticalCompressor<float>, 2> optical_comps_ = {
@@ -301,13 +468,11 @@ namespace zlp {
             zldsp::compressor::OpticalCompressor<float>{}
         };
         // vocal compressors
-        std::array<zldsp::compressor::VocalCompressor<float>, 2> vocal_comps_ = {
-            zldsp::compressor::VocalCompressor<float>{},
-            zldsp::compressor::VocalCompressor<float>{}
+        std::array<zldsp::compressor::VocalCompressor<float, kFeedbackPrecision>, 2> vocal_comps_ = {
+            zldsp::compressor::VocalCompressor<float, kFeedbackPrecision>{},
+            zldsp::compressor::VocalCompressor<float, kFeedbackPrecision>{}
         };
         // rms compressors
-        zlchore::thread::Notifier to_update_follower_{true};
-        zlchore::thread::Notifier to_update_rms_{true};
         std::atomic<bool> use_rms_{false};
         bool c_use_rms_{false};
         std::atomic<float> rms_mix_{0.f};
@@ -320,43 +485,153 @@ namespace zlp {
             zldsp::compressor::CleanCompressor<float>{}
         };
         // hold
-        zlchore::thread::Notifier to_update_hold_{true};
         std::atomic<float> hold_length_{0.0};
         std::array<zldsp::container::CircularMinMaxBuffer<float, zldsp::container::kFindMin>, 2> hold_buffer_ = {
             zldsp::container::CircularMinMaxBuffer<float, zldsp::container::kFindMin>{},
             zldsp::container::CircularMinMaxBuffer<float, zldsp::container::kFindMin>{},
         };
         // range
-        zlchore::thread::Notifier to_update_range_{true};
         std::atomic<float> range_{80.f};
         float c_range_{80.f};
         std::atomic<bool> is_range_inf_{false};
         bool c_is_range_inf_{false};
+        // multiband, the bands are split by linkwitz-riley crossovers and each band takes one lane
+        // the detectors, followers and gains of all bands advance together, rms and hold are not applied
+        static constexpr size_t kMaxBandNum = kCompBandNum;
+        static constexpr size_t kBandChunkSize = kComputerSubBlockSize;
+        using BandTag = hn::CappedTag<float, kMaxBandNum>;
+        // the crossovers stop below the nyquist frequency of the host sample rate
+        static constexpr double kMaxCrossoverRatio = 0.45;
+        std::atomic<size_t> band_num_{1};
+        size_t c_band_num_{1};
+        std::array<std::atomic<float>, kMaxBandNum - 1> crossovers_{120.f, 1000.f, 6000.f};
+        std::array<std::atomic<float>, kMaxBandNum> band_trims_{0.f, 0.f, 0.f, 0.f};
+        alignas(16) std::array<float, kMaxBandNum> c_band_trims_{1.f, 1.f, 1.f, 1.f};
+        // streams: main0, main1, side0, side1
+        zldsp::splitter::LRSplitter<float, kMaxBandNum, 4> splitter_;
+        // a band number change fades from the previous bands with their last gains held
+        // which keeps the phase and the gain reduction continuous
+        zldsp::splitter::LRSplitter<float, kMaxBandNum, 4> fade_splitter_;
+        size_t band_fade_length_{1}, band_fade_remaining_{0};
+        zldsp::vector::aligned_vector<float> band_fade_buffer0_, band_fade_buffer1_;
+        // the gains on the bands of the last sample, a single band keeps its gain on band 0
+        alignas(16) std::array<std::array<float, kMaxBandNum>, 2> band_last_gains_{
+            std::array<float, kMaxBandNum>{1.f, 1.f, 1.f, 1.f}, std::array<float, kMaxBandNum>{1.f, 1.f, 1.f, 1.f}
+        };
+        alignas(16) std::array<std::array<float, kMaxBandNum>, 2> band_fade_gains_{band_last_gains_};
+        // the light bypass outputs the all-pass of the bands at the host sample rate, streams: main0, main1
+        zldsp::splitter::LRSplitter<float, kMaxBandNum, 2> bypass_splitter_;
+        // the bands of one chunk, interleaved as [sample][band]
+        alignas(64) std::array<std::array<float, kBandChunkSize * kMaxBandNum>, 2> band_main_{}, band_side_{};
+        std::array<std::array<zldsp::compressor::PSFollower<float>, kMaxBandNum>, 2> band_followers_{};
+        // the feedback samples of the classic and the vocal style
+        alignas(16) std::array<std::array<float, kMaxBandNum>, 2> band_x0_{};
         // clipper
         zldsp::compressor::TanhClipper<float> clipper_;
         // output gain
-        zlchore::thread::Notifier to_update_output_gain_{true};
         std::atomic<float> output_gain_db_{0.f};
         zldsp::gain::Gain<float> output_gain_{};
 
+        enum class EpilogueGain {
+            kNone, kConstant, kRamp
+        };
+
         void prepareBuffer();
 
+        void processResumeFade(std::array<float*, 2> main_pointers, size_t num_samples);
+
+        template <bool is_midside, bool copy_post, bool delta, EpilogueGain gain_mode>
+        void processEpilogue(float* __restrict main_buffer0, float* __restrict main_buffer1, size_t num_samples);
+
         void processBuffer(float* __restrict main_buffer0, float* __restrict main_buffer1,
                            float* __restrict side_buffer0, float* __restrict side_buffer1,
                            size_t num_samples, bool bypass);
 
-        template <bool stereo_swap>
-        void appleSideBuffer(float* __restrict main_buffer0, float* __restrict main_buffer1,
-                             float* __restrict side_buffer0, float* __restrict side_buffer1,
-                             size_t num_samples) const;
+        void applyComputerParas(const std::array<float, kComputerParaNum>& paras);
+
+        void stepComputerParas(size_t k, size_t num_sub_blocks);
+
+        void processMultiband(float* __restrict main_buffer0, float* __restrict main_buffer1,
+                              const float* __restrict side_buffer0, const float* __restrict side_buffer1,
+                              size_t num_samples, bool bypass);
+
+        void processBandFade(float* __restrict main_buffer0, float* __restrict main_buffer1, size_t num_samples);
+
+        template <bool link_max, bool stereo_swap>
+        void processBandSideKernel(float* __restrict main_buffer0, float* __restrict main_buffer1,
+                                   size_t num_samples);
+
+        template <bool use_rms, bool use_hold>
+        void dispatchSideKernel(float* __restrict main_buffer0, float* __restrict main_buffer1,
+                                float* __restrict side_buffer0, float* __restrict side_buffer1,
+                                size_t num_samples, bool bypass);
+
+        template <bool use_rms, bool use_hold, bool apply, bool link_max, bool stereo_swap>
+        void processSideKernel(float* __restrict main_buffer0, float* __restrict main_buffer1,
+                               const float* __restrict side_buffer0, const float* __restrict side_buffer1,
+                               size_t num_samples);
+
+        void updateDetectorKernel();
+
+        template <typename C, zldsp::compressor::Style style,
+                  zldsp::compressor::PPState pp_state, zldsp::compressor::SState s_state>
+        void processDetectorKernel(float* __restrict side_buffer0, float* __restrict side_buffer1,
+                                   float* __restrict rms_side_buffer0, float* __restrict rms_side_buffer1,
+                                   size_t num_samples);
+
+        /**
+         * process the bands of both channels
+         * @param band_side_buffer0 the bands of channel 0, interleaved as [sample][band]
+         * @param band_side_buffer1 the bands of channel 1, interleaved as [sample][band]
+         * @param num_samples the number of samples of each band
+         */
+        template <typename C, zldsp::compressor::Style style,
+                  zldsp::compressor::PPState pp_state, zldsp::compressor::SState s_state>
+        void processBandDetectorKernel(float* __restrict band_side_buffer0, float* __restrict band_side_buffer1,
+                                       size_t num_samples);
+
+        template <typename C, zldsp::compressor::Style style, bool multiband, size_t... idx>
+        static constexpr auto makeFollowerKernels(std::index_sequence<idx...>) {
+            if constexpr (multiband) {
+                return std::array<BandDetectorKernel, sizeof...(idx)>{
+                    &CompressController::processBandDetectorKernel<
+                        C, style, static_cast<zldsp::compressor::PPState>(idx / kSStateNum),
+                        static_cast<zldsp::compressor::SState>(idx % kSStateNum)>...
+                };
+            } else {
+                return std::array<DetectorKernel, sizeof...(idx)>{
+                    &CompressController::processDetectorKernel<
+                        C, style, static_cast<zldsp::compressor::PPState>(idx / kSStateNum),
+                        static_cast<zldsp::compressor::SState>(idx % kSStateNum)>...
+                };
+            }
+        }
+
+        /**
+         * @return the detector kernels of the computer C, indexed by [style][pp_state * kSStateNum + s_state]
+         */
+        template <typename C, bool multiband, zldsp::compressor::Style... styles>
+        static constexpr auto makeDetectorKernels() {
+            return std::array{
+                makeFollowerKernels<C, styles, multiband>(std::make_index_sequence<kPPStateNum * kSStateNum>{})...
+            };
+        }
 
+        /**
+         * prepare the computer C, the clipper follows the reduction at unit of the compression computer
+         */
         template <typename C>
-        void processSideBuffer(C& c,
-                               float* __restrict buffer0, float* __restrict buffer1, size_t num_samples);
+        C& prepareComputer();
+
+        template <typename C>
+        C& getComputer();
+
+        template <zldsp::compressor::Style style>
+        auto& getStyleComps();
 
-        template <typename C, typename Style>
-        void dispatchProcess(C& c, Style& comp0, Style& comp1,
-                             float* __restrict buffer0, float* __restrict buffer1, size_t num_samples);
+        template <typename C, typename Style, zldsp::compressor::PPState pp_state, zldsp::compressor::SState s_state>
+        void processStyle(C& c, Style& comp0, Style& comp1,
+                          float* __restrict buffer0, float* __restrict buffer1, size_t num_samples);
 
         template <typename C>
         void processSideBufferRMS(C& c,
@@ -18,52 +18,85 @@ namespace zlp {
           controller_ref_(controller) {
         juce::ignoreUnused(processor_ref_);
         for (size_t i = 0; i < kIDs.size(); ++i) {
-            parameters_ref_.addParameterListener(kIDs[i], this);
-            parameterChanged(kIDs[i], kDefaultVs[i]);
+            listeners_[i] = std::make_unique<juce_helper::ParaIdxListener<EqualizeAttach>>(*this, i);
+            parameters_ref_.addParameterListener(kIDs[i], listeners_[i].get());
+            parameterChanged(i, kDefaultVs[i]);
         }
         for (size_t band = 0; band < kBandNum; ++band) {
             const auto suffix = std::to_string(band);
             for (size_t i = 0; i < kBandIDs.size(); ++i) {
-                const auto temp_id = kBandIDs[i] + suffix;
-                parameters_ref_.addParameterListener(temp_id, this);
-                parameterChanged(temp_id, kBandDefaultVs[i]);
+                const auto idx = kIDs.size() + band * kBandIDs.size() + i;
+                listeners_[idx] = std::make_unique<juce_helper::ParaIdxListener<EqualizeAttach>>(*this, idx);
+                parameters_ref_.addParameterListener(kBandIDs[i] + suffix, listeners_[idx].get());
+                parameterChanged(idx, kBandDefaultVs[i]);
             }
         }
     }
 
     EqualizeAttach::~EqualizeAttach() {
-        for (auto &ID: kIDs) {
-            parameters_ref_.removeParameterListener(ID, this);
+        for (size_t i = 0; i < kIDs.size(); ++i) {
+            parameters_ref_.removeParameterListener(kIDs[i], listeners_[i].get());
         }
         for (size_t band = 0; band < kBandNum; ++band) {
             const auto suffix = std::to_string(band);
             for (size_t i = 0; i < kBandIDs.size(); ++i) {
-                const auto temp_id = kBandIDs[i] + suffix;
-                parameters_ref_.removeParameterListener(temp_id, this);
+                const auto idx = kIDs.size() + band * kBandIDs.size() + i;
+                parameters_ref_.removeParameterListener(kBandIDs[i] + suffix, listeners_[idx].get());
             }
         }
     }
 
-    void EqualizeAttach::parameterChanged(const juce::String &parameter_ID, const float new_value) {
-        const auto idx = static_cast<size_t>(parameter_ID.getTrailingIntValue());
-        if (parameter_ID == PSideGain::kID) {
-            controller_ref_.setGain(new_value);
-        } else if (parameter_ID == PSideEQBypass::kID) {
-            controller_ref_.setEQBypass(new_value > .5f);
-        } else if (parameter_ID.startsWith(PFilterStatus::kID)) {
-            controller_ref_.setFilterStatus(idx, static_cast<EqualizeController::FilterStatus>(new_value));
-        } else if (parameter_ID.startsWith(PFreq::kID)) {
-            controller_ref_.setFilterFreq(idx, static_cast<double>(new_value));
-        } else if (parameter_ID.startsWith(PGain::kID)) {
-            controller_ref_.setFilterGain(idx, static_cast<double>(new_value));
-        } else if (parameter_ID.startsWith(PQ::kID)) {
-            controller_ref_.setFilterQ(idx, static_cast<double>(new_value));
-        } else if (parameter_ID.startsWith(PFilterType::kID)) {
+    void EqualizeAttach::parameterChanged(const size_t idx, const float new_value) {
+        if (idx < kIDs.size()) {
+            switch (idx) {
+            case getIdx(kIDs, PSideGain::kID): {
+                controller_ref_.setGain(new_value);
+                break;
+            }
+            case getIdx(kIDs, PSideEQBypass::kID): {
+                controller_ref_.setEQBypass(new_value > .5f);
+                break;
+            }
+            case getIdx(kIDs, PSideEQStructure::kID): {
+                controller_ref_.setFilterStructure(
+                    static_cast<zldsp::filter::FilterStructure>(std::round(new_value)));
+                break;
+            }
+            default:
+                break;
+            }
+            return;
+        }
+        const auto band = (idx - kIDs.size()) / kBandIDs.size();
+        switch ((idx - kIDs.size()) % kBandIDs.size()) {
+        case getIdx(kBandIDs, PFilterStatus::kID): {
+            controller_ref_.setFilterStatus(band, static_cast<EqualizeController::FilterStatus>(new_value));
+            break;
+        }
+        case getIdx(kBandIDs, PFreq::kID): {
+            controller_ref_.setFilterFreq(band, static_cast<double>(new_value));
+            break;
+        }
+        case getIdx(kBandIDs, PGain::kID): {
+            controller_ref_.setFilterGain(band, static_cast<double>(new_value));
+            break;
+        }
+        case getIdx(kBandIDs, PQ::kID): {
+            controller_ref_.setFilterQ(band, static_cast<double>(new_value));
+            break;
+        }
+        case getIdx(kBandIDs, PFilterType::kID): {
             controller_ref_.setFilterType(
-                idx, static_cast<zldsp::filter::FilterType>(std::round(new_value)));
-        } else if (parameter_ID.startsWith(POrder::kID)) {
+                band, static_cast<zldsp::filter::FilterType>(std::round(new_value)));
+            break;
+        }
+        case getIdx(kBandIDs, POrder::kID): {
             controller_ref_.setFilterOrder(
-                idx, POrder::kOrderArray[static_cast<size_t>(std::round(new_value))]);
+                band, POrder::kOrderArray[static_cast<size_t>(std::round(new_value))]);
+            break;
+        }
+        default:
+            break;
         }
     }
 }
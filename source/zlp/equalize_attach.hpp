@@ -9,29 +9,35 @@
 
 #pragma once
 
+#include <string_view>
+
 #include "zlp_definitions.hpp"
 #include "equalize_controller.hpp"
+#include "juce_helper/para_idx_listener.hpp"
 
 namespace zlp {
-    class EqualizeAttach final : private juce::AudioProcessorValueTreeState::Listener {
+    class EqualizeAttach final {
     public:
         explicit EqualizeAttach(juce::AudioProcessor& processor,
                                 juce::AudioProcessorValueTreeState& parameters,
                                 EqualizeController& controller);
 
-        ~EqualizeAttach() override;
+        ~EqualizeAttach();
 
     private:
+        friend class juce_helper::ParaIdxListener<EqualizeAttach>;
+
         juce::AudioProcessor& processor_ref_;
         juce::AudioProcessorValueTreeState& parameters_ref_;
         EqualizeController& controller_ref_;
 
         constexpr static std::array kIDs{
-            PSideGain::kID, PSideEQBypass::kID
+            PSideGain::kID, PSideEQBypass::kID, PSideEQStructure::kID
         };
 
         constexpr static std::array kDefaultVs{
             PSideGain::kDefaultV, static_cast<float>(PSideEQBypass::kDefaultV),
+            static_cast<float>(PSideEQStructure::kDefaultI)
         };
 
         constexpr static std::array kBandIDs{
@@ -46,6 +52,21 @@ namespace zlp {
             PFreq::kDefaultV, PGain::kDefaultV, PQ::kDefaultV
         };
 
-        void parameterChanged(const juce::String& parameter_ID, float new_value) override;
+        static constexpr size_t kListenerNum = kIDs.size() + kBandIDs.size() * kBandNum;
+
+        // one listener per parameter, global parameters come first and then band parameters band by band
+        std::array<std::unique_ptr<juce_helper::ParaIdxListener<EqualizeAttach>>, kListenerNum> listeners_;
+
+        template <size_t N>
+        static constexpr size_t getIdx(const std::array<const char*, N>& IDs, const std::string_view parameter_ID) {
+            for (size_t i = 0; i < N; ++i) {
+                if (parameter_ID == IDs[i]) {
+                    return i;
+                }
+            }
+            return N;
+        }
+
+        void parameterChanged(size_t idx, float new_value);
     };
 }
@@ -10,11 +10,43 @@
 #include "equalize_controller.hpp"
 
 namespace zlp {
-    EqualizeController::EqualizeController() {
+    bool EqualizeController::isSummed(const zldsp::filter::FilterParameters& paras) {
+        switch (paras.filter_type) {
+        case zldsp::filter::kPeak:
+            // higher orders are band-shelf cascades, whose deviations are not band-passes
+            return paras.order == 2 && paras.gain > 0.0;
+        case zldsp::filter::kLowShelf:
+        case zldsp::filter::kHighShelf:
+        case zldsp::filter::kTiltShelf:
+        case zldsp::filter::kFlatTilt:
+        case zldsp::filter::kLowPass:
+        case zldsp::filter::kHighPass:
+        case zldsp::filter::kNotch:
+        case zldsp::filter::kBandPass:
+        case zldsp::filter::kAllPass:
+        default:
+            return false;
+        }
+    }
+
+    EqualizeController::EqualizeController() :
+        Thread("side_eq_designer") {
         on_indices_.reserve(kBandNum);
+        serial_indices_.reserve(kBandNum);
+        parallel_indices_.reserve(kBandNum);
+    }
+
+    EqualizeController::~EqualizeController() {
+        cancelPendingUpdate();
+        if (isThreadRunning()) {
+            stopThread(-1);
+        }
     }
 
     void EqualizeController::prepare(const double sample_rate, const size_t max_num_samples) {
+        // outside the lock, since stopping the thread waits for the running design
+        updateDesignThread();
+        const std::lock_guard<std::mutex> lock{design_mutex_};
         max_freq_ = getEQFreqMax(sample_rate);
         fft_analyzer_sender_.prepare(sample_rate, max_num_samples, {2}, 0.1);
         fft_analyzer_sender_.setON(0, true);
@@ -23,31 +55,49 @@ namespace zlp {
             filter_paras_[i].freq = std::min(filter_paras_[i].freq, max_freq_);
             filters_[i].prepare(sample_rate, 2, max_num_samples);
             filters_[i].updateParas(filter_paras_[i]);
+            svf_filters_[i].prepare(sample_rate, 2, max_num_samples);
+            svf_filters_[i].updateParas(filter_paras_[i]);
         }
+        parallel_filter_.prepare(sample_rate, 2);
+        for (size_t i = 0; i < kBandNum; ++i) {
+            parallel_filter_.updateParas(i, filter_paras_[i]);
+        }
+        updateIndices();
         gain_.prepare(sample_rate, max_num_samples, 0.01);
         for (size_t chan = 0; chan < 2; chan++) {
             solo_buffers_[chan].resize(max_num_samples);
             solo_pointers_[chan] = solo_buffers_[chan].data();
         }
         solo_filter_.prepare(sample_rate, 2, max_num_samples);
+        // start from a pure delay, the IR of the bands follows from the background thread
+        linear_phase_.prepare(sample_rate, 2);
+        const auto latency = linear_phase_.getLatency();
+        linear_phase_latency_.store(static_cast<int>(latency), std::memory_order::relaxed);
+        solo_delay_.prepare(sample_rate, max_num_samples, 2, static_cast<double>(latency) / sample_rate);
+        solo_delay_.setDelayInSamples(static_cast<int>(latency));
+        solo_delay_.reset();
+        if (filter_structure_.load(std::memory_order::relaxed) == zldsp::filter::kLinearPhase) {
+            requestDesign();
+        }
     }
 
     void EqualizeController::prepareBuffer() {
-        if (!to_update_.check()) {
+        const auto flags = update_flags_.take();
+        if (flags == 0) {
             return;
         }
-        if (to_update_gain_.check()) {
+        if (flags & kUpdateGain) {
             const auto c_gain_db = gain_db_.load(std::memory_order::relaxed);
             gain_.setGainDecibels(c_gain_db);
             c_gain_equal_zero_ = std::abs(c_gain_db) < 1e-3;
         }
-        if (to_update_filter_status_.check()) {
+        if (flags & kUpdateFilterStatus) {
             // cache new filter status
             for (size_t i = 0; i < kBandNum; ++i) {
                 const auto new_filter_status = filter_status_[i].load(std::memory_order::relaxed);
                 if (new_filter_status != c_filter_status_[i]) {
                     if (c_filter_status_[i] == FilterStatus::kOff) {
-                        filters_[i].reset();
+                        resetBand(i);
                     }
                     c_filter_status_[i] = new_filter_status;
                 }
@@ -60,64 +110,199 @@ namespace zlp {
                 }
             }
         }
+        if (flags & kUpdateStructure) {
+            const auto new_structure = filter_structure_.load(std::memory_order::relaxed);
+            if (new_structure != c_filter_structure_) {
+                c_filter_structure_ = new_structure;
+                // the new structure starts from the current parameters without smoothing
+                for (size_t i = 0; i < kBandNum; ++i) {
+                    updateBand(i, true);
+                }
+                if (c_filter_structure_ == zldsp::filter::kLinearPhase) {
+                    linear_phase_.reset();
+                    solo_delay_.reset();
+                }
+            }
+        }
         c_fft_analyzer_on_ = fft_analyzer_on_.load(std::memory_order::relaxed);
-        if (to_update_solo_.check()) {
+        if (flags & kUpdateSolo) {
             c_solo_band_ = solo_band_.load(std::memory_order::relaxed);
             c_solo_on_ = c_solo_band_ < kBandNum;
             if (c_solo_on_) {
                 solo_filter_.reset();
+                solo_delay_.reset();
                 updateSoloFilter(filter_paras_[c_solo_band_], true);
             }
         }
+        c_pending_band_flags_ |= flags >> kUpdateBandShift;
+        bool to_update_indices = (flags & (kUpdateFilterStatus | kUpdateStructure)) != 0;
         for (const auto& i : on_indices_) {
-            if (empty_update_flags_[i].check()) {
+            if (c_pending_band_flags_ & (uint32_t(1) << i)) {
+                c_pending_band_flags_ &= ~(uint32_t(1) << i);
                 filter_paras_[i] = empty_filters_[i].getParas();
                 filter_paras_[i].freq = std::min(filter_paras_[i].freq, max_freq_);
-                filters_[i].updateParas(filter_paras_[i]);
+                updateBand(i, false);
+                to_update_indices = true;
                 if (i == c_solo_band_ && c_solo_on_) {
                     updateSoloFilter(filter_paras_[i], false);
                 }
             }
         }
+        if (to_update_indices) {
+            updateIndices();
+        }
         eq_bypass_ = a_eq_bypass_.load(std::memory_order::relaxed);
+        // the IR holds all bands and the bypass, redesign it if any of them has changed
+        if (c_filter_structure_ == zldsp::filter::kLinearPhase
+            && ((flags & (kUpdateFilterStatus | kUpdateSwitch | kUpdateStructure)) != 0
+                || (flags >> kUpdateBandShift) != 0)) {
+            requestDesign();
+        }
     }
 
-    void EqualizeController::process(std::array<double*, 2> pointers, const size_t num_samples) {
-        prepareBuffer();
-        if (!c_gain_equal_zero_) {
-            if (eq_bypass_) {
-                gain_.template process<true>(pointers, num_samples);
+    void EqualizeController::updateBand(const size_t idx, const bool force) {
+        const auto& paras{filter_paras_[idx]};
+        switch (c_filter_structure_) {
+        case zldsp::filter::kIIR: {
+            if (force) {
+                filters_[idx].forceUpdate(paras);
+                filters_[idx].reset();
             } else {
-                gain_.template process<false>(pointers, num_samples);
+                filters_[idx].updateParas(paras);
             }
+            break;
         }
-        if (c_solo_on_) {
-            zldsp::vector::copy(solo_pointers_[0], pointers[0], num_samples);
-            zldsp::vector::copy(solo_pointers_[1], pointers[1], num_samples);
-            solo_filter_.template process<false>(solo_pointers_, num_samples);
+        case zldsp::filter::kSVF: {
+            if (force) {
+                svf_filters_[idx].forceUpdate(paras);
+                svf_filters_[idx].reset();
+            } else {
+                svf_filters_[idx].updateParas(paras);
+            }
+            break;
+        }
+        case zldsp::filter::kParallel: {
+            // keep both sides in sync, since a type change can move the band between them
+            if (force) {
+                filters_[idx].forceUpdate(paras);
+                filters_[idx].reset();
+                parallel_filter_.forceUpdate(idx, paras);
+            } else {
+                filters_[idx].updateParas(paras);
+                parallel_filter_.updateParas(idx, paras);
+            }
+            break;
+        }
+        case zldsp::filter::kLinearPhase: {
+            break;
+        }
+        }
+    }
+
+    void EqualizeController::resetBand(const size_t idx) {
+        switch (c_filter_structure_) {
+        case zldsp::filter::kIIR: {
+            filters_[idx].reset();
+            break;
+        }
+        case zldsp::filter::kSVF: {
+            svf_filters_[idx].reset();
+            break;
+        }
+        case zldsp::filter::kParallel: {
+            filters_[idx].reset();
+            parallel_filter_.resetBand(idx);
+            break;
+        }
+        case zldsp::filter::kLinearPhase: {
+            break;
+        }
+        }
+    }
+
+    void EqualizeController::updateIndices() {
+        serial_indices_.clear();
+        parallel_indices_.clear();
+        if (c_filter_structure_ == zldsp::filter::kLinearPhase) {
+            parallel_filter_.setBands(parallel_indices_);
+            return;
         }
         for (const auto& i : on_indices_) {
+            if (c_filter_structure_ == zldsp::filter::kParallel && isSummed(filter_paras_[i])) {
+                parallel_indices_.emplace_back(i);
+                parallel_filter_.setBypass(i, c_filter_status_[i] == kBypass);
+            } else {
+                serial_indices_.emplace_back(i);
+            }
+        }
+        parallel_filter_.setBands(parallel_indices_);
+    }
+
+    template <typename Filter>
+    void EqualizeController::processSerial(std::array<Filter, kBandNum>& filters, std::array<double*, 2> pointers,
+                                           const size_t num_samples) {
+        for (const auto& i : serial_indices_) {
             switch (c_filter_status_[i]) {
             case kOff: {
                 break;
             }
             case kBypass: {
-                filters_[i].template process<true>(pointers, num_samples);
+                filters[i].template process<true>(pointers, num_samples);
                 break;
             }
             case kOn: {
                 if (eq_bypass_) {
-                    filters_[i].template process<true>(pointers, num_samples);
+                    filters[i].template process<true>(pointers, num_samples);
                 } else {
-                    filters_[i].template process<false>(pointers, num_samples);
+                    filters[i].template process<false>(pointers, num_samples);
                 }
                 break;
             }
             }
         }
+    }
+
+    void EqualizeController::process(std::array<double*, 2> pointers, const size_t num_samples) {
+        profiler_.startBlock();
+        prepareBuffer();
+        profiler_.lap(kStagePrepare);
+        if (!c_gain_equal_zero_) {
+            if (eq_bypass_) {
+                gain_.template process<true>(pointers, num_samples);
+            } else {
+                gain_.template process<false>(pointers, num_samples);
+            }
+        }
+        profiler_.lap(kStageGain);
+        if (c_solo_on_) {
+            zldsp::vector::copy(solo_pointers_[0], pointers[0], num_samples);
+            zldsp::vector::copy(solo_pointers_[1], pointers[1], num_samples);
+            solo_filter_.template process<false>(solo_pointers_, num_samples);
+            if (c_filter_structure_ == zldsp::filter::kLinearPhase) {
+                solo_delay_.process(std::span<double*>(solo_pointers_), num_samples);
+            }
+        }
+        profiler_.lap(kStageSolo);
+        if (c_filter_structure_ == zldsp::filter::kLinearPhase) {
+            linear_phase_.process(std::span<double*>(pointers), num_samples);
+        } else if (c_filter_structure_ == zldsp::filter::kSVF) {
+            processSerial(svf_filters_, pointers, num_samples);
+        } else {
+            processSerial(filters_, pointers, num_samples);
+        }
+        if (!parallel_indices_.empty()) {
+            if (eq_bypass_) {
+                parallel_filter_.template process<true>(pointers, num_samples);
+            } else {
+                parallel_filter_.template process<false>(pointers, num_samples);
+            }
+        }
+        profiler_.lap(kStageFilter);
         if (c_fft_analyzer_on_) {
             fft_analyzer_sender_.process({pointers}, num_samples);
         }
+        profiler_.lap(kStageAnalyzer);
+        profiler_.finishBlock();
     }
 
     void EqualizeController::updateSoloFilter(const zldsp::filter::FilterParameters& target, const bool force) {
@@ -155,4 +340,58 @@ namespace zlp {
             solo_filter_.updateParas(solo_paras);
         }
     }
+
+    void EqualizeController::requestDesign() {
+        to_design_.signal();
+        notify();
+    }
+
+    void EqualizeController::run() {
+        juce::ScopedNoDenormals no_denormals;
+        while (!threadShouldExit()) {
+            if (!to_design_.check()) {
+                wait(-1);
+                continue;
+            }
+            bool is_designed;
+            {
+                const std::lock_guard<std::mutex> lock{design_mutex_};
+                is_designed = designLinearPhase();
+            }
+            if (!is_designed) {
+                // the audio thread has not picked up the last IR, try again later
+                to_design_.signal();
+                wait(kDesignRetryMs);
+            }
+        }
+    }
+
+    bool EqualizeController::designLinearPhase() {
+        std::array<zldsp::filter::FilterParameters, kBandNum> paras{};
+        size_t num_paras = 0;
+        if (!a_eq_bypass_.load(std::memory_order::relaxed)) {
+            for (size_t i = 0; i < kBandNum; ++i) {
+                if (filter_status_[i].load(std::memory_order::relaxed) == kOn) {
+                    paras[num_paras] = empty_filters_[i].getParas();
+                    paras[num_paras].freq = std::min(paras[num_paras].freq, max_freq_);
+                    num_paras += 1;
+                }
+            }
+        }
+        return linear_phase_.updateIR(std::span{paras.data(), num_paras});
+    }
+
+    void EqualizeController::updateDesignThread() {
+        const auto is_linear_phase =
+            filter_structure_.load(std::memory_order::relaxed) == zldsp::filter::kLinearPhase;
+        if (is_linear_phase && !isThreadRunning()) {
+            startThread(juce::Thread::Priority::low);
+        } else if (!is_linear_phase && isThreadRunning()) {
+            stopThread(-1);
+        }
+    }
+
+    void EqualizeController::handleAsyncUpdate() {
+        updateDesignThread();
+    }
 }
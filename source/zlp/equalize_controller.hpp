@@ -9,70 +9,78 @@
 
 #pragma once
 
+#include "../chore/profile/stage_profiler.hpp"
+#include "../chore/thread/dirty_mask.hpp"
 #include "../chore/thread/notifier.hpp"
 #include "../dsp/filter/empty_filter/empty.hpp"
 #include "../dsp/filter/filter.hpp"
 #include "../dsp/analyzer/analyzer_base/analyzer_sender_base.hpp"
 #include "../dsp/gain/gain.hpp"
+#include "../dsp/delay/delay.hpp"
 #include "zlp_definitions.hpp"
 
+#include <mutex>
 #include <juce_audio_processors/juce_audio_processors.h>
 
 namespace zlp {
-    class EqualizeController {
+    class EqualizeController final : private juce::Thread, private juce::AsyncUpdater {
     public:
         static constexpr size_t kAnalyzerPointNum = 100;
 
+        // stages of the timing probes
+        enum ProfileStage : size_t {
+            kStagePrepare, kStageGain, kStageSolo, kStageFilter, kStageAnalyzer, kStageNum
+        };
+
+        static constexpr std::array<const char*, kStageNum> kStageNames{
+            "prepare", "gain", "solo", "filter", "analyzer"
+        };
+
         enum FilterStatus {
             kOff, kBypass, kOn
         };
 
         explicit EqualizeController();
 
+        ~EqualizeController() override;
+
         void prepare(double sample_rate, size_t max_num_samples);
 
         void process(std::array<double*, 2> pointers, size_t num_samples);
 
         void setFilterStatus(const size_t filter_idx, const FilterStatus filter_status) {
             filter_status_[filter_idx].store(filter_status, std::memory_order::relaxed);
-            to_update_filter_status_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateFilterStatus);
         }
 
         void setGain(const float db) {
             gain_db_.store(static_cast<double>(db), std::memory_order::relaxed);
-            to_update_gain_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateGain);
         }
 
         void setFilterFreq(const size_t idx, const double freq) {
             empty_filters_[idx].setFreq(freq);
-            empty_update_flags_[idx].signal();
-            to_update_.signal();
+            update_flags_.signal(getBandFlag(idx));
         }
 
         void setFilterGain(const size_t idx, const double gain) {
             empty_filters_[idx].setGain(gain);
-            empty_update_flags_[idx].signal();
-            to_update_.signal();
+            update_flags_.signal(getBandFlag(idx));
         }
 
         void setFilterQ(const size_t idx, const double q) {
             empty_filters_[idx].setQ(q);
-            empty_update_flags_[idx].signal();
-            to_update_.signal();
+            update_flags_.signal(getBandFlag(idx));
         }
 
         void setFilterType(const size_t idx, const zldsp::filter::FilterType type) {
             empty_filters_[idx].setFilterType(type);
-            empty_update_flags_[idx].signal();
-            to_update_.signal();
+            update_flags_.signal(getBandFlag(idx));
         }
 
         void setFilterOrder(const size_t idx, const size_t order) {
             empty_filters_[idx].setOrder(order);
-            empty_update_flags_[idx].signal();
-            to_update_.signal();
+            update_flags_.signal(getBandFlag(idx));
         }
 
         zldsp::filter::FilterType getFilterType(const size_t idx) const {
@@ -89,7 +97,7 @@ namespace zlp {
 
         void setFFTAnalyzerON(const bool f) {
             fft_analyzer_on_.store(f, std::memory_order::relaxed);
-            to_update_.signal();
+            update_flags_.signal(kUpdateSwitch);
         }
 
         [[nodiscard]] bool getFFTAnalyzerON() const {
@@ -98,8 +106,7 @@ namespace zlp {
 
         void setSoloBand(const size_t solo_band) {
             solo_band_.store(solo_band, std::memory_order::relaxed);
-            to_update_solo_.signal();
-            to_update_.signal();
+            update_flags_.signal(kUpdateSolo);
         }
 
         size_t getSoloBand() const {
@@ -116,22 +123,93 @@ namespace zlp {
 
         void setEQBypass(const bool bypass) {
             a_eq_bypass_.store(bypass, std::memory_order::relaxed);
-            to_update_.signal();
+            update_flags_.signal(kUpdateSwitch);
+        }
+
+        /**
+         * set the filter structure of all bands
+         * kIIR and kSVF run the bands in series
+         * kParallel sums the 2nd-order peak boosts and runs the other bands in series
+         * kLinearPhase convolves with an IR of all bands, which is designed on a background thread
+         * the background thread only runs while kLinearPhase is selected, it is started/stopped on the message thread
+         * @param structure
+         */
+        void setFilterStructure(const zldsp::filter::FilterStructure structure) {
+            filter_structure_.store(structure, std::memory_order::relaxed);
+            update_flags_.signal(kUpdateStructure);
+            triggerAsyncUpdate();
         }
 
+        [[nodiscard]] zldsp::filter::FilterStructure getFilterStructure() const {
+            return filter_structure_.load(std::memory_order::relaxed);
+        }
+
+        /**
+         * thread-safe method
+         * @return the latency of the current filter structure in samples
+         */
+        [[nodiscard]] int getLatency() const {
+            return filter_structure_.load(std::memory_order::relaxed) == zldsp::filter::kLinearPhase
+                       ? linear_phase_latency_.load(std::memory_order::relaxed)
+                       : 0;
+        }
+
+        auto& getProfiler() { return profiler_; }
+
+        /**
+         * whether the parallel structure sums the band, only 2nd-order peak boosts are summed
+         * the summed response is 1 + sum of (H_i - 1), each H_i - 1 of such a peak is a band-pass with a
+         * non-negative real part, so the sum never drops below unity gain however the bands overlap
+         * overlapping cuts would cancel and flip the polarity, and shelves can notch each other, so they run in series
+         * @param paras the band parameters
+         */
+        static bool isSummed(const zldsp::filter::FilterParameters& paras);
+
     private:
-        zlchore::thread::Notifier to_update_{true};
-        zlchore::thread::Notifier to_update_gain_{true};
+        // parameter update flags, raised by setters and taken once per block by the audio thread
+        // the lowest bits are global flags, followed by one bit per band
+        enum UpdateFlag : uint32_t {
+            kUpdateGain = 1 << 0,
+            kUpdateFilterStatus = 1 << 1,
+            kUpdateSolo = 1 << 2,
+            kUpdateSwitch = 1 << 3,
+            kUpdateStructure = 1 << 4,
+            kUpdateBandShift = 5
+        };
+
+        static_assert(kUpdateBandShift + kBandNum <= 32);
+
+        static constexpr uint32_t getBandFlag(const size_t idx) {
+            return uint32_t(1) << (kUpdateBandShift + idx);
+        }
+
+        zlchore::thread::DirtyMask update_flags_{kUpdateGain | kUpdateFilterStatus | kUpdateSwitch};
+        // per-stage timing probes, compiled out unless ZL_DSP_PROFILE is on
+        zlchore::profile::StageProfiler<kStageNum> profiler_;
+        // band flags which have been taken but not handled since the band is off
+        uint32_t c_pending_band_flags_{0};
         std::atomic<double> gain_db_{0.f};
         zldsp::gain::Gain<double> gain_{};
         bool c_gain_equal_zero_{true};
 
+        std::atomic<zldsp::filter::FilterStructure> filter_structure_{zldsp::filter::kIIR};
+        zldsp::filter::FilterStructure c_filter_structure_{zldsp::filter::kIIR};
         std::array<zldsp::filter::TDF<double, 16>, kBandNum> filters_{};
+        std::array<zldsp::filter::SVF<double, 16>, kBandNum> svf_filters_{};
+        zldsp::filter::Parallel<double, kBandNum, 16> parallel_filter_{};
+        // the linear-phase IR is designed on the background thread, which sleeps until a design is requested
+        // if the audio thread has not picked up the last IR yet, the design is retried after a short wait
+        static constexpr int kDesignRetryMs = 10;
+        zldsp::filter::LinearPhase<16> linear_phase_{};
+        std::atomic<int> linear_phase_latency_{0};
+        zlchore::thread::Notifier to_design_{};
+        // held by the background thread while designing and by prepare
+        std::mutex design_mutex_;
+        // on bands which are processed in series, and those summed by the parallel filter
+        std::vector<size_t> serial_indices_{}, parallel_indices_{};
         std::array<zldsp::filter::Empty, kBandNum> empty_filters_{};
-        std::array<zlchore::thread::Notifier, kBandNum> empty_update_flags_{};
         std::array<zldsp::filter::FilterParameters, kBandNum> filter_paras_{};
         double max_freq_{getEQFreqMax(48000.0)};
-        zlchore::thread::Notifier to_update_filter_status_{true};
         std::array<std::atomic<FilterStatus>, kBandNum> filter_status_;
         std::array<FilterStatus, kBandNum> c_filter_status_{};
         std::vector<size_t> on_indices_{};
@@ -142,17 +220,38 @@ namespace zlp {
 
         zldsp::filter::TDF<double, 16> solo_filter_{};
         std::atomic<size_t> solo_band_{kBandNum};
-        zlchore::thread::Notifier to_update_solo_{false};
         size_t c_solo_band_{kBandNum};
         bool c_solo_on_{false};
         std::array<std::vector<double>, 2> solo_buffers_;
         std::array<double*, 2> solo_pointers_{};
+        // the solo signal bypasses the linear-phase filter, delay it to keep it aligned with the side-chain
+        zldsp::delay::IntegerDelay<double> solo_delay_{};
 
         std::atomic<bool> a_eq_bypass_{false};
         bool eq_bypass_{false};
 
         void prepareBuffer();
 
+        void updateBand(size_t idx, bool force);
+
+        void resetBand(size_t idx);
+
+        void updateIndices();
+
+        template <typename Filter>
+        void processSerial(std::array<Filter, kBandNum>& filters, std::array<double*, 2> pointers,
+                           size_t num_samples);
+
         void updateSoloFilter(const zldsp::filter::FilterParameters& target, bool force);
+
+        void requestDesign();
+
+        void run() override;
+
+        bool designLinearPhase();
+
+        void updateDesignThread();
+
+        void handleAsyncUpdate() override;
     };
 }
@@ -0,0 +1,35 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+namespace zlp::juce_helper {
+    /**
+     * a parameter listener which forwards the change with an index resolved at construction
+     * so that the attachment can dispatch without comparing parameter IDs
+     * @tparam Attach the attachment class, which should provide parameterChanged(size_t, float)
+     */
+    template <typename Attach>
+    class ParaIdxListener final : public juce::AudioProcessorValueTreeState::Listener {
+    public:
+        ParaIdxListener(Attach& attach, const size_t idx)
+            : attach_ref_(attach), idx_(idx) {
+        }
+
+        void parameterChanged(const juce::String&, const float value) override {
+            attach_ref_.parameterChanged(idx_, value);
+        }
+
+    private:
+        Attach& attach_ref_;
+        size_t idx_;
+    };
+}
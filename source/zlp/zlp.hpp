@@ -11,6 +11,7 @@
 
 #include "zlp_definitions.hpp"
 #include "juce_helper/para_updater.hpp"
+#include "juce_helper/para_idx_listener.hpp"
 #include "compress_controller.hpp"
 #include "compress_attach.hpp"
 #include "equalize_controller.hpp"
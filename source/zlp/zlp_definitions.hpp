@@ -21,6 +21,7 @@ namespace zlp {
     inline static constexpr int kVersionHint = 1;
 
     inline static constexpr size_t kBandNum = 8;
+    inline static constexpr size_t kCompBandNum = 4;
     inline static constexpr float kEQMinFreq = 10.f;
     inline static constexpr float kEQMaxFreq = 160000.f;
 
@@ -400,6 +401,16 @@ namespace zlp {
         auto static constexpr kDefaultV = false;
     };
 
+    class PSideEQStructure : public ChoiceParameters<PSideEQStructure> {
+    public:
+        auto static constexpr kID = "side_eq_structure";
+        auto static constexpr kName = "Side EQ Structure";
+        inline auto static const kChoices = juce::StringArray{
+            "IIR", "SVF", "Parallel", "Linear Phase"
+        };
+        int static constexpr kDefaultI = 0;
+    };
+
     class PSideGain : public FloatParameters<PSideGain> {
     public:
         auto static constexpr kID = "side gain";
@@ -546,6 +557,40 @@ namespace zlp {
         auto static constexpr kDefaultV = 50.f;
     };
 
+    class PMultiBand : public ChoiceParameters<PMultiBand> {
+    public:
+        auto static constexpr kID = "multiband";
+        auto static constexpr kName = "Multiband";
+        inline auto static const kChoices = juce::StringArray{
+            "Off", "2 Bands", "3 Bands", "4 Bands"
+        };
+        int static constexpr kDefaultI = 0;
+    };
+
+    class PCrossover : public FloatParameters<PCrossover> {
+    public:
+        auto static constexpr kID = "crossover";
+        auto static constexpr kName = "Crossover";
+        inline auto static const kRange = getLogMidRange(20.f, 20000.f, 1000.f, 0.1f);
+        auto static constexpr kDefaultV = 1000.f;
+        static constexpr std::array<float, kCompBandNum - 1> kDefaultVs{120.f, 1000.f, 6000.f};
+
+        static std::unique_ptr<juce::AudioParameterFloat> get(const size_t idx) {
+            const auto suffix = std::to_string(idx);
+            auto attributes = juce::AudioParameterFloatAttributes().withAutomatable(true).withLabel(kName);
+            return std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(kID + suffix, kVersionHint),
+                                                               kName + suffix, kRange, kDefaultVs[idx], attributes);
+        }
+    };
+
+    class PBandTrim : public FloatParameters<PBandTrim> {
+    public:
+        auto static constexpr kID = "band_trim";
+        auto static constexpr kName = "Band Trim";
+        inline auto static const kRange = juce::NormalisableRange<float>(-30.f, 30.f, .01f);
+        auto static constexpr kDefaultV = 0.f;
+    };
+
     class PFilterStatus : public ChoiceParameters<PFilterStatus> {
     public:
         auto static constexpr kID = "filter_status";
@@ -610,14 +655,20 @@ namespace zlp {
                    PAttack::get(), PRelease::get(), PPump::get(), PSmooth::get(),
                    PHold::get(), PRange::get(), PWet::get(), POutGain::get(),
                    PExtSide::get(), PSideOut::get(),
-                   PSideGain::get(), PSideEQBypass::get(),
+                   PSideGain::get(), PSideEQBypass::get(), PSideEQStructure::get(),
                    PSideStereoMode::get(), PSideStereoSwap::get(),
                    PSideStereoLink::get(), PSideStereoWet1::get(), PSideStereoWet2::get(),
                    PCompON::get(), PCompDelta::get(),
                    PClipperDrive::get(),
                    POversample::get(), PLookAhead::get(),
                    PRMSON::get(), PRMSLength::get(), PRMSSpeed::get(), PRMSMix::get(),
-                   PRangeINF::get());
+                   PRangeINF::get(), PMultiBand::get());
+        for (size_t i = 0; i + 1 < kCompBandNum; ++i) {
+            layout.add(PCrossover::get(i));
+        }
+        for (size_t i = 0; i < kCompBandNum; ++i) {
+            layout.add(PBandTrim::get(std::to_string(i)));
+        }
         for (size_t i = 0; i < kBandNum; ++i) {
             const auto suffix = std::to_string(i);
             layout.add(PFilterStatus::get(suffix), PFilterType::get(suffix), POrder::get(suffix),
@@ -0,0 +1,143 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "dsp/compressor/compressor.hpp"
+
+namespace {
+    namespace hn = hwy::HWY_NAMESPACE;
+    using namespace zldsp::compressor;
+
+    constexpr size_t kLaneNum = 4;
+    using LaneTag = hn::CappedTag<float, kLaneNum>;
+    constexpr auto kPrecision = zldsp::chore::fast_db::Precision::kMilliDecibel;
+    constexpr size_t kNumSamples = 2000;
+    // the chunk size of the multiband compressor, the lanes have to carry the states across the chunks
+    constexpr size_t kChunkSize = 32;
+    constexpr float kMaxError = 1e-4f;
+
+    void prepareComputer(CompressionComputer<float, true>& computer) {
+        computer.setThreshold(-20.f);
+        computer.setRatio(4.f);
+        computer.setKneeW(3.f);
+        computer.prepareBuffer();
+    }
+
+    void prepareFollowers(std::array<PSFollower<float>, kLaneNum>& followers) {
+        for (auto& f : followers) {
+            f.prepare(48000.0);
+            f.setAttack(5.f);
+            f.setRelease(50.f);
+            f.setPumpPunch(.5f);
+            f.setSmooth(.5f);
+            f.prepareBuffer();
+        }
+    }
+
+    /**
+     * get some noise with a different level on each lane, so that the lanes compress differently
+     */
+    std::array<std::vector<float>, kLaneNum> getInputs() {
+        std::mt19937 gen{42};
+        std::uniform_real_distribution<float> dist{-1.f, 1.f};
+        std::array<std::vector<float>, kLaneNum> inputs;
+        for (size_t lane = 0; lane < kLaneNum; ++lane) {
+            inputs[lane].resize(kNumSamples);
+            for (auto& x : inputs[lane]) {
+                x = dist(gen) * (.1f + .3f * static_cast<float>(lane));
+            }
+        }
+        return inputs;
+    }
+
+    /**
+     * run the scalar style on each lane and the lane kernel on all lanes, return the max difference
+     * @tparam has_feedback whether the style keeps the feedback samples outside of the followers
+     */
+    template <typename Comp, bool has_feedback, PPState pp_state, SState s_state>
+    float getLaneError() {
+        CompressionComputer<float, true> computer;
+        prepareComputer(computer);
+        std::array<PSFollower<float>, kLaneNum> followers, lane_followers;
+        prepareFollowers(followers);
+        prepareFollowers(lane_followers);
+        auto expected = getInputs();
+        const auto inputs = expected;
+
+        std::array<Comp, kLaneNum> comps{};
+        for (size_t lane = 0; lane < kLaneNum; ++lane) {
+            comps[lane].template process<decltype(computer), PSFollower<float>, pp_state, s_state>(
+                computer, followers[lane], expected[lane].data(), kNumSamples);
+        }
+
+        std::vector<float> interleaved(kNumSamples * kLaneNum);
+        for (size_t i = 0; i < kNumSamples; ++i) {
+            for (size_t lane = 0; lane < kLaneNum; ++lane) {
+                interleaved[i * kLaneNum + lane] = inputs[lane][i];
+            }
+        }
+        const std::array pointers{&lane_followers[0], &lane_followers[1], &lane_followers[2], &lane_followers[3]};
+        PSFollowerLanes<LaneTag> lanes{pointers};
+        auto v_x0 = hn::Zero(LaneTag{});
+        for (size_t start_idx = 0; start_idx < kNumSamples; start_idx += kChunkSize) {
+            const auto chunk = std::min(kChunkSize, kNumSamples - start_idx);
+            auto* buffer = interleaved.data() + start_idx * kLaneNum;
+            if constexpr (has_feedback) {
+                Comp::template processLanes<decltype(computer), LaneTag, pp_state, s_state>(
+                    computer, lanes, v_x0, buffer, chunk);
+            } else {
+                Comp::template processLanes<decltype(computer), LaneTag, pp_state, s_state>(
+                    computer, lanes, buffer, chunk);
+            }
+        }
+
+        float max_error = 0.f;
+        for (size_t i = 0; i < kNumSamples; ++i) {
+            for (size_t lane = 0; lane < kLaneNum; ++lane) {
+                max_error = std::max(max_error, std::abs(interleaved[i * kLaneNum + lane] - expected[lane][i]));
+            }
+        }
+        return max_error;
+    }
+
+    template <typename Comp, bool has_feedback>
+    void checkLanes() {
+        SECTION("default") {
+            CHECK(getLaneError<Comp, has_feedback, PPState::kOff, SState::kOff>() < kMaxError);
+        }
+        SECTION("punch, full smooth") {
+            CHECK(getLaneError<Comp, has_feedback, PPState::kPunch, SState::kFull>() < kMaxError);
+        }
+        SECTION("pump, mixed smooth") {
+            CHECK(getLaneError<Comp, has_feedback, PPState::kPump, SState::kMix>() < kMaxError);
+        }
+    }
+}
+
+TEST_CASE("clean lane kernel matches the scalar kernel", "[compressor]") {
+    checkLanes<CleanCompressor<float>, false>();
+}
+
+TEST_CASE("optical lane kernel matches the scalar kernel", "[compressor]") {
+    checkLanes<OpticalCompressor<float>, false>();
+}
+
+TEST_CASE("classic lane kernel matches the scalar kernel", "[compressor]") {
+    checkLanes<ClassicCompressor<float, kPrecision>, true>();
+}
+
+TEST_CASE("vocal lane kernel matches the scalar kernel", "[compressor]") {
+    checkLanes<VocalCompressor<float, kPrecision>, true>();
+}
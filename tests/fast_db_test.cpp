@@ -0,0 +1,158 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "dsp/chore/fast_db.hpp"
+
+namespace {
+    namespace hn = hwy::HWY_NAMESPACE;
+    using zldsp::chore::fast_db::Precision;
+
+    // the documented range covers every level the plugin meters or computes, i.e., -160 dB to +60 dB
+    constexpr double kMinDecibels = -160.0;
+    constexpr double kMaxDecibels = 60.0;
+    // the points are spaced by ~0.0034 dB, so that each octave is sampled at ~1800 mantissas
+    constexpr size_t kPointNum = 1 << 16;
+
+    template <Precision P>
+    constexpr double getErrorBound() {
+        if constexpr (P == Precision::kMilliDecibel) {
+            return 0.001;
+        } else if constexpr (P == Precision::kCentiDecibel) {
+            return 0.01;
+        } else {
+            // float rounding of the exact functions
+            return 1e-4;
+        }
+    }
+
+    std::vector<float> getDecibels() {
+        std::vector<float> db(kPointNum);
+        for (size_t i = 0; i < kPointNum; ++i) {
+            db[i] = static_cast<float>(kMinDecibels + (kMaxDecibels - kMinDecibels) *
+                                       static_cast<double>(i) / static_cast<double>(kPointNum - 1));
+        }
+        return db;
+    }
+
+    std::vector<float> getGains() {
+        auto gains = getDecibels();
+        for (auto& x : gains) {
+            x = static_cast<float>(std::pow(10.0, static_cast<double>(x) / 20.0));
+        }
+        return gains;
+    }
+
+    double getGainError(const float gain, const float db) {
+        return std::abs(static_cast<double>(db) - 20.0 * std::log10(static_cast<double>(gain)));
+    }
+
+    double getSquareGainError(const float square_gain, const float db) {
+        return std::abs(static_cast<double>(db) - 10.0 * std::log10(static_cast<double>(square_gain)));
+    }
+
+    // the error of a gain, measured in dB
+    double getDecibelError(const float db, const float gain) {
+        return std::abs(20.0 * std::log10(static_cast<double>(gain)) - static_cast<double>(db));
+    }
+
+    template <Precision P>
+    void checkScalar() {
+        const auto gains = getGains();
+        double max_error = 0.0;
+        for (const auto x : gains) {
+            max_error = std::max(max_error,
+                                 getGainError(x, zldsp::chore::fast_db::gainToDecibels<P>(x)));
+        }
+        CHECK(max_error < getErrorBound<P>());
+
+        max_error = 0.0;
+        for (const auto x : gains) {
+            const auto x2 = x * x;
+            max_error = std::max(max_error,
+                                 getSquareGainError(x2, zldsp::chore::fast_db::squareGainToDecibels<P>(x2)));
+        }
+        CHECK(max_error < getErrorBound<P>());
+
+        max_error = 0.0;
+        for (const auto db : getDecibels()) {
+            max_error = std::max(max_error,
+                                 getDecibelError(db, zldsp::chore::fast_db::decibelsToGain<P>(db)));
+        }
+        CHECK(max_error < getErrorBound<P>());
+    }
+
+    template <Precision P>
+    void checkSIMD() {
+        static constexpr hn::ScalableTag<float> d;
+        static constexpr size_t lanes = hn::MaxLanes(d);
+        const auto gains = getGains();
+        const auto decibels = getDecibels();
+        std::vector<float> out(kPointNum);
+
+        for (size_t i = 0; i < kPointNum; i += lanes) {
+            hn::StoreU(zldsp::chore::fast_db::gainToDecibels<P>(d, hn::LoadU(d, gains.data() + i)),
+                       d, out.data() + i);
+        }
+        double max_error = 0.0;
+        for (size_t i = 0; i < kPointNum; ++i) {
+            max_error = std::max(max_error, getGainError(gains[i], out[i]));
+        }
+        CHECK(max_error < getErrorBound<P>());
+
+        std::vector<float> square_gains(kPointNum);
+        for (size_t i = 0; i < kPointNum; ++i) {
+            square_gains[i] = gains[i] * gains[i];
+        }
+        for (size_t i = 0; i < kPointNum; i += lanes) {
+            hn::StoreU(zldsp::chore::fast_db::squareGainToDecibels<P>(d, hn::LoadU(d, square_gains.data() + i)),
+                       d, out.data() + i);
+        }
+        max_error = 0.0;
+        for (size_t i = 0; i < kPointNum; ++i) {
+            max_error = std::max(max_error, getSquareGainError(square_gains[i], out[i]));
+        }
+        CHECK(max_error < getErrorBound<P>());
+
+        for (size_t i = 0; i < kPointNum; i += lanes) {
+            hn::StoreU(zldsp::chore::fast_db::decibelsToGain<P>(d, hn::LoadU(d, decibels.data() + i)),
+                       d, out.data() + i);
+        }
+        max_error = 0.0;
+        for (size_t i = 0; i < kPointNum; ++i) {
+            max_error = std::max(max_error, getDecibelError(decibels[i], out[i]));
+        }
+        CHECK(max_error < getErrorBound<P>());
+
+        // an odd length, so that the scalar tail is covered as well
+        out.assign(gains.begin(), gains.end() - 1);
+        zldsp::chore::fast_db::magToDecibels<P>(out.data(), out.size());
+        max_error = 0.0;
+        for (size_t i = 0; i < out.size(); ++i) {
+            max_error = std::max(max_error, getGainError(gains[i], out[i]));
+        }
+        CHECK(max_error < getErrorBound<P>());
+    }
+}
+
+TEST_CASE("fast_db scalar conversions stay within the error bounds", "[fast_db]") {
+    SECTION("exact") { checkScalar<Precision::kExact>(); }
+    SECTION("milli-decibel") { checkScalar<Precision::kMilliDecibel>(); }
+    SECTION("centi-decibel") { checkScalar<Precision::kCentiDecibel>(); }
+}
+
+TEST_CASE("fast_db SIMD conversions stay within the error bounds", "[fast_db]") {
+    SECTION("exact") { checkSIMD<Precision::kExact>(); }
+    SECTION("milli-decibel") { checkSIMD<Precision::kMilliDecibel>(); }
+    SECTION("centi-decibel") { checkSIMD<Precision::kCentiDecibel>(); }
+}
@@ -0,0 +1,132 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <vector>
+
+#include "dsp/splitter/lr_splitter.hpp"
+
+namespace {
+    constexpr size_t kMaxBandNum = 4;
+    constexpr double kSampleRate = 48000.0;
+    constexpr std::array<double, kMaxBandNum - 1> kCrossovers{120.0, 1000.0, 6000.0};
+    // long enough for the impulse response of the lowest crossover to decay
+    constexpr size_t kIRLength = 1 << 14;
+    constexpr std::array<double, 8> kFreqs{20.0, 80.0, 120.0, 400.0, 1000.0, 3000.0, 6000.0, 16000.0};
+
+    using Splitter = zldsp::splitter::LRSplitter<float, kMaxBandNum, 2>;
+
+    /**
+     * get the impulse responses of the bands, interleaved as [sample][band]
+     */
+    std::vector<float> getBandIRs(Splitter& splitter, const size_t stream) {
+        std::vector<float> in(kIRLength, 0.f);
+        in[0] = 1.f;
+        std::vector<float> out(kIRLength * kMaxBandNum);
+        splitter.process(stream, in.data(), out.data(), kIRLength);
+        return out;
+    }
+
+    double getMagnitude(const std::vector<double>& ir, const double freq) {
+        std::complex<double> sum{0.0, 0.0};
+        const auto w = -2.0 * std::numbers::pi * freq / kSampleRate;
+        for (size_t n = 0; n < ir.size(); ++n) {
+            sum += ir[n] * std::polar(1.0, w * static_cast<double>(n));
+        }
+        return std::abs(sum);
+    }
+
+    void prepare(Splitter& splitter, const size_t band_num) {
+        splitter.prepare(kSampleRate);
+        splitter.setBandNum(band_num);
+        for (size_t i = 0; i + 1 < band_num; ++i) {
+            splitter.setCrossover(i, kCrossovers[i]);
+        }
+    }
+}
+
+TEST_CASE("lr splitter sums to an all-pass", "[splitter]") {
+    for (size_t band_num = 1; band_num <= kMaxBandNum; ++band_num) {
+        Splitter splitter;
+        prepare(splitter, band_num);
+        const auto band_irs = getBandIRs(splitter, 0);
+
+        std::vector<double> sum_ir(kIRLength, 0.0);
+        for (size_t n = 0; n < kIRLength; ++n) {
+            for (size_t band = 0; band < kMaxBandNum; ++band) {
+                const auto x = band_irs[n * kMaxBandNum + band];
+                if (band >= band_num) {
+                    // the unused bands are zeros
+                    REQUIRE(x == 0.f);
+                }
+                sum_ir[n] += static_cast<double>(x);
+            }
+        }
+        for (const auto freq : kFreqs) {
+            INFO("band number " << band_num << ", frequency " << freq);
+            CHECK(std::abs(getMagnitude(sum_ir, freq) - 1.0) < 1e-3);
+        }
+    }
+}
+
+TEST_CASE("lr splitter bands pass their own ranges", "[splitter]") {
+    Splitter splitter;
+    prepare(splitter, kMaxBandNum);
+    const auto band_irs = getBandIRs(splitter, 0);
+
+    // the center (in octaves) of each band, the crossovers are at least ~3 octaves apart
+    constexpr std::array<double, kMaxBandNum> kCenters{30.0, 350.0, 2500.0, 16000.0};
+    for (size_t band = 0; band < kMaxBandNum; ++band) {
+        std::vector<double> ir(kIRLength);
+        for (size_t n = 0; n < kIRLength; ++n) {
+            ir[n] = static_cast<double>(band_irs[n * kMaxBandNum + band]);
+        }
+        for (size_t k = 0; k < kMaxBandNum; ++k) {
+            INFO("band " << band << ", frequency " << kCenters[k]);
+            const auto mag = getMagnitude(ir, kCenters[k]);
+            if (k == band) {
+                CHECK(mag > 0.9);
+            } else {
+                CHECK(mag < 0.1);
+            }
+        }
+        // each band is -6 dB at its crossovers
+        if (band + 1 < kMaxBandNum) {
+            CHECK(std::abs(getMagnitude(ir, kCrossovers[band]) - 0.5) < 0.01);
+        }
+        if (band > 0) {
+            CHECK(std::abs(getMagnitude(ir, kCrossovers[band - 1]) - 0.5) < 0.01);
+        }
+    }
+}
+
+TEST_CASE("lr splitter keeps the states of the streams apart", "[splitter]") {
+    Splitter splitter;
+    prepare(splitter, kMaxBandNum);
+    // feed some signal into stream 1 first, stream 0 should not be affected
+    std::vector<float> noise(1000);
+    for (size_t i = 0; i < noise.size(); ++i) {
+        noise[i] = std::sin(0.37f * static_cast<float>(i));
+    }
+    std::vector<float> out(noise.size() * kMaxBandNum);
+    splitter.process(1, noise.data(), out.data(), noise.size());
+    const auto band_irs = getBandIRs(splitter, 0);
+
+    Splitter ref_splitter;
+    prepare(ref_splitter, kMaxBandNum);
+    const auto ref_band_irs = getBandIRs(ref_splitter, 0);
+    for (size_t i = 0; i < band_irs.size(); ++i) {
+        REQUIRE(band_irs[i] == ref_band_irs[i]);
+    }
+}
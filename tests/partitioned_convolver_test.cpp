@@ -0,0 +1,165 @@
+// Copyright (C) 2026 - zsliu98
+// This file is part of ZLCompressor
+//
+// ZLCompressor is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License Version 3 as published by the Free Software Foundation.
+//
+// ZLCompressor is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License along with ZLCompressor. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "dsp/convolution/partitioned_convolver.hpp"
+
+namespace {
+    constexpr size_t kPartitionSize = 64;
+    constexpr size_t kPartitionNum = 4;
+    constexpr size_t kChannelNum = 2;
+    // irregular block sizes, so that blocks straddle the partitions
+    constexpr std::array<size_t, 6> kBlockSizes{1, 17, 64, 100, 37, 128};
+
+    std::vector<float> getNoise(const size_t num_samples, const unsigned seed) {
+        std::mt19937 gen{seed};
+        std::uniform_real_distribution<float> dist{-1.f, 1.f};
+        std::vector<float> x(num_samples);
+        for (auto& v : x) {
+            v = dist(gen);
+        }
+        return x;
+    }
+
+    std::vector<float> convolveDirect(const std::vector<float>& x, const std::vector<float>& ir) {
+        std::vector<float> y(x.size(), 0.f);
+        for (size_t n = 0; n < x.size(); ++n) {
+            double sum = 0.0;
+            for (size_t k = 0; k < ir.size() && k <= n; ++k) {
+                sum += static_cast<double>(ir[k]) * static_cast<double>(x[n - k]);
+            }
+            y[n] = static_cast<float>(sum);
+        }
+        return y;
+    }
+
+    /**
+     * run the convolver over the inputs with irregular block sizes
+     * @param on_sample called with the number of processed samples before each block, it may load a new IR
+     */
+    template <typename Callback>
+    std::array<std::vector<float>, kChannelNum> run(zldsp::convolution::PartitionedConvolver<float>& convolver,
+                                                    const std::array<std::vector<float>, kChannelNum>& inputs,
+                                                    Callback&& on_sample) {
+        auto outputs = inputs;
+        const auto num_samples = inputs[0].size();
+        size_t start = 0, block_idx = 0;
+        while (start < num_samples) {
+            const auto block_size = std::min(kBlockSizes[block_idx % kBlockSizes.size()], num_samples - start);
+            on_sample(start);
+            std::array<float*, kChannelNum> pointers{outputs[0].data() + start, outputs[1].data() + start};
+            convolver.process(std::span<float*>(pointers), block_size);
+            start += block_size;
+            block_idx += 1;
+        }
+        return outputs;
+    }
+}
+
+TEST_CASE("partitioned convolver matches the direct convolution", "[convolver]") {
+    zldsp::convolution::PartitionedConvolver<float> convolver;
+    convolver.prepare(kPartitionSize, kPartitionNum, kChannelNum);
+    REQUIRE(convolver.getLatency() == kPartitionSize);
+    REQUIRE(convolver.getMaxIRSize() == kPartitionSize * kPartitionNum);
+
+    // an IR which does not fill the last partition
+    const auto ir = getNoise(kPartitionSize * kPartitionNum - 23, 1);
+    convolver.loadIRNow(ir);
+
+    const std::array inputs{getNoise(4000, 2), getNoise(4000, 3)};
+    const auto outputs = run(convolver, inputs, [](size_t) {
+    });
+    for (size_t chan = 0; chan < kChannelNum; ++chan) {
+        const auto expected = convolveDirect(inputs[chan], ir);
+        float max_error = 0.f;
+        for (size_t n = 0; n < kPartitionSize; ++n) {
+            max_error = std::max(max_error, std::abs(outputs[chan][n]));
+        }
+        for (size_t n = kPartitionSize; n < expected.size(); ++n) {
+            max_error = std::max(max_error, std::abs(outputs[chan][n] - expected[n - kPartitionSize]));
+        }
+        CHECK(max_error < 1e-4f);
+    }
+}
+
+TEST_CASE("partitioned convolver crossfades to a new IR across one partition", "[convolver]") {
+    zldsp::convolution::PartitionedConvolver<float> convolver;
+    convolver.prepare(kPartitionSize, kPartitionNum, kChannelNum);
+    const auto old_ir = getNoise(kPartitionSize * kPartitionNum, 4);
+    const auto new_ir = getNoise(kPartitionSize * kPartitionNum / 2, 5);
+    convolver.loadIRNow(old_ir);
+
+    // load the new IR in the middle of a partition, it is picked up when that partition completes
+    constexpr size_t kLoadSample = 20 * kPartitionSize + 5;
+    size_t swap_sample = 0;
+    bool is_pending_before_swap = true;
+    const std::array inputs{getNoise(3000, 6), getNoise(3000, 7)};
+    const auto outputs = run(convolver, inputs, [&](const size_t start) {
+        if (swap_sample == 0 && start >= kLoadSample) {
+            REQUIRE_FALSE(convolver.isIRPending());
+            convolver.loadIR(new_ir);
+            swap_sample = (start / kPartitionSize + 1) * kPartitionSize;
+        } else if (swap_sample > 0 && start < swap_sample) {
+            is_pending_before_swap = is_pending_before_swap && convolver.isIRPending();
+        }
+    });
+    REQUIRE(swap_sample > 0);
+    CHECK(is_pending_before_swap);
+    // the audio thread has released the old kernel
+    CHECK_FALSE(convolver.isIRPending());
+
+    for (size_t chan = 0; chan < kChannelNum; ++chan) {
+        const auto old_y = convolveDirect(inputs[chan], old_ir);
+        const auto new_y = convolveDirect(inputs[chan], new_ir);
+        float max_error = 0.f;
+        for (size_t n = kPartitionSize; n < outputs[chan].size(); ++n) {
+            const auto m = n - kPartitionSize;
+            float expected;
+            if (m < swap_sample - kPartitionSize) {
+                expected = old_y[m];
+            } else if (m < swap_sample) {
+                // the partition which ends at the swap fades linearly from the old output to the new output
+                const auto fade = static_cast<float>(m - (swap_sample - kPartitionSize) + 1)
+                                  / static_cast<float>(kPartitionSize);
+                expected = old_y[m] + (new_y[m] - old_y[m]) * fade;
+            } else {
+                expected = new_y[m];
+            }
+            max_error = std::max(max_error, std::abs(outputs[chan][n] - expected));
+        }
+        CHECK(max_error < 1e-4f);
+    }
+}
+
+TEST_CASE("partitioned convolver stays silent after reset", "[convolver]") {
+    zldsp::convolution::PartitionedConvolver<float> convolver;
+    convolver.prepare(kPartitionSize, kPartitionNum, kChannelNum);
+    convolver.loadIRNow(getNoise(kPartitionSize * kPartitionNum, 8));
+    std::array inputs{getNoise(1000, 9), getNoise(1000, 10)};
+    run(convolver, inputs, [](size_t) {
+    });
+
+    convolver.reset();
+    for (auto& x : inputs) {
+        std::fill(x.begin(), x.end(), 0.f);
+    }
+    const auto outputs = run(convolver, inputs, [](size_t) {
+    });
+    for (const auto& y : outputs) {
+        for (const auto v : y) {
+            REQUIRE(v == 0.f);
+        }
+    }
+}